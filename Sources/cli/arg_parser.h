@@ -4,8 +4,11 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "../config/run_config.h"
 
@@ -40,6 +43,11 @@ struct ParseArgsResult {
 
     bool explain_profile = false;
     bool benchmark_mode = false;
+
+    std::string jobs_manifest;
+
+    int merge_shards = 0;
+    bool merge_dedup_relabel = false;
 };
 
 inline bool parse_i64(const char* s, long long& out) {
@@ -139,6 +147,25 @@ inline ParseArgsResult parse_args(int argc, char** argv) {
         if (a == "--strict-canonical-strategies") { r.cfg.strict_canonical_strategies = true; continue; }
         if (a == "--allow-proxy-advanced") { r.cfg.allow_proxy_advanced = true; continue; }
         if (a == "--no-proxy-advanced") { r.cfg.allow_proxy_advanced = false; continue; }
+        if (a == "--strategy-tier-policy" && next(v)) { r.cfg.strategy_tier_policy = v; continue; }
+        if (a == "--strategy-work-cap" && next(v)) { parse_u64(v, r.cfg.strategy_work_cap); continue; }
+        if (a == "--strategy-timing-sample" && next(v)) { parse_i32(v, r.cfg.strategy_timing_sample); continue; }
+        if (a == "--uniqueness-parallel-threads" && next(v)) { parse_i32(v, r.cfg.uniqueness_parallel_threads); continue; }
+        if (a == "--uniqueness-audit-every" && next(v)) { parse_i32(v, r.cfg.uniqueness_audit_every); continue; }
+        if (a == "--transform-grid-min-n" && next(v)) { parse_i32(v, r.cfg.transform_grid_min_n); continue; }
+        if (a == "--early-abort-ratio" && next(v)) { parse_f64(v, r.cfg.early_abort_ratio); continue; }
+        if (a == "--early-abort-audit-every" && next(v)) { parse_i32(v, r.cfg.early_abort_audit_every); continue; }
+        if (a == "--adaptive-budget") { r.cfg.adaptive_budget = true; continue; }
+        if (a == "--no-adaptive-budget") { r.cfg.adaptive_budget = false; continue; }
+        if (a == "--checkpoint-interval-s" && next(v)) { parse_i32(v, r.cfg.checkpoint_interval_s); continue; }
+        if (a == "--resume") { r.cfg.resume = true; continue; }
+        if (a == "--shard-index" && next(v)) { parse_i32(v, r.cfg.shard_index); continue; }
+        if (a == "--shard-count" && next(v)) { parse_i32(v, r.cfg.shard_count); continue; }
+        if (a == "--inflight-attempts" && next(v)) { parse_i32(v, r.cfg.inflight_attempts); continue; }
+        if (a == "--pipeline-depth" && next(v)) { parse_i32(v, r.cfg.pipeline_depth); continue; }
+        if (a == "--merge-shards" && next(v)) { parse_i32(v, r.merge_shards); continue; }
+        if (a == "--merge-dedup" && next(v)) { r.merge_dedup_relabel = (std::string_view(v) == "relabel"); continue; }
+        if (a == "--budget-profile-file" && next(v)) { r.cfg.budget_profile_file = (std::string(v) == "none") ? std::string() : std::string(v); continue; }
         if (a == "--no-quality-contract") { r.cfg.enable_quality_contract = false; continue; }
         if (a == "--distribution-filter") { r.cfg.enable_distribution_filter = true; continue; }
         if (a == "--replay-validation") { r.cfg.enable_replay_validation = true; continue; }
@@ -148,6 +175,7 @@ inline ParseArgsResult parse_args(int argc, char** argv) {
         if (a == "--vip-score-profile" && next(v)) { r.cfg.vip_score_profile = v; continue; }
 
         if (a == "--cpu-backend" && next(v)) { r.cfg.cpu_backend = v; continue; }
+        if (a == "--cpu-affinity" && next(v)) { r.cfg.cpu_affinity = v; continue; }
 
         if (a == "--list-geometries") { r.list_geometries = true; continue; }
         if (a == "--validate-geometry") { r.validate_geometry = true; continue; }
@@ -164,6 +192,7 @@ inline ParseArgsResult parse_args(int argc, char** argv) {
         if (a == "--explain-profile") { r.explain_profile = true; continue; }
 
         if (a == "--benchmark-mode") { r.benchmark_mode = true; continue; }
+        if (a == "--jobs" && next(v)) { r.jobs_manifest = v; continue; }
         if (a == "--benchmark-output-file" && next(v)) { r.cfg.benchmark_output_file = v; continue; }
         if (a == "--fast-test") { r.cfg.fast_test_mode = true; continue; }
         if (a == "--no-fast-test") { r.cfg.fast_test_mode = false; continue; }
@@ -181,8 +210,93 @@ inline ParseArgsResult parse_args(int argc, char** argv) {
     if (r.cfg.target_puzzles == 0) {
         r.cfg.target_puzzles = 1;
     }
+    r.cfg.shard_count = std::max(1, r.cfg.shard_count);
+    r.cfg.shard_index = std::clamp(r.cfg.shard_index, 0, r.cfg.shard_count - 1);
 
     return r;
 }
 
+// Manifest kolejki zadań: jedna linia = jedno zadanie w składni CLI, np.
+//   --job-name p5_9x9 --job-priority 4 --box-rows 3 --box-cols 3 --difficulty 5 --target 500
+// Linia nadpisuje argumenty wywołania (seed, folder, flagi), '#' zaczyna komentarz.
+// Bez --output-file zadanie pisze do <output_file_stem>_<job-name><ext>.
+inline bool parse_job_manifest(
+    const std::string& path,
+    int argc,
+    char** argv,
+    std::vector<JobSpec>& out_jobs,
+    std::string* err = nullptr) {
+    out_jobs.clear();
+    std::ifstream in(path);
+    if (!in) {
+        if (err != nullptr) *err = "cannot open jobs manifest: " + path;
+        return false;
+    }
+
+    std::string raw;
+    int line_no = 0;
+    while (std::getline(in, raw)) {
+        ++line_no;
+        const size_t hash = raw.find('#');
+        if (hash != std::string::npos) raw.resize(hash);
+
+        JobSpec job{};
+        bool has_output_file = false;
+        std::vector<std::string> tokens;
+        std::istringstream iss(raw);
+        for (std::string tok; iss >> tok;) {
+            if (tok == "--job-name" || tok == "--job-priority") {
+                std::string value;
+                if (!(iss >> value)) {
+                    if (err != nullptr) *err = "line " + std::to_string(line_no) + ": missing value for " + tok;
+                    return false;
+                }
+                if (tok == "--job-name") {
+                    job.name = value;
+                } else if (!parse_i32(value.c_str(), job.priority) || job.priority < 1) {
+                    if (err != nullptr) *err = "line " + std::to_string(line_no) + ": invalid --job-priority " + value;
+                    return false;
+                }
+                continue;
+            }
+            has_output_file = has_output_file || tok == "--output-file";
+            tokens.push_back(std::move(tok));
+        }
+        if (tokens.empty() && job.name.empty()) continue;
+
+        // Argumenty wywołania (bez --jobs) + argumenty linii: późniejsze wygrywają.
+        std::vector<char*> job_argv;
+        job_argv.reserve(static_cast<size_t>(argc) + tokens.size());
+        for (int i = 0; i < argc; ++i) {
+            if (i > 0 && std::string_view(argv[i] != nullptr ? argv[i] : "") == "--jobs") {
+                ++i;
+                continue;
+            }
+            job_argv.push_back(argv[i]);
+        }
+        for (auto& tok : tokens) job_argv.push_back(tok.data());
+        job.cfg = parse_args(static_cast<int>(job_argv.size()), job_argv.data()).cfg;
+
+        if (job.name.empty()) {
+            job.name = "job" + std::to_string(out_jobs.size() + 1) + "_" +
+                       std::to_string(job.cfg.box_rows) + "x" + std::to_string(job.cfg.box_cols) +
+                       "_L" + std::to_string(job.cfg.difficulty_level_required);
+        }
+        if (!has_output_file) {
+            const std::string& base = job.cfg.output_file;
+            const size_t dot = base.find_last_of('.');
+            job.cfg.output_file = (dot == std::string::npos)
+                ? (base + "_" + job.name)
+                : (base.substr(0, dot) + "_" + job.name + base.substr(dot));
+        }
+        out_jobs.push_back(std::move(job));
+    }
+
+    if (out_jobs.empty()) {
+        if (err != nullptr) *err = "jobs manifest has no jobs: " + path;
+        return false;
+    }
+    return true;
+}
+
 } // namespace sudoku_hpc
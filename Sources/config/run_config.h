@@ -178,6 +178,50 @@ struct GenerateRunConfig {
     bool strict_logical = false;
     bool strict_canonical_strategies = false;
     bool allow_proxy_advanced = true;
+    // Tier P8 (exact/proxy) - składnia: GenericLogicCertify::parse_tier_policy.
+    std::string strategy_tier_policy = "hybrid";
+    // Limit pracy na jedno wywołanie slotu P7/P8 (jednostki logic/shared/work_budget.h), 0 = brak.
+    uint64_t strategy_work_cap = 0;
+    // Próbkowanie czasu strategii: 1 = każda runda certyfikatora, N = co N-ta, 0 = wyłączone.
+    int strategy_timing_sample = 1;
+    // Równoległe liczenie rozwiązań jednej łamigłówki (n >= 49): 0 = auto (wątek
+    // liczący + workery, które już skończyły - wolne rdzenie pod koniec runu),
+    // 1 = wyłączone, N = stała liczba wątków puli na jedno liczenie.
+    int uniqueness_parallel_threads = 0;
+    // Audyt dowodu unikalności z diggera: 0 = ufamy tokenowi, N = co N-ty kandydat
+    // (per wątek) przechodzi ponowne liczenie DLX i pełny replay.
+    int uniqueness_audit_every = 0;
+    // Plansze n >= progu bez ograniczeń wzorca biorą pełną siatkę z puli przekształceń
+    // (core_engines/transform_grid_source.h) zamiast z backtrackingu; 0 = wyłączone.
+    int transform_grid_min_n = 25;
+    // Wczesne przerwanie kopania (mcts_digger/dig_abort_classifier.h): próba kończy
+    // się, gdy przewidywana szansa akceptacji < ratio * bazowa stopa; 0 = wyłączone
+    // (domyślnie - opt-in, bo odcina też część prób, które by przeszły).
+    double early_abort_ratio = 0.0;
+    // Co N-ta decyzja o przerwaniu idzie dalej jako audyt (stopa fałszywych negatywów).
+    int early_abort_audit_every = 16;
+    // Kontroler budżetów (generator/budget_controller.h): stroi budżet węzłów/czasu,
+    // próby pattern forcing i iteracje MCTS per worker wg akceptacji na sekundę CPU.
+    // Opt-in (--adaptive-budget): pomiar czasu CPU psuje powtarzalność runu z --seed.
+    bool adaptive_budget = false;
+    // Profil nauczonych ustawień w output_folder; pusty = bez zapisu/odczytu
+    // (domyślnie - run nie zależy od poprzednich runów w tym folderze).
+    std::string budget_profile_file;
+    // Checkpoint runu (generator/run_checkpoint.h) co N s do <output_file>.ckpt;
+    // 0 = wyłączony (domyślnie). Usuwany, gdy run osiągnie cel.
+    int checkpoint_interval_s = 0;
+    // Wznowienie z checkpointu: te same pliki wyjściowe, liczniki i stan uczony.
+    bool resume = false;
+    // Shard runu wieloprocesowego (generator/shard_merge.h): indeks 0..count-1;
+    // count <= 1 = zwykły run.
+    int shard_index = 0;
+    int shard_count = 1;
+    // Próby w locie per worker (generator/attempt_interleaver.h): K wykopanych
+    // kandydatów czeka na certyfikację, najlepiej rokujący idzie pierwszy; 1 = wyłączone.
+    int inflight_attempts = 1;
+    // Tryb potokowy (generator/stage_pipeline.h): osobne grupy workerów kopiących
+    // i certyfikujących, N kandydatów w kolejce między nimi; 0 = wyłączony.
+    int pipeline_depth = 0;
     bool enable_quality_contract = true;
     bool enable_distribution_filter = false;
     bool enable_replay_validation = false;
@@ -187,6 +231,8 @@ struct GenerateRunConfig {
     std::string vip_score_profile = "standard";
 
     std::string cpu_backend = "scalar";
+    // Przypięcie workerów (generator/concurrency/cpu_topology.h): none|compact|scatter.
+    std::string cpu_affinity = "none";
 
     bool stage_start = false;
     bool stage_end = false;
@@ -238,6 +284,17 @@ struct GenerateRunResult {
     uint64_t pattern_exact_template_used = 0;
     uint64_t pattern_family_fallback_used = 0;
     uint64_t required_strategy_exact_contract_met = 0;
+    uint64_t early_abort_checkpoints = 0;
+    uint64_t early_abort_aborted = 0;
+    uint64_t early_abort_audits = 0;
+    uint64_t early_abort_audit_false_negatives = 0;
+    // --inflight-attempts: porzuceni bez certyfikacji (w rejected, bez powodu etapu)
+    // oraz wykopani, ale niedokończeni przy końcu runu (poza attempts).
+    uint64_t interleave_dropped = 0;
+    uint64_t interleave_unfinished = 0;
+    // --pipeline-depth: wykopani kandydaci w kolejce gotowych przy końcu runu
+    // (poza attempts, ich próbki klasyfikatora porzucone bez etykiety).
+    uint64_t pipeline_unfinished = 0;
 
     double vip_score = 0.0;
     std::string vip_grade = "none";
@@ -251,6 +308,14 @@ struct GenerateRunResult {
     double accepted_per_sec = 0.0;
 };
 
+// Jedno zadanie kolejki (--jobs): pełna konfiguracja celu plus udział w puli
+// workerów. Priorytet to waga czasu CPU względem pozostałych zadań.
+struct JobSpec {
+    std::string name;
+    int priority = 1;
+    GenerateRunConfig cfg;
+};
+
 enum class StrategySmokeVariant : uint8_t {
     Primary = 0,
     Asymmetric = 1,
@@ -902,6 +967,21 @@ inline std::string explain_generation_profile_text(const GenerateRunConfig& cfg)
     out << "strict_canonical=" << (cfg.strict_canonical_strategies ? "on" : "off")
         << " allow_proxy_advanced=" << (cfg.allow_proxy_advanced ? "on" : "off")
         << " max_pattern_depth=" << cfg.max_pattern_depth << "\n";
+    out << "strategy_tier_policy=" << cfg.strategy_tier_policy
+        << " strategy_work_cap=" << cfg.strategy_work_cap
+        << " strategy_timing_sample=" << cfg.strategy_timing_sample
+        << " uniqueness_parallel_threads=" << cfg.uniqueness_parallel_threads
+        << " uniqueness_audit_every=" << cfg.uniqueness_audit_every
+        << " transform_grid_min_n=" << cfg.transform_grid_min_n
+        << " early_abort_ratio=" << cfg.early_abort_ratio
+        << " early_abort_audit_every=" << cfg.early_abort_audit_every
+        << " adaptive_budget=" << (cfg.adaptive_budget ? "on" : "off")
+        << " checkpoint_interval_s=" << cfg.checkpoint_interval_s
+        << " resume=" << (cfg.resume ? "on" : "off")
+        << " shard=" << cfg.shard_index << "/" << cfg.shard_count
+        << " inflight_attempts=" << cfg.inflight_attempts
+        << " pipeline_depth=" << cfg.pipeline_depth
+        << " cpu_affinity=" << cfg.cpu_affinity << "\n";
     out << "fast_test_mode=" << (cfg.fast_test_mode ? "on" : "off") << "\n";
     out << "quality_contract=" << (cfg.enable_quality_contract ? "on" : "off") << " replay=" << (cfg.enable_replay_validation ? "on" : "off") << "\n";
     return out.str();
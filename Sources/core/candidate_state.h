@@ -9,17 +9,55 @@
 
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
-#include <chrono>
 
 #include "board.h"
 #include "geometry.h"
+#include "tick_clock.h"
 #include "../logic/logic_result.h"
 
+namespace sudoku_hpc::core_engines {
+struct SearchAbortControl;
+}
+
 namespace sudoku_hpc {
 
 using logic::ApplyResult;
 
+// Indeksy bivalue / bilocation utrzymywane przyrostowo przy zwężaniu masek.
+// Rozmiary stałe pod N=64, bufor thread_local podawany w init (Zero-Allocation).
+struct CandidateIndexStorage {
+    static constexpr int MAX_N = 64;
+    static constexpr int MAX_NN = MAX_N * MAX_N;
+    static constexpr int MAX_HOUSES = MAX_N * 3;
+    static constexpr int MAX_PAIRS = MAX_N * (MAX_N - 1) / 2;
+    static constexpr int BIVALUE_WORDS = MAX_NN / 64;
+
+    // Zbiór komórek bivalue (nn bitów).
+    uint64_t bivalue_bits[BIVALUE_WORDS]{};
+    int bivalue_count = 0;
+
+    // Kubełki bivalue per para cyfr: lista dwukierunkowa po indeksach komórek.
+    int pair_head[MAX_PAIRS]{};
+    int pair_size[MAX_PAIRS]{};
+    int cell_next[MAX_NN]{};
+    int cell_prev[MAX_NN]{};
+    int16_t cell_pair[MAX_NN]{};
+
+    // Liczba pozycji cyfry w domku oraz flagi "dokładnie dwie pozycje" (bilocation).
+    uint8_t house_digit_count[MAX_HOUSES * MAX_N]{};
+    uint64_t bilocation_digits[MAX_HOUSES]{};
+
+    // Epoki zmian (dirty-region): każda zmiana maski podbija change_epoch i stempluje
+    // usunięte cyfry oraz 3 domki komórki. slot_clean_epoch = epoka ostatniego NoProgress slotu.
+    uint32_t change_epoch = 0;
+    uint32_t digit_epoch[MAX_N]{};
+    uint32_t house_epoch[MAX_HOUSES]{};
+    uint32_t slot_clean_epoch[logic::kStrategySlotCount]{};
+};
+
 struct CandidateState {
     GenericBoard* board = nullptr;
     const GenericTopology* topo = nullptr;
@@ -27,11 +65,47 @@ struct CandidateState {
     // Wskaźnik na płaski bufor thread_local, zapobiega alokacjom na stercie w trakcie rozwiązywania
     uint64_t* cands = nullptr;
 
-    bool init(GenericBoard& b, const GenericTopology& t, uint64_t* tls_buffer) {
+    // Indeksy bivalue/bilocation. Nieważne po surowym nadpisaniu `cands`
+    // (snapshot/restore w P8) - odbudowywane leniwie przez ensure_indices().
+    CandidateIndexStorage* index = nullptr;
+    bool index_valid = false;
+
+    // Epoka, od której strategia lokalna (cyfra/domek) ma sprawdzać zmiany.
+    // 0 = wszystko brudne; ustawiane przez dyspozytor tylko na czas wywołania slotu.
+    uint32_t scan_clean_epoch = 0;
+
+    // Tryb tieru dla slotów hybrydowych P8 (exact/proxy), ustawiany per slot.
+    logic::StrategyTierMode tier_mode = logic::StrategyTierMode::Hybrid;
+
+    // Licznik pracy slotów P7/P8 (logic/shared/work_budget.h). work_cap = limit
+    // jednostek na wywołanie slotu (0 = brak), work_budget = budżet całej próby.
+    uint64_t work_units = 0;
+    uint64_t work_cap = 0;
+    uint64_t work_next_poll = ~0ULL;
+    core_engines::SearchAbortControl* work_budget = nullptr;
+    bool work_exhausted = false;
+
+    // Pomiar czasu strategii (StrategyStats::elapsed_ns). Dyspozytor wyłącza go
+    // w niepróbkowanych rundach; now_ns() zwraca wtedy 0, a liczniki zostają dokładne.
+    bool timing_enabled = true;
+
+    bool init(GenericBoard& b, const GenericTopology& t, uint64_t* tls_buffer, CandidateIndexStorage* tls_index) {
         board = &b;
         topo = &t;
         cands = tls_buffer;
-        
+        index = tls_index;
+        index_valid = false;
+        scan_clean_epoch = 0;
+        tier_mode = logic::StrategyTierMode::Hybrid;
+        work_units = 0;
+        work_next_poll = ~0ULL;
+        work_exhausted = false;
+        timing_enabled = true;
+        if (index != nullptr) {
+            index->change_epoch = 0;
+            std::fill_n(index->slot_clean_epoch, logic::kStrategySlotCount, 0U);
+        }
+                
         for (int idx = 0; idx < t.nn; ++idx) {
             if (b.values[idx] != 0) {
                 cands[idx] = 0ULL;
@@ -41,12 +115,130 @@ struct CandidateState {
             if (m == 0ULL) return false;
             cands[idx] = m;
         }
+        rebuild_indices();
         return true;
     }
 
+    static int pair_id(uint64_t pair_mask) {
+        const int lo = std::countr_zero(pair_mask);
+        const int hi = 63 - std::countl_zero(pair_mask);
+        return hi * (hi - 1) / 2 + lo;
+    }
+
+    void invalidate_indices() {
+        index_valid = false;
+    }
+
+    void rebuild_indices() {
+        if (index == nullptr) return;
+        CandidateIndexStorage& ix = *index;
+        const int n = topo->n;
+        const int nn = topo->nn;
+        std::fill_n(ix.bivalue_bits, (nn + 63) / 64, 0ULL);
+        std::fill_n(ix.pair_head, n * (n - 1) / 2, -1);
+        std::fill_n(ix.pair_size, n * (n - 1) / 2, 0);
+        std::fill_n(ix.house_digit_count, 3 * n * CandidateIndexStorage::MAX_N, static_cast<uint8_t>(0));
+        std::fill_n(ix.bilocation_digits, 3 * n, 0ULL);
+        ix.bivalue_count = 0;
+        // Zmiany w trakcie unieważnienia nie były śledzone - wszystko brudne.
+        const uint32_t e = ++ix.change_epoch;
+        std::fill_n(ix.digit_epoch, n, e);
+        std::fill_n(ix.house_epoch, 3 * n, e);
+
+        for (int idx = 0; idx < nn; ++idx) {
+            ix.cell_pair[idx] = -1;
+            const uint64_t m = (board->values[idx] == 0) ? cands[idx] : 0ULL;
+            if (m == 0ULL) continue;
+            const int h[3] = {topo->cell_row[idx], n + topo->cell_col[idx], 2 * n + topo->cell_box[idx]};
+            for (uint64_t w = m; w != 0ULL; w &= w - 1ULL) {
+                const int d0 = std::countr_zero(w);
+                for (const int house : h) {
+                    ++ix.house_digit_count[house * CandidateIndexStorage::MAX_N + d0];
+                }
+            }
+            if (std::popcount(m) == 2) bivalue_link(idx, m);
+        }
+        for (int house = 0; house < 3 * n; ++house) {
+            const uint8_t* cnt = ix.house_digit_count + house * CandidateIndexStorage::MAX_N;
+            uint64_t bl = 0ULL;
+            for (int d0 = 0; d0 < n; ++d0) {
+                if (cnt[d0] == 2) bl |= (1ULL << d0);
+            }
+            ix.bilocation_digits[house] = bl;
+        }
+        index_valid = true;
+    }
+
+    bool ensure_indices() {
+        if (!index_valid) rebuild_indices();
+        return index_valid;
+    }
+
+    int bivalue_count() const {
+        return index->bivalue_count;
+    }
+
+    bool is_bivalue(int idx) const {
+        return ((index->bivalue_bits[idx >> 6] >> (idx & 63)) & 1ULL) != 0ULL;
+    }
+
+    // Pierwsza komórka o masce dokładnie `pair_mask` (-1 gdy kubełek pusty).
+    int pair_bucket_first(uint64_t pair_mask) const {
+        return index->pair_head[pair_id(pair_mask)];
+    }
+
+    int pair_bucket_next(int idx) const {
+        return index->cell_next[idx];
+    }
+
+    int pair_bucket_size(uint64_t pair_mask) const {
+        return index->pair_size[pair_id(pair_mask)];
+    }
+
+    // Wypełnia `out` komórkami bivalue w kolejności rosnących indeksów.
+    int collect_bivalue_cells(int* out) const {
+        int count = 0;
+        const int words = (topo->nn + 63) / 64;
+        for (int wi = 0; wi < words; ++wi) {
+            for (uint64_t w = index->bivalue_bits[wi]; w != 0ULL; w &= w - 1ULL) {
+                out[count++] = (wi << 6) + std::countr_zero(w);
+            }
+        }
+        return count;
+    }
+
+    int house_digit_count(int house, int d) const {
+        return index->house_digit_count[house * CandidateIndexStorage::MAX_N + d - 1];
+    }
+
+    // Maska cyfr występujących w domku dokładnie na dwóch pozycjach (silne powiązania).
+    uint64_t bilocation_digits(int house) const {
+        return index->bilocation_digits[house];
+    }
+
+    uint32_t change_epoch() const {
+        return index->change_epoch;
+    }
+
+    // Czy kandydaci cyfry `d` (1-based) zmienili się od scan_clean_epoch.
+    bool digit_dirty(int d) const {
+        return !index_valid || index->digit_epoch[d - 1] > scan_clean_epoch;
+    }
+
+    bool house_dirty(int house) const {
+        return !index_valid || index->house_epoch[house] > scan_clean_epoch;
+    }
+
+    bool tier_allows_exact() const {
+        return tier_mode != logic::StrategyTierMode::ProxyOnly;
+    }
+
+    bool tier_allows_proxy() const {
+        return tier_mode == logic::StrategyTierMode::Hybrid || tier_mode == logic::StrategyTierMode::ProxyOnly;
+    }
+
     uint64_t now_ns() const {
-        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::steady_clock::now().time_since_epoch()).count());
+        return timing_enabled ? tick_now_ns() : 0ULL;
     }
 
     bool is_peer(int a, int b) const {
@@ -65,6 +257,7 @@ struct CandidateState {
         if (!board->can_place(idx, d)) return false;
         
         board->place(idx, d);
+        if (index_valid) note_mask_change(idx, cands[idx], 0ULL);
         cands[idx] = 0ULL;
         
         const int p0 = topo->peer_offsets[idx];
@@ -77,6 +270,7 @@ struct CandidateState {
             uint64_t& pm = cands[peer];
             if ((pm & bit) == 0ULL) continue;
             
+            if (index_valid) note_mask_change(peer, pm, pm & ~bit);
             pm &= ~bit;
             if (pm == 0ULL) return false; // Sprzeczność - wyczerpano kandydatów
         }
@@ -89,6 +283,7 @@ struct CandidateState {
         uint64_t& m = cands[idx];
         if ((m & rm) == 0ULL) return ApplyResult::NoProgress;
         
+        if (index_valid) note_mask_change(idx, m, m & ~rm);
         m &= ~rm;
         if (m == 0ULL) return ApplyResult::Contradiction;
         
@@ -104,9 +299,68 @@ struct CandidateState {
         if (nm == m) return ApplyResult::NoProgress;
         if (nm == 0ULL) return ApplyResult::Contradiction;
         
+        if (index_valid) note_mask_change(idx, m, nm);
         m = nm;
         return ApplyResult::Progress;
     }
+
+private:
+    void bivalue_link(int idx, uint64_t pair_mask) {
+        CandidateIndexStorage& ix = *index;
+        const int pid = pair_id(pair_mask);
+        const int head = ix.pair_head[pid];
+        ix.cell_pair[idx] = static_cast<int16_t>(pid);
+        ix.cell_prev[idx] = -1;
+        ix.cell_next[idx] = head;
+        if (head >= 0) ix.cell_prev[head] = idx;
+        ix.pair_head[pid] = idx;
+        ++ix.pair_size[pid];
+        ix.bivalue_bits[idx >> 6] |= (1ULL << (idx & 63));
+        ++ix.bivalue_count;
+    }
+
+    void bivalue_unlink(int idx) {
+        CandidateIndexStorage& ix = *index;
+        const int pid = ix.cell_pair[idx];
+        if (pid < 0) return;
+        const int prev = ix.cell_prev[idx];
+        const int next = ix.cell_next[idx];
+        if (prev >= 0) ix.cell_next[prev] = next;
+        else ix.pair_head[pid] = next;
+        if (next >= 0) ix.cell_prev[next] = prev;
+        --ix.pair_size[pid];
+        ix.cell_pair[idx] = -1;
+        ix.bivalue_bits[idx >> 6] &= ~(1ULL << (idx & 63));
+        --ix.bivalue_count;
+    }
+
+    // Maski wyłącznie maleją, więc komórka bivalue po zmianie nigdy nim nie zostaje.
+    void note_mask_change(int idx, uint64_t old_mask, uint64_t new_mask) {
+        CandidateIndexStorage& ix = *index;
+        const int n = topo->n;
+        const int h[3] = {topo->cell_row[idx], n + topo->cell_col[idx], 2 * n + topo->cell_box[idx]};
+        const uint32_t e = ++ix.change_epoch;
+        for (const int house : h) {
+            ix.house_epoch[house] = e;
+        }
+        for (uint64_t w = old_mask & ~new_mask; w != 0ULL; w &= w - 1ULL) {
+            const int d0 = std::countr_zero(w);
+            const uint64_t bit = (1ULL << d0);
+            ix.digit_epoch[d0] = e;
+            for (const int house : h) {
+                const uint8_t cnt = --ix.house_digit_count[house * CandidateIndexStorage::MAX_N + d0];
+                if (cnt == 2) ix.bilocation_digits[house] |= bit;
+                else ix.bilocation_digits[house] &= ~bit;
+            }
+        }
+        if (ix.cell_pair[idx] >= 0) bivalue_unlink(idx);
+        if (std::popcount(new_mask) == 2) bivalue_link(idx, new_mask);
+    }
 };
 
+inline CandidateIndexStorage& candidate_index_tls() {
+    thread_local CandidateIndexStorage* storage = new CandidateIndexStorage();
+    return *storage;
+}
+
 } // namespace sudoku_hpc
\ No newline at end of file
@@ -0,0 +1,109 @@
+// ============================================================================
+// SUDOKU HPC - CORE
+// Moduł: tick_clock.h
+// Opis: Tani zegar telemetrii strategii i budżetów. Na x86 odczyt TSC skalowany
+//       jednorazowo kalibrowanym współczynnikiem (ns/tick) względem
+//       steady_clock; na pozostałych platformach bezpośrednio steady_clock.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SUDOKU_HAS_TSC 1
+#else
+#define SUDOKU_HAS_TSC 0
+#endif
+
+namespace sudoku_hpc {
+
+inline uint64_t steady_now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#if SUDOKU_HAS_TSC
+struct TscCalibration {
+    uint64_t tsc0 = 0;
+    uint64_t ns0 = 0;
+    double ns_per_tick = 0.0;
+    bool usable = false;
+};
+
+// Kalibracja raz na proces (~1 ms aktywnego oczekiwania przy pierwszym użyciu).
+inline const TscCalibration& tsc_calibration() {
+    static const TscCalibration cal = [] {
+        TscCalibration c{};
+        c.ns0 = steady_now_ns();
+        c.tsc0 = __rdtsc();
+        uint64_t ns1 = c.ns0;
+        while ((ns1 = steady_now_ns()) - c.ns0 < 1000000ULL) {
+        }
+        const uint64_t tsc1 = __rdtsc();
+        if (tsc1 > c.tsc0) {
+            c.ns_per_tick = static_cast<double>(ns1 - c.ns0) / static_cast<double>(tsc1 - c.tsc0);
+            c.usable = true;
+        }
+        return c;
+    }();
+    return cal;
+}
+#endif
+
+// Znacznik czasu w ns na potrzeby różnic (elapsed). Porównania z deadline tylko
+// po przeliczeniu go przez tick_deadline_from().
+inline uint64_t tick_now_ns() {
+#if SUDOKU_HAS_TSC
+    const TscCalibration& c = tsc_calibration();
+    if (c.usable) {
+        const uint64_t t = __rdtsc();
+        if (t <= c.tsc0) return c.ns0;
+        return c.ns0 + static_cast<uint64_t>(static_cast<double>(t - c.tsc0) * c.ns_per_tick);
+    }
+#endif
+    return steady_now_ns();
+}
+
+// Deadline steady_clock przeliczony raz do domeny tick_now_ns(); dalsze sprawdzenia
+// to sam odczyt TSC. Dryf względem steady_clock w skali sekund jest pomijalny.
+inline uint64_t tick_deadline_from(std::chrono::steady_clock::time_point deadline) {
+    const auto now = std::chrono::steady_clock::now();
+    const uint64_t t = tick_now_ns();
+    if (deadline <= now) return t;
+    return t + static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count());
+}
+
+// Czas CPU bieżącego wątku w ns (kontroler budżetów mierzy akceptacje na sekundę CPU).
+// Bez zegara wątku - zegar ścienny.
+inline uint64_t thread_cpu_now_ns() {
+#ifdef _WIN32
+    FILETIME creation{}, exit_time{}, kernel{}, user{};
+    if (GetThreadTimes(GetCurrentThread(), &creation, &exit_time, &kernel, &user) != 0) {
+        const uint64_t k = (static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+        const uint64_t u = (static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+        return (k + u) * 100ULL;
+    }
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    }
+#endif
+    return steady_now_ns();
+}
+
+} // namespace sudoku_hpc
@@ -0,0 +1,201 @@
+// ============================================================================
+// SUDOKU HPC - GENERATOR PIPELINE
+// Moduł: attempt_interleaver.h
+// Opis: Przeplatanie kilku prób w jednym workerze na granicy etapów. Worker
+//       trzyma do K wykopanych kandydatów (ETAP 1-2 zakończony) i certyfikuje
+//       (ETAP 3-7) najbardziej obiecującego zamiast zawsze ostatniego: najpierw
+//       ten z potwierdzonym trafieniem wymaganej strategii w kopaniu, potem wg
+//       predykcji klasyfikatora wczesnego przerwania, na końcu najstarszy.
+//       Każde wywołanie next() daje dokładnie jeden wynik próby, więc liczniki
+//       prób w runnerze zgadzają się bez zmian. K = 1 to zwykła ścieżka.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../config/run_config.h"
+#include "generator_facade.h"
+#include "mcts_digger/dig_abort_classifier.h"
+
+namespace sudoku_hpc::generator {
+
+class AttemptInterleaver {
+public:
+    struct Outcome {
+        bool ok = false;
+        bool timed_out = false;
+        // Seed próby z chwili kopania (log / monitor), nie z chwili certyfikacji.
+        uint64_t seed = 0;
+        // Kandydat porzucony bez certyfikacji (przegrywał ranking) - odrzucenie
+        // bez powodu etapu (RejectReason::None), liczone osobno przez runner.
+        bool dropped = false;
+    };
+
+    // Bufory kandydatów rezerwowane raz - przeplatanie nie alokuje w pętli.
+    void configure(int inflight, int cells) {
+        capacity_ = std::clamp(inflight, 1, 64);
+        tasks_.assign(static_cast<size_t>(capacity_), Task{});
+        for (Task& t : tasks_) {
+            t.candidate.puzzle.reserve(static_cast<size_t>(cells));
+            t.candidate.solution.reserve(static_cast<size_t>(cells));
+        }
+        parked_ = 0;
+        age_clock_ = 0;
+    }
+
+    // Wykopani kandydaci jeszcze w puli - przy końcu pętli workera nie są
+    // próbami (nie przeszli certyfikacji), runner raportuje ich osobno.
+    int parked() const {
+        return parked_;
+    }
+
+    // Jedna próba: certyfikacja odłożonego kandydata albo odrzucenie przy kopaniu.
+    // Udane kopanie odkłada kandydata i kopie dalej, aż pula się zapełni; każde
+    // kolejne kopanie w tym wywołaniu bierze seed z reseed() (jak nowa próba).
+    // Kontrakt wyjść jak w generate_one_generic (pauza = false z RejectReason::None).
+    template <typename ReseedFn>
+    Outcome next(
+        const GenerateRunConfig& cfg,
+        const GenericTopology& topo,
+        std::mt19937_64& rng,
+        uint64_t attempt_seed,
+        ReseedFn&& reseed,
+        GenericPuzzleCandidate& candidate,
+        RejectReason& reason,
+        RequiredStrategyAttemptInfo& strategy_info,
+        const core_engines::GenericSolvedKernel& solved,
+        const core_engines::GenericQuickPrefilter& prefilter,
+        const logic::GenericLogicCertify& logic,
+        const core_engines::GenericUniquenessCounter& uniq,
+        const std::atomic<bool>* external_cancel_ptr,
+        const std::atomic<bool>* external_pause_ptr,
+        AttemptPerfStats& perf) {
+
+        Outcome out{};
+        mcts_digger::DigAbortClassifier& clf = mcts_digger::tls_dig_abort_classifier();
+        bool first_dig = true;
+
+        while (true) {
+            reason = RejectReason::None;
+
+            // Kandydat wiecznie przegrywający ranking jest porzucany, żeby pula nie
+            // zatkała się słabymi próbami (próbka klasyfikatora bez etykiety).
+            for (Task& t : tasks_) {
+                if (!t.parked || t.passed_over < 2 * capacity_) continue;
+                unpark(t, candidate, strategy_info, perf, out);
+                out.dropped = true;
+                return out;
+            }
+
+            if (parked_ >= capacity_) {
+                Task& t = pick_best(cfg, clf);
+                for (Task& other : tasks_) {
+                    if (other.parked && &other != &t) ++other.passed_over;
+                }
+                unpark(t, candidate, strategy_info, perf, out);
+                // Czas oczekiwania w puli nie zjada budżetu czasu próby.
+                t.state.shift_deadline(std::chrono::steady_clock::now() - t.parked_at);
+                clf.restore_pending(t.pending);
+                out.ok = generate_certify_stage_generic(
+                    cfg, topo, candidate, reason, strategy_info, prefilter, logic, uniq, t.state,
+                    &out.timed_out, nullptr, nullptr, nullptr, &perf);
+                apply_pattern_feedback(t.state.pattern_feedback);
+                return out;
+            }
+
+            if (!first_dig) attempt_seed = reseed();
+            first_dig = false;
+
+            Task* slot = nullptr;
+            for (Task& t : tasks_) {
+                if (!t.parked) {
+                    slot = &t;
+                    break;
+                }
+            }
+            bool dig_timed_out = false;
+            const bool dug = generate_dig_stage_generic(
+                cfg, topo, rng, slot->candidate, reason, slot->strategy_info, solved, logic, uniq, slot->state,
+                nullptr, &dig_timed_out, external_cancel_ptr, external_pause_ptr, &slot->perf);
+            if (!dug) {
+                std::swap(slot->candidate, candidate);
+                strategy_info = slot->strategy_info;
+                perf = slot->perf;
+                out.seed = attempt_seed;
+                out.timed_out = dig_timed_out;
+                return out;
+            }
+
+            slot->pending = clf.take_pending();
+            slot->seed = attempt_seed;
+            slot->timed_out = dig_timed_out;
+            slot->parked_at = std::chrono::steady_clock::now();
+            slot->age = age_clock_++;
+            slot->passed_over = 0;
+            slot->parked = true;
+            ++parked_;
+        }
+    }
+
+private:
+    struct Task {
+        bool parked = false;
+        bool timed_out = false;
+        uint64_t seed = 0;
+        uint64_t age = 0;
+        int passed_over = 0;
+        std::chrono::steady_clock::time_point parked_at{};
+        GenericPuzzleCandidate candidate;
+        RequiredStrategyAttemptInfo strategy_info{};
+        AttemptPerfStats perf{};
+        GenericAttemptStageState state{};
+        mcts_digger::DigAbortClassifier::PendingSample pending{};
+    };
+
+    Task& pick_best(const GenerateRunConfig& cfg, const mcts_digger::DigAbortClassifier& clf) {
+        const bool want_hits = cfg.required_strategy != RequiredStrategy::None;
+        Task* best = nullptr;
+        bool best_hit = false;
+        double best_pred = 0.0;
+        for (Task& t : tasks_) {
+            if (!t.parked) continue;
+            const bool hit = want_hits && t.perf.mcts_required_strategy_hit > 0;
+            const double pred = clf.pending_prediction(t.pending);
+            if (best == nullptr ||
+                hit > best_hit ||
+                (hit == best_hit && pred > best_pred) ||
+                (hit == best_hit && pred == best_pred && t.age < best->age)) {
+                best = &t;
+                best_hit = hit;
+                best_pred = pred;
+            }
+        }
+        return *best;
+    }
+
+    void unpark(Task& t, GenericPuzzleCandidate& candidate, RequiredStrategyAttemptInfo& strategy_info,
+                AttemptPerfStats& perf, Outcome& out) {
+        std::swap(t.candidate, candidate);
+        strategy_info = t.strategy_info;
+        perf = t.perf;
+        out.seed = t.seed;
+        out.timed_out = t.timed_out;
+        t.parked = false;
+        --parked_;
+    }
+
+    int capacity_ = 1;
+    int parked_ = 0;
+    uint64_t age_clock_ = 0;
+    std::vector<Task> tasks_;
+};
+
+} // namespace sudoku_hpc::generator
@@ -0,0 +1,318 @@
+// ============================================================================
+// SUDOKU HPC - GENERATOR PIPELINE
+// Moduł: budget_controller.h
+// Opis: Adaptacyjny kontroler budżetów próby per worker. Startuje od wartości
+//       z heurystyk geometrii (albo z profilu zapisanego przez poprzedni run)
+//       i wspinaczką po współrzędnych stroi trzy mnożniki: budżet węzłów/czasu
+//       próby, liczbę prób pattern forcing i limit iteracji MCTS. Miarą jest
+//       liczba akceptacji na sekundę CPU wątku w epokach; zmiana zostaje tylko,
+//       gdy epoka próbna bije bieżące ustawienie w teście z-score dla tempa
+//       Poissona (szum epok nie przesuwa pokręteł). Najlepsze ustawienia
+//       trafiają do pliku CSV kluczowanego (geometria, poziom, strategia).
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "../config/run_config.h"
+#include "../core/geometry.h"
+#include "mcts_digger/bottleneck_digger.h"
+
+namespace sudoku_hpc::generator {
+
+struct BudgetSettings {
+    double budget_scale = 1.0;
+    double pattern_tries_scale = 1.0;
+    double mcts_iterations_scale = 1.0;
+    // Akceptacje / s CPU zmierzone dla tych ustawień (0 = brak pomiaru).
+    double rate = 0.0;
+};
+
+inline std::string budget_profile_key(const GenerateRunConfig& cfg) {
+    return std::to_string(cfg.box_rows) + "x" + std::to_string(cfg.box_cols) +
+           "|L" + std::to_string(cfg.difficulty_level_required) +
+           "|" + std::string(to_string(cfg.required_strategy));
+}
+
+// Format linii: key,budget_scale,pattern_tries_scale,mcts_iterations_scale,rate
+inline std::unordered_map<std::string, BudgetSettings> load_budget_profiles(const std::string& path) {
+    std::unordered_map<std::string, BudgetSettings> out_map;
+    if (path.empty()) return out_map;
+
+    std::ifstream in(path);
+    if (!in) return out_map;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream iss(line);
+        std::string key, budget_s, tries_s, iters_s, rate_s;
+        if (std::getline(iss, key, ',') && std::getline(iss, budget_s, ',') &&
+            std::getline(iss, tries_s, ',') && std::getline(iss, iters_s, ',') &&
+            std::getline(iss, rate_s, ',')) {
+            try {
+                BudgetSettings s{};
+                s.budget_scale = std::stod(budget_s);
+                s.pattern_tries_scale = std::stod(tries_s);
+                s.mcts_iterations_scale = std::stod(iters_s);
+                s.rate = std::stod(rate_s);
+                out_map[key] = s;
+            } catch (...) {}
+        }
+    }
+    return out_map;
+}
+
+inline bool save_budget_profile(const std::string& path, const std::string& key, const BudgetSettings& s) {
+    if (path.empty()) return false;
+    auto profiles = load_budget_profiles(path);
+    profiles[key] = s;
+
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out) return false;
+    out << "# key,budget_scale,pattern_tries_scale,mcts_iterations_scale,accepted_per_cpu_s\n";
+    for (const auto& [k, v] : profiles) {
+        out << k << "," << v.budget_scale << "," << v.pattern_tries_scale << ","
+            << v.mcts_iterations_scale << "," << v.rate << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+class AdaptiveBudgetController {
+public:
+    static constexpr int kKnobs = 3;
+
+    // base = konfiguracja po heurystykach runnera. Pokrętła, które użytkownik ustawił
+    // jawnie albo które w tej konfiguracji nic nie zmieniają, zostają zamrożone.
+    void init(
+        const GenerateRunConfig& base,
+        const GenericTopology& topo,
+        const BudgetSettings& start,
+        bool budget_fixed,
+        bool iterations_fixed) {
+        base_node_budget_ = base.attempt_node_budget;
+        base_time_budget_s_ = base.attempt_time_budget_s;
+        base_pattern_tries_ = std::max(1, base.pattern_forcing_tries);
+        base_iterations_ = (base.mcts_digger_iterations > 0)
+            ? base.mcts_digger_iterations
+            : mcts_digger::mcts_default_iteration_cap(topo);
+
+        enabled_[0] = !budget_fixed && (base_node_budget_ > 0 || base_time_budget_s_ > 0.0);
+        enabled_[1] = base.pattern_forcing_enabled;
+        enabled_[2] = !iterations_fixed && base.mcts_digger_enabled;
+
+        current_ = start;
+        current_.budget_scale = enabled_[0] ? clamp_knob(0, start.budget_scale) : 1.0;
+        current_.pattern_tries_scale = enabled_[1] ? clamp_knob(1, start.pattern_tries_scale) : 1.0;
+        current_.mcts_iterations_scale = enabled_[2] ? clamp_knob(2, start.mcts_iterations_scale) : 1.0;
+        current_.rate = 0.0;
+        incumbent_ = current_;
+        knob_ = first_enabled_knob(0);
+    }
+
+    bool any_enabled() const {
+        return enabled_[0] || enabled_[1] || enabled_[2];
+    }
+
+    void apply(GenerateRunConfig& cfg) const {
+        if (enabled_[0]) {
+            if (base_node_budget_ > 0) {
+                cfg.attempt_node_budget = std::max<uint64_t>(
+                    1000ULL,
+                    static_cast<uint64_t>(static_cast<double>(base_node_budget_) * current_.budget_scale));
+            }
+            if (base_time_budget_s_ > 0.0) {
+                cfg.attempt_time_budget_s = base_time_budget_s_ * current_.budget_scale;
+            }
+        }
+        if (enabled_[1]) {
+            cfg.pattern_forcing_tries = std::max(
+                1, static_cast<int>(std::lround(static_cast<double>(base_pattern_tries_) * current_.pattern_tries_scale)));
+        }
+        if (enabled_[2]) {
+            cfg.mcts_digger_iterations = std::max(
+                32, static_cast<int>(std::lround(static_cast<double>(base_iterations_) * current_.mcts_iterations_scale)));
+        }
+    }
+
+    // Po każdej próbie. true = ustawienia się zmieniły i trzeba ponowić apply().
+    bool on_attempt(bool accepted, uint64_t cpu_ns) {
+        if (!any_enabled()) return false;
+        ++epoch_attempts_;
+        epoch_cpu_ns_ += cpu_ns;
+        if (accepted) ++epoch_accepted_;
+        const bool epoch_done =
+            epoch_attempts_ >= kEpochMinAttempts &&
+            (epoch_accepted_ >= kEpochAccepted || epoch_cpu_ns_ >= kEpochMaxCpuNs);
+        if (!epoch_done) return false;
+
+        const double accepted_count = static_cast<double>(epoch_accepted_);
+        const double cpu_s = static_cast<double>(std::max<uint64_t>(1, epoch_cpu_ns_)) * 1e-9;
+        epoch_attempts_ = 0;
+        epoch_accepted_ = 0;
+        epoch_cpu_ns_ = 0;
+        ++epochs_;
+        return finish_epoch(accepted_count, cpu_s);
+    }
+
+    const BudgetSettings& current() const {
+        return current_;
+    }
+
+    // Najlepsze potwierdzone ustawienia (z ostatnim zmierzonym tempem).
+    const BudgetSettings& incumbent() const {
+        return incumbent_;
+    }
+
+    uint64_t epochs() const {
+        return epochs_;
+    }
+
+    uint64_t adopted() const {
+        return adopted_;
+    }
+
+private:
+    // Epoka: min. 16 prób i 8 akceptacji albo 3 s CPU - przy rzadkich akceptacjach
+    // porównanie opiera się na zerach, wtedy ustawienie bieżące wygrywa remis.
+    static constexpr uint64_t kEpochMinAttempts = 16;
+    static constexpr uint64_t kEpochAccepted = 8;
+    static constexpr uint64_t kEpochMaxCpuNs = 3'000'000'000ULL;
+    static constexpr double kStep = 1.5;
+    // Próg z dla różnicy temp (akceptacje ~ Poisson); poniżej - szum, zostajemy.
+    static constexpr double kAdoptZ = 1.64;
+    static constexpr std::array<double, kKnobs> kMinScale{1.0 / 16.0, 0.25, 0.25};
+    static constexpr std::array<double, kKnobs> kMaxScale{16.0, 4.0, 4.0};
+
+    enum class Phase : uint8_t { Incumbent, Trial };
+
+    uint64_t base_node_budget_ = 0;
+    double base_time_budget_s_ = 0.0;
+    int base_pattern_tries_ = 1;
+    int base_iterations_ = 256;
+    std::array<bool, kKnobs> enabled_{};
+
+    BudgetSettings current_{};
+    BudgetSettings incumbent_{};
+    // Skumulowany (z wygaszaniem) pomiar ustawienia bieżącego.
+    double incumbent_accepted_ = 0.0;
+    double incumbent_cpu_s_ = 0.0;
+    Phase phase_ = Phase::Incumbent;
+    int knob_ = 0;
+    int direction_ = 1;
+    bool direction_flipped_ = false;
+    int trials_since_refresh_ = 0;
+
+    uint64_t epoch_attempts_ = 0;
+    uint64_t epoch_accepted_ = 0;
+    uint64_t epoch_cpu_ns_ = 0;
+    uint64_t epochs_ = 0;
+    uint64_t adopted_ = 0;
+
+    static double clamp_knob(int k, double v) {
+        return std::clamp(v, kMinScale[static_cast<size_t>(k)], kMaxScale[static_cast<size_t>(k)]);
+    }
+
+    static double& knob_ref(BudgetSettings& s, int k) {
+        return (k == 0) ? s.budget_scale : ((k == 1) ? s.pattern_tries_scale : s.mcts_iterations_scale);
+    }
+
+    int first_enabled_knob(int from) const {
+        for (int i = 0; i < kKnobs; ++i) {
+            const int k = (from + i) % kKnobs;
+            if (enabled_[static_cast<size_t>(k)]) return k;
+        }
+        return 0;
+    }
+
+    void next_knob() {
+        knob_ = first_enabled_knob(knob_ + 1);
+        direction_ = 1;
+        direction_flipped_ = false;
+    }
+
+    // Ustawia current_ na kolejny krok próbny; false = krok poza zakresem.
+    bool propose_trial() {
+        current_ = incumbent_;
+        double& v = knob_ref(current_, knob_);
+        const double moved = clamp_knob(knob_, (direction_ > 0) ? v * kStep : v / kStep);
+        if (std::abs(moved - v) < 1e-9) return false;
+        v = moved;
+        return true;
+    }
+
+    bool start_trial() {
+        for (int guard = 0; guard < 2 * kKnobs; ++guard) {
+            if (propose_trial()) {
+                phase_ = Phase::Trial;
+                return true;
+            }
+            if (!direction_flipped_) {
+                direction_ = -direction_;
+                direction_flipped_ = true;
+            } else {
+                next_knob();
+            }
+        }
+        current_ = incumbent_;
+        phase_ = Phase::Incumbent;
+        return false;
+    }
+
+    // Test z dla różnicy dwóch temp Poissona: trial (a_t / t_t) vs bieżące.
+    bool trial_wins(double accepted_count, double cpu_s) const {
+        if (accepted_count <= 0.0 || incumbent_cpu_s_ <= 0.0) return false;
+        const double rate_t = accepted_count / cpu_s;
+        const double rate_i = incumbent_accepted_ / incumbent_cpu_s_;
+        const double var = accepted_count / (cpu_s * cpu_s) +
+                           std::max(1.0, incumbent_accepted_) / (incumbent_cpu_s_ * incumbent_cpu_s_);
+        return (rate_t - rate_i) > kAdoptZ * std::sqrt(var);
+    }
+
+    bool finish_epoch(double accepted_count, double cpu_s) {
+        if (phase_ == Phase::Incumbent) {
+            // Starszy pomiar traci połowę wagi - dryf obciążenia maszyny.
+            incumbent_accepted_ = 0.5 * incumbent_accepted_ + accepted_count;
+            incumbent_cpu_s_ = 0.5 * incumbent_cpu_s_ + cpu_s;
+            incumbent_.rate = incumbent_accepted_ / incumbent_cpu_s_;
+            trials_since_refresh_ = 0;
+            start_trial();
+            return true;
+        }
+
+        if (trial_wins(accepted_count, cpu_s)) {
+            incumbent_ = current_;
+            incumbent_accepted_ = accepted_count;
+            incumbent_cpu_s_ = cpu_s;
+            incumbent_.rate = accepted_count / cpu_s;
+            ++adopted_;
+            // Ten sam kierunek jeszcze raz - dopóki się opłaca.
+            direction_flipped_ = true;
+        } else if (!direction_flipped_) {
+            direction_ = -direction_;
+            direction_flipped_ = true;
+        } else {
+            next_knob();
+        }
+
+        // Co kilka prób odświeżamy pomiar bieżącego ustawienia (dryf obciążenia maszyny).
+        if (++trials_since_refresh_ >= 4) {
+            current_ = incumbent_;
+            phase_ = Phase::Incumbent;
+            return true;
+        }
+        start_trial();
+        return true;
+    }
+};
+
+} // namespace sudoku_hpc::generator
@@ -0,0 +1,342 @@
+// ============================================================================
+// SUDOKU HPC - CONCURRENCY
+// Moduł: cpu_topology.h
+// Opis: Topologia CPU/NUMA procesu i rozmieszczenie workerów. Wykrywa dozwolone
+//       CPU (maska afinicji procesu, cgroup/taskset; na Windows wszystkie grupy
+//       procesorów, CPU = grupa * 64 + bit) i ich węzły NUMA, przypina
+//       workery wg polityki (compact: węzeł po węźle, scatter: węzły na zmianę)
+//       i replikuje współdzielone tablice tylko-do-odczytu per węzeł. Przypięcie
+//       następuje przed budową stanu wątku, więc first-touch kładzie jego pamięć
+//       (scratchpady, DLX, cache kandydatów) na lokalnym węźle.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace sudoku_hpc::concurrency {
+
+enum class AffinityPolicy : uint8_t {
+    None,
+    Compact,
+    Scatter
+};
+
+inline AffinityPolicy affinity_policy_from_string(std::string_view s) {
+    if (s == "compact") return AffinityPolicy::Compact;
+    if (s == "scatter") return AffinityPolicy::Scatter;
+    return AffinityPolicy::None;
+}
+
+inline const char* to_string(AffinityPolicy p) {
+    switch (p) {
+        case AffinityPolicy::None: return "none";
+        case AffinityPolicy::Compact: return "compact";
+        case AffinityPolicy::Scatter: return "scatter";
+    }
+    return "none";
+}
+
+struct CpuTopology {
+    // Dozwolone CPU procesu, rosnąco, i ich węzły NUMA (ten sam indeks).
+    std::vector<int> cpus;
+    std::vector<int> cpu_node;
+    // CPU pogrupowane per węzeł (tylko węzły z co najmniej jednym dozwolonym CPU).
+    std::vector<std::vector<int>> node_cpus;
+    // Windows: maska dozwolonych CPU per grupa procesorów (pusta na innych systemach).
+    std::vector<uint64_t> group_masks;
+    bool pinning_supported = false;
+
+    int node_count() const {
+        return std::max(1, static_cast<int>(node_cpus.size()));
+    }
+};
+
+namespace cpu_topology_detail {
+
+// Format sysfs "0-3,8-11".
+inline std::vector<int> parse_cpu_list(const std::string& text) {
+    std::vector<int> out;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find(',', pos);
+        if (end == std::string::npos) end = text.size();
+        const std::string item = text.substr(pos, end - pos);
+        const size_t dash = item.find('-');
+        try {
+            const int a = std::stoi(item.substr(0, dash));
+            const int b = (dash == std::string::npos) ? a : std::stoi(item.substr(dash + 1));
+            for (int c = a; c <= b; ++c) out.push_back(c);
+        } catch (...) {
+        }
+        pos = end + 1;
+    }
+    return out;
+}
+
+inline void group_by_node(CpuTopology& t) {
+    int max_node = 0;
+    for (const int node : t.cpu_node) max_node = std::max(max_node, node);
+    std::vector<std::vector<int>> by_node(static_cast<size_t>(max_node + 1));
+    for (size_t i = 0; i < t.cpus.size(); ++i) {
+        by_node[static_cast<size_t>(t.cpu_node[i])].push_back(t.cpus[i]);
+    }
+    t.node_cpus.clear();
+    for (auto& cpus : by_node) {
+        if (!cpus.empty()) t.node_cpus.push_back(std::move(cpus));
+    }
+    // Węzły bez dozwolonych CPU wypadają - numer węzła to indeks w node_cpus.
+    for (size_t node = 0; node < t.node_cpus.size(); ++node) {
+        for (const int cpu : t.node_cpus[node]) {
+            const auto it = std::find(t.cpus.begin(), t.cpus.end(), cpu);
+            t.cpu_node[static_cast<size_t>(it - t.cpus.begin())] = static_cast<int>(node);
+        }
+    }
+}
+
+#ifdef _WIN32
+// Szerokość grupy procesorów Windows (64 CPU w procesie 64-bit).
+inline constexpr int kGroupWidth = static_cast<int>(sizeof(KAFFINITY) * 8);
+
+// Wpisy GetLogicalProcessorInformationEx mają zmienną długość (pole Size).
+template <typename Fn>
+inline void for_each_processor_info(LOGICAL_PROCESSOR_RELATIONSHIP relation, Fn&& fn) {
+    DWORD len = 0;
+    GetLogicalProcessorInformationEx(relation, nullptr, &len);
+    if (len == 0) return;
+    std::vector<uint8_t> buf(static_cast<size_t>(len));
+    auto* base = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buf.data());
+    if (GetLogicalProcessorInformationEx(relation, base, &len) == 0) return;
+    for (DWORD off = 0; off < len;) {
+        const auto* info = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buf.data() + off);
+        if (info->Size == 0) break;
+        fn(*info);
+        off += info->Size;
+    }
+}
+#endif
+
+inline CpuTopology detect() {
+    CpuTopology t;
+#ifdef _WIN32
+    // Wszystkie aktywne grupy procesorów - maska afinicji procesu obejmuje tylko
+    // jego grupę główną (do 64 CPU), więc przy większej maszynie jej nie wystarcza.
+    cpu_topology_detail::for_each_processor_info(RelationGroup, [&](const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX& info) {
+        for (WORD g = 0; g < info.Group.ActiveGroupCount; ++g) {
+            t.group_masks.push_back(static_cast<uint64_t>(info.Group.GroupInfo[g].ActiveProcessorMask));
+        }
+    });
+    // Maska procesu węższa niż systemowa (start /affinity) = run zawężony do grupy głównej.
+    DWORD_PTR process_mask = 0;
+    DWORD_PTR system_mask = 0;
+    if (!t.group_masks.empty() &&
+        GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask) != 0 &&
+        process_mask != 0 && process_mask != system_mask) {
+        USHORT primary = 0;
+        USHORT group_count = 1;
+        if (GetProcessGroupAffinity(GetCurrentProcess(), &group_count, &primary) == 0) primary = 0;
+        for (size_t g = 0; g < t.group_masks.size(); ++g) {
+            t.group_masks[g] = (g == static_cast<size_t>(primary)) ? (t.group_masks[g] & static_cast<uint64_t>(process_mask)) : 0ULL;
+        }
+    }
+    for (size_t g = 0; g < t.group_masks.size(); ++g) {
+        for (int bit = 0; bit < kGroupWidth; ++bit) {
+            if ((t.group_masks[g] & (1ULL << bit)) != 0) t.cpus.push_back(static_cast<int>(g) * kGroupWidth + bit);
+        }
+    }
+    t.cpu_node.assign(t.cpus.size(), 0);
+    cpu_topology_detail::for_each_processor_info(RelationNumaNode, [&](const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX& info) {
+        const int node = static_cast<int>(info.NumaNode.NodeNumber);
+        const int group = static_cast<int>(info.NumaNode.GroupMask.Group);
+        const uint64_t mask = static_cast<uint64_t>(info.NumaNode.GroupMask.Mask);
+        for (int bit = 0; bit < kGroupWidth; ++bit) {
+            if ((mask & (1ULL << bit)) == 0) continue;
+            const auto it = std::find(t.cpus.begin(), t.cpus.end(), group * kGroupWidth + bit);
+            if (it != t.cpus.end()) t.cpu_node[static_cast<size_t>(it - t.cpus.begin())] = node;
+        }
+    });
+    t.pinning_supported = !t.cpus.empty();
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) t.cpus.push_back(cpu);
+        }
+        t.cpu_node.assign(t.cpus.size(), 0);
+        // Brak sysfs (kontener, stare jądro) = jeden węzeł.
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+            const std::string name = entry.path().filename().string();
+            if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+                name.find_first_not_of("0123456789", 4) != std::string::npos) {
+                continue;
+            }
+            const int node = std::stoi(name.substr(4));
+            std::ifstream in(entry.path() / "cpulist");
+            std::string text;
+            if (!in || !std::getline(in, text)) continue;
+            for (const int cpu : parse_cpu_list(text)) {
+                const auto it = std::find(t.cpus.begin(), t.cpus.end(), cpu);
+                if (it != t.cpus.end()) t.cpu_node[static_cast<size_t>(it - t.cpus.begin())] = node;
+            }
+        }
+        t.pinning_supported = !t.cpus.empty();
+    }
+#endif
+    if (t.cpus.empty()) {
+        const int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int cpu = 0; cpu < hw; ++cpu) t.cpus.push_back(cpu);
+        t.cpu_node.assign(t.cpus.size(), 0);
+    }
+    group_by_node(t);
+    return t;
+}
+
+} // namespace cpu_topology_detail
+
+// Wykrywana raz na proces.
+inline const CpuTopology& cpu_topology() {
+    static const CpuTopology t = cpu_topology_detail::detect();
+    return t;
+}
+
+// Domyślna liczba workerów: dozwolone CPU procesu (nie cała maszyna), czyli
+// taskset/cgroup ograniczający run do jednego węzła daje workery tego węzła.
+inline int default_worker_count() {
+    return std::max(1, static_cast<int>(cpu_topology().cpus.size()));
+}
+
+struct CpuPlacement {
+    int cpu = -1;
+    int node = 0;
+};
+
+// Compact: kolejne workery wypełniają węzeł 0, potem 1... (wspólny L3, lokalna
+// pamięć). Scatter: węzły na zmianę (pełna przepustowość pamięci wszystkich gniazd).
+inline CpuPlacement worker_placement(const CpuTopology& t, AffinityPolicy policy, int worker_idx) {
+    CpuPlacement p{};
+    if (policy == AffinityPolicy::None || t.cpus.empty()) return p;
+    const int nodes = t.node_count();
+    if (policy == AffinityPolicy::Compact) {
+        int idx = worker_idx % static_cast<int>(t.cpus.size());
+        for (int node = 0; node < nodes; ++node) {
+            const auto& cpus = t.node_cpus[static_cast<size_t>(node)];
+            if (idx < static_cast<int>(cpus.size())) {
+                p.cpu = cpus[static_cast<size_t>(idx)];
+                p.node = node;
+                return p;
+            }
+            idx -= static_cast<int>(cpus.size());
+        }
+        return p;
+    }
+    p.node = worker_idx % nodes;
+    const auto& cpus = t.node_cpus[static_cast<size_t>(p.node)];
+    p.cpu = cpus[static_cast<size_t>((worker_idx / nodes) % static_cast<int>(cpus.size()))];
+    return p;
+}
+
+inline bool pin_current_thread(int cpu) {
+    if (cpu < 0) return false;
+#ifdef _WIN32
+    GROUP_AFFINITY ga{};
+    ga.Group = static_cast<WORD>(cpu / cpu_topology_detail::kGroupWidth);
+    ga.Mask = static_cast<KAFFINITY>(1) << (cpu % cpu_topology_detail::kGroupWidth);
+    return SetThreadGroupAffinity(GetCurrentThread(), &ga, nullptr) != 0;
+#elif defined(__linux__)
+    if (cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+// Windows bez polityki: wątek startuje w grupie głównej procesu (przed Windows 11
+// zostaje w niej na stałe), więc przy kilku grupach workery rozkładamy po grupach
+// maską całej grupy - bez przypinania do CPU. Jedna grupa / inne systemy = nic.
+inline void spread_current_thread(const CpuTopology& t, int worker_idx) {
+#ifdef _WIN32
+    int groups = 0;
+    for (const uint64_t mask : t.group_masks) groups += (mask != 0) ? 1 : 0;
+    if (groups < 2) return;
+    int pick = worker_idx % groups;
+    for (size_t g = 0; g < t.group_masks.size(); ++g) {
+        if (t.group_masks[g] == 0 || pick-- != 0) continue;
+        GROUP_AFFINITY ga{};
+        ga.Group = static_cast<WORD>(g);
+        ga.Mask = static_cast<KAFFINITY>(t.group_masks[g]);
+        SetThreadGroupAffinity(GetCurrentThread(), &ga, nullptr);
+        return;
+    }
+#else
+    (void)t;
+    (void)worker_idx;
+#endif
+}
+
+// Wywoływane jako pierwsze w wątku workera, zanim zaalokuje swój stan.
+// Bez polityki (lub bez wsparcia platformy) worker zostaje nieprzypięty na węźle 0.
+inline CpuPlacement place_current_thread(AffinityPolicy policy, int worker_idx) {
+    const CpuTopology& t = cpu_topology();
+    if (!t.pinning_supported) return {};
+    if (policy == AffinityPolicy::None) {
+        spread_current_thread(t, worker_idx);
+        return {};
+    }
+    CpuPlacement p = worker_placement(t, policy, worker_idx);
+    if (!pin_current_thread(p.cpu)) p = {};
+    return p;
+}
+
+// Kopie tylko-do-odczytu obiektu per węzeł NUMA. Kopię robi pierwszy worker
+// danego węzła (już przypięty), więc strony trafiają do pamięci lokalnej.
+// Jeden węzeł albo brak polityki = bez kopii, wszyscy czytają oryginał.
+template <typename T>
+class NodeReplicas {
+public:
+    NodeReplicas(const T& master, int node_count)
+        : master_(master), slots_(static_cast<size_t>(node_count > 1 ? node_count : 0)) {}
+
+    const T& local(int node) {
+        if (node < 0 || static_cast<size_t>(node) >= slots_.size()) return master_;
+        Slot& slot = slots_[static_cast<size_t>(node)];
+        std::call_once(slot.once, [&]() { slot.copy = std::make_unique<T>(master_); });
+        return *slot.copy;
+    }
+
+private:
+    struct Slot {
+        std::once_flag once;
+        std::unique_ptr<T> copy;
+    };
+
+    const T& master_;
+    std::vector<Slot> slots_;
+};
+
+} // namespace sudoku_hpc::concurrency
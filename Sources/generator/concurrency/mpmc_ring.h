@@ -0,0 +1,102 @@
+// ============================================================================
+// SUDOKU HPC - CONCURRENCY
+// Moduł: mpmc_ring.h
+// Opis: Ograniczona kolejka pierścieniowa MPMC (wielu producentów, wielu
+//       konsumentów) bez blokad - numer sekwencji per slot, jak w
+//       TelemetryMpscRing, ale z CAS także po stronie konsumenta. Pojemność
+//       ustalana w konstruktorze (zaokrąglana do potęgi dwójki), bufor
+//       alokowany raz. Pełna kolejka = try_push zwraca false, bez czekania.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace sudoku_hpc::concurrency {
+
+template <typename T>
+class BoundedMpmcRing {
+    static_assert(std::is_trivially_copyable_v<T>, "BoundedMpmcRing wymaga typu trivially copyable");
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> seq{0};
+        T payload{};
+    };
+
+public:
+    explicit BoundedMpmcRing(size_t min_capacity) {
+        size_t cap = 1;
+        while (cap < min_capacity) cap <<= 1;
+        capacity_ = cap;
+        mask_ = static_cast<uint64_t>(cap - 1);
+        slots_ = std::make_unique<Slot[]>(cap);
+        for (size_t i = 0; i < cap; ++i) {
+            slots_[i].seq.store(static_cast<uint64_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    bool try_push(const T& value) noexcept {
+        uint64_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[static_cast<size_t>(pos & mask_)];
+            const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1ULL, std::memory_order_relaxed, std::memory_order_relaxed)) {
+                    slot.payload = value;
+                    slot.seq.store(pos + 1ULL, std::memory_order_release);
+                    return true;
+                }
+                continue;
+            }
+            if (diff < 0) return false;
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    bool try_pop(T& out) noexcept {
+        uint64_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[static_cast<size_t>(pos & mask_)];
+            const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1ULL);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1ULL, std::memory_order_relaxed, std::memory_order_relaxed)) {
+                    out = slot.payload;
+                    slot.seq.store(pos + capacity_, std::memory_order_release);
+                    return true;
+                }
+                continue;
+            }
+            if (diff < 0) return false;
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Przybliżona liczba elementów (migawka bez synchronizacji z operacjami w toku).
+    size_t size_approx() const noexcept {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        return head > tail ? static_cast<size_t>(head - tail) : 0;
+    }
+
+    size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+    size_t capacity_ = 0;
+    uint64_t mask_ = 0;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+};
+
+} // namespace sudoku_hpc::concurrency
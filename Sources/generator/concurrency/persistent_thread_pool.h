@@ -33,6 +33,26 @@ public:
         }
 
         std::lock_guard<std::mutex> run_guard(run_mu_);
+        run_locked(task_count, fn);
+    }
+
+    // Jak run(), ale nie czeka na zwolnienie puli zajętej przez inny wątek -
+    // zwraca false i wywołujący wykonuje pracę sam.
+    bool try_run(int task_count, const std::function<void(int)>& fn) {
+        if (task_count <= 0) {
+            return true;
+        }
+
+        std::unique_lock<std::mutex> run_guard(run_mu_, std::try_to_lock);
+        if (!run_guard.owns_lock()) {
+            return false;
+        }
+        run_locked(task_count, fn);
+        return true;
+    }
+
+private:
+    void run_locked(int task_count, const std::function<void(int)>& fn) {
         ensure_workers(task_count);
 
         job_fn_ = &fn;
@@ -55,7 +75,6 @@ public:
         }
     }
 
-private:
     PersistentThreadPool() = default;
 
     ~PersistentThreadPool() {
@@ -0,0 +1,67 @@
+// ============================================================================
+// SUDOKU HPC - CONCURRENCY
+// Moduł: seqlock.h
+// Opis: Slot z seqlockiem dla rekordów POD z jednym pisarzem i wieloma
+//       czytelnikami. Pisarz nigdy nie czeka; czytelnik powtarza odczyt, gdy
+//       trafi na zapis w toku. Dane trzymane jako słowa atomowe (relaxed), więc
+//       równoległa kopia nie jest wyścigiem danych w sensie modelu pamięci C++.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace sudoku_hpc::concurrency {
+
+template <typename T>
+class alignas(64) SeqlockSlot {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqlockSlot wymaga typu trivially copyable");
+
+public:
+    // Tylko właściciel slotu (jeden wątek) wywołuje store().
+    void store(const T& value) noexcept {
+        Words buf{};
+        std::memcpy(buf.data(), &value, sizeof(T));
+        const uint32_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) words_[i].store(buf[i], std::memory_order_relaxed);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    // Spójna kopia ostatniego zapisu; false = slot jeszcze nigdy nie zapisany.
+    bool load(T& out) const noexcept {
+        Words buf{};
+        uint32_t s0 = 0;
+        for (;;) {
+            s0 = seq_.load(std::memory_order_acquire);
+            if ((s0 & 1U) != 0) {
+                // Pisarz wywłaszczony w trakcie zapisu - oddaj mu CPU.
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < kWords; ++i) buf[i] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == s0) break;
+        }
+        if (s0 == 0) return false;
+        std::memcpy(static_cast<void*>(&out), buf.data(), sizeof(T));
+        return true;
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    using Words = std::array<uint64_t, kWords>;
+
+    std::atomic<uint32_t> seq_{0};
+    std::array<std::atomic<uint64_t>, kWords> words_{};
+};
+
+} // namespace sudoku_hpc::concurrency
@@ -0,0 +1,253 @@
+// ============================================================================
+// SUDOKU HPC - CORE ENGINES
+// Moduł: batch_lockstep_solver.h
+// Opis: Wsadowe sprawdzanie unikalności dla małych geometrii (4x4..12x12).
+//       Do 16 łamigłówek tej samej geometrii w pasach (po jednej na pas),
+//       maski kandydatów uint16 w układzie [komórka][pas]. Propagacja naked
+//       i hidden singles idzie lock-step dla wszystkich pasów naraz (pętle po
+//       pasach wektoryzowane pod AVX2), pasy martwe/rozwiązane są maskowane.
+//       Pasy nierozstrzygnięte po propagacji trafiają pojedynczo do skalarnego
+//       GenericUniquenessCounter (masked DLX / bitboard 9x9). Zero-allocation.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "../../core/geometry.h"
+#include "dlx_solver.h"
+#include "solved_kernel.h"
+
+namespace sudoku_hpc::core_engines {
+
+struct BatchLockstepCounter {
+    static constexpr int kLanes = 16;
+    static constexpr int kMinN = 4;
+    static constexpr int kMaxN = 12;
+    static constexpr int kMaxNN = kMaxN * kMaxN;
+
+    using LaneWord = std::array<uint16_t, kLanes>;
+
+    static bool applicable(const GenericTopology& topo) {
+        return topo.n >= kMinN && topo.n <= kMaxN;
+    }
+
+    // Liczy min(liczba rozwiązań, limit) dla każdej łamigłówki z `puzzles`
+    // (wszystkie o geometrii topo). Tylko pierwsze `fallback_count` łamigłówek jest
+    // rozstrzyganych do końca skalarnym szukaniem; pozostałe, jeśli propagacja ich nie
+    // zamknie, dostają -1 (tak samo pasy nierozstrzygnięte po przerwaniu budżetem).
+    // Zwraca false po przerwaniu budżetem.
+    bool count_solutions_limit_batch(
+        std::span<const std::span<const uint16_t>> puzzles,
+        const GenericTopology& topo,
+        int limit,
+        const GenericUniquenessCounter& fallback,
+        std::span<int> out_counts,
+        SearchAbortControl* budget = nullptr,
+        size_t fallback_count = SIZE_MAX) const {
+        if (out_counts.size() < puzzles.size()) return false;
+        for (size_t k = 0; k < puzzles.size(); ++k) out_counts[k] = -1;
+        if (!applicable(topo) || limit <= 0) {
+            for (size_t k = 0; k < puzzles.size(); ++k) {
+                if (limit <= 0) {
+                    out_counts[k] = 0;
+                } else if (k < fallback_count) {
+                    out_counts[k] = fallback.count_solutions_limit(puzzles[k], topo, limit, budget);
+                    if (out_counts[k] < 0) return false;
+                }
+            }
+            return true;
+        }
+
+        for (size_t base = 0; base < puzzles.size(); base += kLanes) {
+            const int lanes = static_cast<int>(std::min<size_t>(kLanes, puzzles.size() - base));
+            if (!load_lanes(puzzles.subspan(base, static_cast<size_t>(lanes)), topo)) {
+                for (int l = 0; l < lanes; ++l) out_counts[base + static_cast<size_t>(l)] = 0;
+                continue;
+            }
+            if (!propagate_lockstep(topo, budget)) return false;
+
+            for (int l = 0; l < lanes; ++l) {
+                int& out = out_counts[base + static_cast<size_t>(l)];
+                if (dead_[static_cast<size_t>(l)] != 0U) {
+                    out = 0;
+                    continue;
+                }
+                if (lane_solved(topo, l)) {
+                    out = 1;
+                    continue;
+                }
+                if (base + static_cast<size_t>(l) >= fallback_count) continue;
+                for (int idx = 0; idx < topo.nn; ++idx) {
+                    lane_masks_[static_cast<size_t>(idx)] = cand_[static_cast<size_t>(idx)][static_cast<size_t>(l)];
+                }
+                out = fallback.count_solutions_limit_masked(
+                    puzzles[base + static_cast<size_t>(l)],
+                    topo,
+                    std::span<const uint64_t>(lane_masks_.data(), static_cast<size_t>(topo.nn)),
+                    limit,
+                    budget);
+                if (out < 0) return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    mutable std::array<LaneWord, kMaxNN> cand_{};
+    // Maski singli już rozpropagowanych do rówieśników (per komórka, per pas).
+    mutable std::array<LaneWord, kMaxNN> pushed_{};
+    mutable LaneWord dead_{};
+    mutable std::array<uint64_t, kMaxNN> lane_masks_{};
+
+    bool load_lanes(std::span<const std::span<const uint16_t>> puzzles, const GenericTopology& topo) const {
+        const uint16_t full = static_cast<uint16_t>((1U << topo.n) - 1U);
+        bool any_live = false;
+        for (int l = 0; l < kLanes; ++l) {
+            const bool used = l < static_cast<int>(puzzles.size()) &&
+                              static_cast<int>(puzzles[static_cast<size_t>(l)].size()) == topo.nn;
+            dead_[static_cast<size_t>(l)] = used ? 0U : 0xFFFFU;
+            any_live |= used;
+        }
+        for (int idx = 0; idx < topo.nn; ++idx) {
+            LaneWord& c = cand_[static_cast<size_t>(idx)];
+            for (int l = 0; l < kLanes; ++l) {
+                uint16_t m = full;
+                if (dead_[static_cast<size_t>(l)] == 0U) {
+                    const int v = static_cast<int>(puzzles[static_cast<size_t>(l)][static_cast<size_t>(idx)]);
+                    if (v > topo.n) {
+                        dead_[static_cast<size_t>(l)] = 0xFFFFU;
+                    } else if (v > 0) {
+                        m = static_cast<uint16_t>(1U << (v - 1));
+                    }
+                }
+                c[static_cast<size_t>(l)] = m;
+            }
+            pushed_[static_cast<size_t>(idx)].fill(0U);
+        }
+        return any_live;
+    }
+
+    bool lane_solved(const GenericTopology& topo, int l) const {
+        for (int idx = 0; idx < topo.nn; ++idx) {
+            const uint16_t m = cand_[static_cast<size_t>(idx)][static_cast<size_t>(l)];
+            if ((m & (m - 1U)) != 0U) return false;
+        }
+        return true;
+    }
+
+    // Jedna runda: naked singles -> eliminacja u rówieśników, hidden singles w domkach,
+    // wykrycie sprzeczności. Zwraca true, gdy w jakimkolwiek żywym pasie coś się zmieniło.
+    SUDOKU_HOT_INLINE bool lockstep_round_impl(const GenericTopology& topo) const {
+        const uint16_t full = static_cast<uint16_t>((1U << topo.n) - 1U);
+        LaneWord changed{};
+
+        for (int idx = 0; idx < topo.nn; ++idx) {
+            const LaneWord& c = cand_[static_cast<size_t>(idx)];
+            LaneWord& pushed = pushed_[static_cast<size_t>(idx)];
+            LaneWord single{};
+            uint16_t any = 0U;
+            for (int l = 0; l < kLanes; ++l) {
+                const uint16_t m = c[static_cast<size_t>(l)];
+                const uint16_t s = ((m & (m - 1U)) == 0U) ? m : uint16_t{0};
+                single[static_cast<size_t>(l)] = static_cast<uint16_t>(s & ~pushed[static_cast<size_t>(l)] & ~dead_[static_cast<size_t>(l)]);
+                pushed[static_cast<size_t>(l)] |= s;
+                any |= single[static_cast<size_t>(l)];
+            }
+            if (any == 0U) continue;
+            const int p0 = topo.peer_offsets[static_cast<size_t>(idx)];
+            const int p1 = topo.peer_offsets[static_cast<size_t>(idx + 1)];
+            for (int p = p0; p < p1; ++p) {
+                LaneWord& pc = cand_[static_cast<size_t>(topo.peers_flat[static_cast<size_t>(p)])];
+                for (int l = 0; l < kLanes; ++l) {
+                    const uint16_t before = pc[static_cast<size_t>(l)];
+                    const uint16_t after = static_cast<uint16_t>(before & ~single[static_cast<size_t>(l)]);
+                    pc[static_cast<size_t>(l)] = after;
+                    changed[static_cast<size_t>(l)] |= static_cast<uint16_t>(before ^ after);
+                }
+            }
+        }
+
+        const int house_count = 3 * topo.n;
+        for (int h = 0; h < house_count; ++h) {
+            const int h0 = topo.house_offsets[static_cast<size_t>(h)];
+            const int h1 = topo.house_offsets[static_cast<size_t>(h + 1)];
+            LaneWord ones{};
+            LaneWord twos{};
+            for (int i = h0; i < h1; ++i) {
+                const LaneWord& c = cand_[static_cast<size_t>(topo.houses_flat[static_cast<size_t>(i)])];
+                for (int l = 0; l < kLanes; ++l) {
+                    twos[static_cast<size_t>(l)] |= static_cast<uint16_t>(ones[static_cast<size_t>(l)] & c[static_cast<size_t>(l)]);
+                    ones[static_cast<size_t>(l)] |= c[static_cast<size_t>(l)];
+                }
+            }
+            LaneWord hidden{};
+            for (int l = 0; l < kLanes; ++l) {
+                // Cyfra bez miejsca w domku -> sprzeczność pasa.
+                const uint16_t missing = static_cast<uint16_t>(full & ~ones[static_cast<size_t>(l)]);
+                dead_[static_cast<size_t>(l)] |= (missing != 0U) ? uint16_t{0xFFFFU} : uint16_t{0};
+                hidden[static_cast<size_t>(l)] = static_cast<uint16_t>(ones[static_cast<size_t>(l)] & ~twos[static_cast<size_t>(l)]);
+            }
+            for (int i = h0; i < h1; ++i) {
+                LaneWord& c = cand_[static_cast<size_t>(topo.houses_flat[static_cast<size_t>(i)])];
+                for (int l = 0; l < kLanes; ++l) {
+                    const uint16_t m = c[static_cast<size_t>(l)];
+                    const uint16_t hm = static_cast<uint16_t>(m & hidden[static_cast<size_t>(l)]);
+                    // Dwie cyfry ukryte w tej samej komórce -> sprzeczność pasa.
+                    dead_[static_cast<size_t>(l)] |= ((hm & (hm - 1U)) != 0U) ? uint16_t{0xFFFFU} : uint16_t{0};
+                    const uint16_t after = (hm != 0U) ? hm : m;
+                    c[static_cast<size_t>(l)] = after;
+                    changed[static_cast<size_t>(l)] |= static_cast<uint16_t>(m ^ after);
+                }
+            }
+        }
+
+        for (int idx = 0; idx < topo.nn; ++idx) {
+            const LaneWord& c = cand_[static_cast<size_t>(idx)];
+            for (int l = 0; l < kLanes; ++l) {
+                dead_[static_cast<size_t>(l)] |= (c[static_cast<size_t>(l)] == 0U) ? uint16_t{0xFFFFU} : uint16_t{0};
+            }
+        }
+
+        uint16_t live_changed = 0U;
+        for (int l = 0; l < kLanes; ++l) {
+            live_changed |= static_cast<uint16_t>(changed[static_cast<size_t>(l)] & ~dead_[static_cast<size_t>(l)]);
+        }
+        return live_changed != 0U;
+    }
+
+    bool lockstep_round_scalar(const GenericTopology& topo) const {
+        return lockstep_round_impl(topo);
+    }
+
+    SUDOKU_TARGET_AVX2 bool lockstep_round_avx2(const GenericTopology& topo) const {
+        return lockstep_round_impl(topo);
+    }
+
+    static bool cpu_has_avx2() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        static const bool kHasAvx2 = __builtin_cpu_supports("avx2");
+        return kHasAvx2;
+#else
+        return false;
+#endif
+    }
+
+    bool propagate_lockstep(const GenericTopology& topo, SearchAbortControl* budget) const {
+        const bool avx2 = cpu_has_avx2();
+        while (true) {
+            if (budget != nullptr && !budget->step()) return false;
+            const bool changed = avx2 ? lockstep_round_avx2(topo) : lockstep_round_scalar(topo);
+            if (!changed) return true;
+        }
+    }
+};
+
+} // namespace sudoku_hpc::core_engines
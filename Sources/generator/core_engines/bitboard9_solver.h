@@ -0,0 +1,359 @@
+// ============================================================================
+// SUDOKU HPC - CORE ENGINES
+// Moduł: bitboard9_solver.h
+// Opis: Wyspecjalizowany backend 9x9 (bloki 3x3) dla liczenia rozwiązań.
+//       Kandydaci jako bitboardy pasmowe: dla każdej cyfry 3 słowa po 27 bitów
+//       (pasmo = 3 wiersze x 9 kolumn). Propagacja naked/hidden singles oraz
+//       locked candidates (pointing/claiming) operacjami SWAR na całym paśmie,
+//       rozgałęzienie MRV z kopią stanu (120 B) na stosie. Zero-allocation.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../../core/board.h"
+
+namespace sudoku_hpc::core_engines {
+
+struct Bitboard9Tables {
+    std::array<uint32_t, 3> row{};  // wiersz w paśmie
+    std::array<uint32_t, 9> col{};  // kolumna w paśmie
+    std::array<uint32_t, 3> box{};  // blok (stos) w paśmie
+};
+
+inline constexpr Bitboard9Tables make_bitboard9_tables() {
+    Bitboard9Tables t{};
+    for (int k = 0; k < 3; ++k) t.row[static_cast<size_t>(k)] = 0x1FFU << (9 * k);
+    for (int c = 0; c < 9; ++c) t.col[static_cast<size_t>(c)] = (1U << c) | (1U << (c + 9)) | (1U << (c + 18));
+    for (int s = 0; s < 3; ++s) {
+        t.box[static_cast<size_t>(s)] =
+            t.col[static_cast<size_t>(3 * s)] | t.col[static_cast<size_t>(3 * s + 1)] | t.col[static_cast<size_t>(3 * s + 2)];
+    }
+    return t;
+}
+
+struct Bitboard9Solver {
+    static constexpr int kN = 9;
+    static constexpr int kNN = 81;
+    static constexpr uint32_t kBandFull = (1U << 27) - 1U;
+
+    struct State {
+        uint32_t cand[9][3]; // [cyfra][pasmo] - pozycje dopuszczalne (w tym komórka rozwiązana)
+        uint32_t unsolved[3];
+        uint16_t hs_dirty;   // cyfry do ponownego skanu hidden singles
+        uint16_t lc_dirty;   // cyfry do ponownego skanu locked candidates
+    };
+
+    static constexpr uint16_t kAllDigits = 0x1FF;
+    static constexpr Bitboard9Tables kT = make_bitboard9_tables();
+
+    static bool applicable(const GenericTopology& topo) {
+        return topo.n == kN && topo.box_rows == 3 && topo.box_cols == 3;
+    }
+
+    // Stos stanów per głębokość (maks. 81 rozgałęzień) - bez alokacji w trakcie szukania.
+    mutable std::array<State, kNN + 1> stack_{};
+    mutable std::array<uint8_t, kNN> solution_{};
+    mutable int count_ = 0;
+    mutable int limit_ = 0;
+    mutable bool aborted_ = false;
+
+    static bool place(State& s, int d, int band, int p) {
+        const uint32_t bit = 1U << p;
+        if ((s.cand[d][band] & bit) == 0U) return false;
+        uint16_t touched = static_cast<uint16_t>(1U << d);
+        for (int x = 0; x < kN; ++x) {
+            if ((s.cand[x][band] & bit) != 0U) touched |= static_cast<uint16_t>(1U << x);
+            s.cand[x][band] &= ~bit;
+        }
+        const int r = p / 9;
+        const int c = p - r * 9;
+        const uint32_t col = kT.col[static_cast<size_t>(c)];
+        for (int b = 0; b < 3; ++b) {
+            if (b != band) s.cand[d][b] &= ~col;
+        }
+        s.cand[d][band] =
+            (s.cand[d][band] & ~(kT.row[static_cast<size_t>(r)] | kT.box[static_cast<size_t>(c / 3)] | col)) | bit;
+        s.unsolved[band] &= ~bit;
+        s.hs_dirty |= touched;
+        s.lc_dirty |= touched;
+        return true;
+    }
+
+    // Naked singles w bit-slicingu (ones/twos po 9 cyfrach). -1 sprzeczność, 1 postęp.
+    static int naked_singles(State& s) {
+        int progress = 0;
+        for (int b = 0; b < 3; ++b) {
+            if (s.unsolved[b] == 0U) continue;
+            uint32_t ones = 0U;
+            uint32_t twos = 0U;
+            for (int d = 0; d < kN; ++d) {
+                const uint32_t c = s.cand[d][b] & s.unsolved[b];
+                twos |= ones & c;
+                ones |= c;
+            }
+            if ((s.unsolved[b] & ~ones) != 0U) return -1;
+            uint32_t singles = ones & ~twos;
+            while (singles != 0U) {
+                const int p = std::countr_zero(singles);
+                singles &= singles - 1U;
+                const uint32_t bit = 1U << p;
+                if ((s.unsolved[b] & bit) == 0U) continue;
+                int d = 0;
+                while (d < kN && (s.cand[d][b] & bit) == 0U) ++d;
+                if (d == kN || !place(s, d, b, p)) return -1;
+                progress = 1;
+            }
+        }
+        return progress;
+    }
+
+    // Hidden singles tylko dla cyfr zmienionych od ostatniego skanu (hs_dirty).
+    static int hidden_singles(State& s) {
+        int progress = 0;
+        while (s.hs_dirty != 0U) {
+            const int d = std::countr_zero(static_cast<uint32_t>(s.hs_dirty));
+            s.hs_dirty &= static_cast<uint16_t>(s.hs_dirty - 1U);
+            if (((s.cand[d][0] & s.unsolved[0]) | (s.cand[d][1] & s.unsolved[1]) | (s.cand[d][2] & s.unsolved[2])) == 0U) {
+                continue;
+            }
+            for (int b = 0; b < 3; ++b) {
+                for (int k = 0; k < 3; ++k) {
+                    const uint32_t m = s.cand[d][b] & kT.row[static_cast<size_t>(k)];
+                    if (m == 0U) return -1;
+                    if ((m & (m - 1U)) == 0U && (m & s.unsolved[b]) != 0U) {
+                        if (!place(s, d, b, std::countr_zero(m))) return -1;
+                        progress = 1;
+                    }
+                }
+                for (int bx = 0; bx < 3; ++bx) {
+                    const uint32_t m = s.cand[d][b] & kT.box[static_cast<size_t>(bx)];
+                    if (m == 0U) return -1;
+                    if ((m & (m - 1U)) == 0U && (m & s.unsolved[b]) != 0U) {
+                        if (!place(s, d, b, std::countr_zero(m))) return -1;
+                        progress = 1;
+                    }
+                }
+            }
+            for (int c = 0; c < kN; ++c) {
+                const uint32_t col = kT.col[static_cast<size_t>(c)];
+                const uint32_t m0 = s.cand[d][0] & col;
+                const uint32_t m1 = s.cand[d][1] & col;
+                const uint32_t m2 = s.cand[d][2] & col;
+                const int cnt = std::popcount(m0) + std::popcount(m1) + std::popcount(m2);
+                if (cnt == 0) return -1;
+                if (cnt != 1) continue;
+                const int b = (m0 != 0U) ? 0 : ((m1 != 0U) ? 1 : 2);
+                const uint32_t m = m0 | m1 | m2;
+                if ((m & s.unsolved[b]) == 0U) continue;
+                if (!place(s, d, b, std::countr_zero(m))) return -1;
+                progress = 1;
+            }
+            if (progress != 0) return progress;
+        }
+        return progress;
+    }
+
+    // Locked candidates: blok ograniczony do wiersza/kolumny (pointing) oraz wiersz
+    // ograniczony do bloku (claiming). Kolumna -> blok pomijana (rzadka, droga w pasmach).
+    static bool locked_candidates(State& s) {
+        bool progress = false;
+        while (s.lc_dirty != 0U) {
+            const int d = std::countr_zero(static_cast<uint32_t>(s.lc_dirty));
+            s.lc_dirty &= static_cast<uint16_t>(s.lc_dirty - 1U);
+            bool changed = false;
+            for (int b = 0; b < 3; ++b) {
+                uint32_t m = s.cand[d][b];
+                if ((m & s.unsolved[b]) == 0U) continue;
+                for (int bx = 0; bx < 3; ++bx) {
+                    const uint32_t box = kT.box[static_cast<size_t>(bx)];
+                    const uint32_t in_box = m & box;
+                    for (int k = 0; k < 3; ++k) {
+                        const uint32_t row = kT.row[static_cast<size_t>(k)];
+                        const uint32_t in_row = m & row;
+                        if (in_box != 0U && (in_box & ~row) == 0U) {
+                            m &= ~(row & ~box);
+                        } else if (in_row != 0U && (in_row & ~box) == 0U) {
+                            m &= ~(box & ~row);
+                        }
+                    }
+                    for (int j = 0; j < 3; ++j) {
+                        const uint32_t col = kT.col[static_cast<size_t>(3 * bx + j)];
+                        if (in_box == 0U || (in_box & ~col) != 0U) continue;
+                        for (int ob = 0; ob < 3; ++ob) {
+                            if (ob == b) continue;
+                            const uint32_t before = s.cand[d][ob];
+                            s.cand[d][ob] = before & ~col;
+                            changed |= (before != s.cand[d][ob]);
+                        }
+                    }
+                }
+                changed |= (m != s.cand[d][b]);
+                s.cand[d][b] = m;
+            }
+            if (changed) {
+                s.hs_dirty |= static_cast<uint16_t>(1U << d);
+                s.lc_dirty |= static_cast<uint16_t>(1U << d);
+                progress = true;
+                break;
+            }
+        }
+        return progress;
+    }
+
+    static bool propagate(State& s) {
+        while (true) {
+            const int ns = naked_singles(s);
+            if (ns < 0) return false;
+            if (ns > 0) continue;
+            const int hs = hidden_singles(s);
+            if (hs < 0) return false;
+            if (hs > 0) continue;
+            if (!locked_candidates(s)) return true;
+        }
+    }
+
+    // Komórka o najmniejszej liczbie kandydatów (bivalue z bit-slicingu, inaczej skan).
+    static bool choose_cell(const State& s, int& out_band, int& out_p) {
+        int best = kN + 1;
+        for (int b = 0; b < 3; ++b) {
+            if (s.unsolved[b] == 0U) continue;
+            uint32_t ones = 0U;
+            uint32_t twos = 0U;
+            uint32_t threes = 0U;
+            for (int d = 0; d < kN; ++d) {
+                const uint32_t c = s.cand[d][b] & s.unsolved[b];
+                threes |= twos & c;
+                twos |= ones & c;
+                ones |= c;
+            }
+            const uint32_t bivalue = twos & ~threes;
+            if (bivalue != 0U) {
+                out_band = b;
+                out_p = std::countr_zero(bivalue);
+                return true;
+            }
+            for (uint32_t w = s.unsolved[b]; w != 0U; w &= w - 1U) {
+                const int p = std::countr_zero(w);
+                int cnt = 0;
+                for (int d = 0; d < kN; ++d) cnt += static_cast<int>((s.cand[d][b] >> p) & 1U);
+                if (cnt < best) {
+                    best = cnt;
+                    out_band = b;
+                    out_p = p;
+                }
+            }
+        }
+        return best <= kN;
+    }
+
+    // DFS: true = zatrzymać (limit rozwiązań osiągnięty lub budżet wyczerpany).
+    // Budget jako parametr szablonu - SearchAbortControl definiuje dlx_solver.h.
+    template <typename Budget>
+    bool search(int depth, Budget* budget) const {
+        if (budget != nullptr && !budget->step()) {
+            aborted_ = true;
+            return true;
+        }
+        State& s = stack_[static_cast<size_t>(depth)];
+        if (!propagate(s)) return false;
+        if ((s.unsolved[0] | s.unsolved[1] | s.unsolved[2]) == 0U) {
+            if (count_ == 0) capture_solution(s);
+            return ++count_ >= limit_;
+        }
+        int band = 0;
+        int p = 0;
+        if (!choose_cell(s, band, p)) return false;
+        const uint32_t bit = 1U << p;
+        State& child = stack_[static_cast<size_t>(depth + 1)];
+        for (int d = 0; d < kN; ++d) {
+            if ((s.cand[d][band] & bit) == 0U) continue;
+            child = s;
+            if (!place(child, d, band, p)) continue;
+            if (search(depth + 1, budget)) return true;
+        }
+        return false;
+    }
+
+    // Stan startowy: wskazówki, potem ograniczenie pustych komórek maskami (opcjonalne).
+    bool init_state(std::span<const uint16_t> puzzle, std::span<const uint64_t> allowed_masks) const {
+        if (static_cast<int>(puzzle.size()) != kNN) return false;
+        if (!allowed_masks.empty() && static_cast<int>(allowed_masks.size()) != kNN) return false;
+        State& s = stack_[0];
+        for (int d = 0; d < kN; ++d) {
+            for (int b = 0; b < 3; ++b) s.cand[d][b] = kBandFull;
+        }
+        for (int b = 0; b < 3; ++b) s.unsolved[b] = kBandFull;
+        s.hs_dirty = kAllDigits;
+        s.lc_dirty = kAllDigits;
+        for (int idx = 0; idx < kNN; ++idx) {
+            const int v = static_cast<int>(puzzle[static_cast<size_t>(idx)]);
+            if (v == 0) continue;
+            if (v < 1 || v > kN) return false;
+            if (!place(s, v - 1, idx / 27, idx % 27)) return false;
+        }
+        if (!allowed_masks.empty()) {
+            for (int idx = 0; idx < kNN; ++idx) {
+                if (puzzle[static_cast<size_t>(idx)] != 0) continue;
+                const uint64_t allowed = allowed_masks[static_cast<size_t>(idx)];
+                const uint32_t bit = 1U << (idx % 27);
+                for (int d = 0; d < kN; ++d) {
+                    if ((allowed & (1ULL << d)) == 0ULL) s.cand[d][idx / 27] &= ~bit;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Zwraca min(liczba rozwiązań, limit) lub -1 po przerwaniu budżetem.
+    template <typename Budget>
+    int count_solutions_limit(
+        std::span<const uint16_t> puzzle,
+        std::span<const uint64_t> allowed_masks,
+        int limit,
+        Budget* budget) const {
+        if (limit <= 0) return 0;
+        if (!init_state(puzzle, allowed_masks)) return 0;
+        count_ = 0;
+        limit_ = limit;
+        aborted_ = false;
+        search(0, budget);
+        if (aborted_) return -1;
+        return count_;
+    }
+
+    template <typename Budget>
+    bool solve(
+        std::span<const uint16_t> puzzle,
+        std::span<const uint64_t> allowed_masks,
+        std::vector<uint16_t>& out_solution,
+        Budget* budget) const {
+        if (!init_state(puzzle, allowed_masks)) return false;
+        count_ = 0;
+        limit_ = 1;
+        aborted_ = false;
+        search(0, budget);
+        if (aborted_ || count_ == 0) return false;
+        if (out_solution.size() != static_cast<size_t>(kNN)) out_solution.resize(static_cast<size_t>(kNN));
+        for (int idx = 0; idx < kNN; ++idx) out_solution[static_cast<size_t>(idx)] = solution_[static_cast<size_t>(idx)];
+        return true;
+    }
+
+    void capture_solution(const State& s) const {
+        for (int idx = 0; idx < kNN; ++idx) {
+            const uint32_t bit = 1U << (idx % 27);
+            int d = 0;
+            while (d < kN && (s.cand[d][idx / 27] & bit) == 0U) ++d;
+            solution_[static_cast<size_t>(idx)] = static_cast<uint8_t>(d + 1);
+        }
+    }
+};
+
+} // namespace sudoku_hpc::core_engines
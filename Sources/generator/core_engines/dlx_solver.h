@@ -22,7 +22,9 @@
 
 #include "../../core/geometry.h"
 #include "../../core/board.h"
+#include "../../core/tick_clock.h"
 #include "../../config/bit_utils.h" 
+#include "bitboard9_solver.h"
 
 namespace sudoku_hpc::core_engines {
 
@@ -36,15 +38,25 @@ struct SearchAbortControl {
     const std::atomic<bool>* force_abort_ptr = nullptr;
     const std::atomic<bool>* cancel_ptr = nullptr;
     const std::atomic<bool>* pause_ptr = nullptr;
+    // Wspólna flaga grupy (równoległe liczenie): ustawiona, gdy inny wątek osiągnął limit.
+    const std::atomic<bool>* group_stop_ptr = nullptr;
 
     bool aborted_by_time = false;
     bool aborted_by_nodes = false;
     bool aborted_by_cancel = false;
     bool aborted_by_pause = false;
     bool aborted_by_force = false;
+    bool stopped_by_group = false;
+
+    // Zegar odpytywany co kClockPollSteps wywołań step(): odczyt TSC względem
+    // deadline przeliczonego raz (tick_deadline_from), zamiast steady_clock na węzeł.
+    static constexpr uint32_t kClockPollSteps = 32;
+    uint64_t deadline_tick_ns = 0;
+    uint32_t clock_countdown = 0;
 
     bool aborted() const {
-        return aborted_by_time || aborted_by_nodes || aborted_by_cancel || aborted_by_pause || aborted_by_force;
+        return aborted_by_time || aborted_by_nodes || aborted_by_cancel || aborted_by_pause || aborted_by_force ||
+               stopped_by_group;
     }
 
     bool step(uint64_t add_nodes = 1) {
@@ -54,6 +66,10 @@ struct SearchAbortControl {
             aborted_by_force = true;
             return false;
         }
+        if (group_stop_ptr != nullptr && group_stop_ptr->load(std::memory_order_relaxed)) {
+            stopped_by_group = true;
+            return false;
+        }
         if (cancel_ptr != nullptr && cancel_ptr->load(std::memory_order_relaxed)) {
             aborted_by_cancel = true;
             return false;
@@ -66,14 +82,29 @@ struct SearchAbortControl {
             aborted_by_nodes = true;
             return false;
         }
-        if (time_enabled && std::chrono::steady_clock::now() >= deadline) {
-            aborted_by_time = true;
-            return false;
+        if (time_enabled) {
+            if (aborted_by_time) return false;
+            if (clock_countdown == 0) {
+                clock_countdown = kClockPollSteps;
+                if (deadline_tick_ns == 0) deadline_tick_ns = tick_deadline_from(deadline);
+                if (tick_now_ns() >= deadline_tick_ns) {
+                    aborted_by_time = true;
+                    return false;
+                }
+            }
+            --clock_countdown;
         }
         return true;
     }
 };
 
+// Wynik iteracyjnego przeszukiwania DLX.
+enum class DlxSearchStatus : uint8_t {
+    Exhausted = 0,    // drzewo przeszukane w całości
+    LimitReached = 1, // osiągnięto limit rozwiązań
+    Suspended = 2,    // budżet wyczerpany - front zachowany, można wznowić
+};
+
 struct GenericUniquenessCounter {
     static constexpr int kUnifiedMaxN = 64;
 
@@ -99,17 +130,38 @@ struct GenericUniquenessCounter {
         std::vector<uint16_t> undo_col_idx;
         std::vector<uint64_t> undo_col_old;
 
-        // Płaski stos dla zagnieżdżeń DFS z rekurencją zamienioną na "fake-recurrency" w DLX
+        // Jawny stos ramek DFS: per głębokość zbiór wierszy do sprawdzenia (zużywane bity
+        // są zerowane), kursor słowa oraz znaczniki logów cofania sprzed wyboru wiersza.
         std::vector<uint64_t> recursion_stack;
+        std::vector<size_t> frame_active_marker;
+        std::vector<size_t> frame_col_marker;
+        std::vector<int> frame_word;
         std::vector<int> solution_rows;
         int solution_depth = 0;
 
+        // Kursor przeszukiwania - pozwala wznowić DFS po wyczerpaniu budżetu.
+        int search_depth = 0;
+        bool search_entering = true;
+        bool search_resumable = false;
+        int search_count = 0;
+        int search_limit = 0;
+        // Tryb liczenia z propagacją: kolumny z jednym wierszem (naked/hidden single)
+        // są domykane w węźle bez rozgałęzienia i bez liczenia węzła budżetu.
+        bool propagate_singles = false;
+
         bool matches(const GenericTopology& topo) const {
             return n == topo.n && nn == topo.nn;
         }
     };
 
     mutable UnifiedWideDlx ws_;
+    // Klasyczne 9x9 (bloki 3x3) liczone backendem bitboardowym; false = zawsze DLX.
+    bool use_bitboard9 = true;
+    mutable Bitboard9Solver bb9_;
+
+    bool bitboard9_for(const GenericTopology& topo) const {
+        return use_bitboard9 && Bitboard9Solver::applicable(topo);
+    }
 
     static int row_id_for(int n, int r, int c, int d0) {
         return ((r * n + c) * n) + d0;
@@ -145,6 +197,9 @@ struct GenericUniquenessCounter {
         w.undo_col_old.reserve(static_cast<size_t>(w.col_words) * 16ULL);
 
         w.recursion_stack.assign(static_cast<size_t>(w.max_depth) * static_cast<size_t>(w.row_words), 0ULL);
+        w.frame_active_marker.assign(static_cast<size_t>(w.max_depth), 0);
+        w.frame_col_marker.assign(static_cast<size_t>(w.max_depth), 0);
+        w.frame_word.assign(static_cast<size_t>(w.max_depth), 0);
         w.solution_rows.assign(static_cast<size_t>(w.max_depth), -1);
         w.solution_depth = 0;
 
@@ -258,10 +313,12 @@ struct GenericUniquenessCounter {
         ws_.undo_col_old.clear();
         ws_.solution_depth = 0;
         std::fill(ws_.solution_rows.begin(), ws_.solution_rows.end(), -1);
+        ws_.search_resumable = false;
+        ws_.propagate_singles = false;
     }
 
     // Aplikuje z góry założony wzorzec z pattern_forcing do DLXa
-    bool restrict_rows_by_allowed_masks(const GenericTopology& topo, const std::vector<uint64_t>& allowed_masks) const {
+    bool restrict_rows_by_allowed_masks(const GenericTopology& topo, std::span<const uint64_t> allowed_masks) const {
         if (static_cast<int>(allowed_masks.size()) != topo.nn) {
             return false;
         }
@@ -288,22 +345,9 @@ struct GenericUniquenessCounter {
         return true;
     }
 
-    bool search_find_one(SearchAbortControl* budget, int depth) const {
-        if (budget != nullptr && !budget->step()) return false;
-
-        bool has_uncovered = false;
-        for (int cw = 0; cw < ws_.col_words; ++cw) {
-            if (ws_.uncovered_cols[static_cast<size_t>(cw)] != 0ULL) {
-                has_uncovered = true;
-                break;
-            }
-        }
-        if (!has_uncovered) {
-            ws_.solution_depth = depth;
-            return true;
-        }
-        if (depth < 0 || depth >= ws_.max_depth) return false;
-
+    // Wybór kolumny MRV dla węzła na głębokości `depth`; kandydaci trafiają do ramki.
+    // Zwraca liczność wybranej kolumny, 0 dla węzła martwego (kolumna bez wierszy).
+    int expand_frame(int depth) const {
         const size_t best_base = static_cast<size_t>(depth) * static_cast<size_t>(ws_.row_words);
         uint64_t* const local_best = &ws_.recursion_stack[best_base];
         int best_col = -1;
@@ -317,7 +361,7 @@ struct GenericUniquenessCounter {
                 const int col = (cw << 6) + bit;
                 col_word = config::bit_clear_lsb_u64(col_word);
                 if (col >= ws_.cols) continue;
-                
+
                 const uint64_t* const col_rows =
                     &ws_.col_rows_bits[static_cast<size_t>(col) * static_cast<size_t>(ws_.row_words)];
                 int cnt = 0;
@@ -325,9 +369,9 @@ struct GenericUniquenessCounter {
                     const uint64_t v = ws_.active_rows[static_cast<size_t>(w)] & col_rows[static_cast<size_t>(w)];
                     cnt += static_cast<int>(std::popcount(v));
                 }
-                
-                if (cnt == 0) return false;
-                
+
+                if (cnt == 0) return 0;
+
                 if (cnt < best_count) {
                     best_count = cnt;
                     best_col = col;
@@ -340,133 +384,129 @@ struct GenericUniquenessCounter {
             }
             if (best_count == 1) break;
         }
-        
-        if (best_col < 0) return false;
 
-        for (int w = 0; w < ws_.row_words; ++w) {
-            uint64_t rows_word = local_best[static_cast<size_t>(w)];
+        if (best_col < 0) return 0;
+        ws_.frame_word[static_cast<size_t>(depth)] = 0;
+        ws_.frame_active_marker[static_cast<size_t>(depth)] = ws_.undo_active_idx.size();
+        ws_.frame_col_marker[static_cast<size_t>(depth)] = ws_.undo_col_idx.size();
+        return best_count;
+    }
+
+    // Pobiera kolejny wiersz z ramki (bit jest zerowany), -1 gdy ramka wyczerpana.
+    int next_frame_row(int depth) const {
+        uint64_t* const local_best =
+            &ws_.recursion_stack[static_cast<size_t>(depth) * static_cast<size_t>(ws_.row_words)];
+        int& w = ws_.frame_word[static_cast<size_t>(depth)];
+        for (; w < ws_.row_words; ++w) {
+            uint64_t& rows_word = local_best[static_cast<size_t>(w)];
             while (rows_word != 0ULL) {
-                const int rb = config::bit_ctz_u64(rows_word);
-                const int row_id = (w << 6) + rb;
+                const int row_id = (w << 6) + config::bit_ctz_u64(rows_word);
                 rows_word = config::bit_clear_lsb_u64(rows_word);
-                
-                if (row_id >= ws_.rows) continue;
-                
-                const size_t active_marker = ws_.undo_active_idx.size();
-                const size_t col_marker = ws_.undo_col_idx.size();
-                ws_.solution_rows[static_cast<size_t>(depth)] = row_id;
-                
-                if (!apply_row(row_id)) {
-                    rollback_to(active_marker, col_marker);
-                    ws_.solution_rows[static_cast<size_t>(depth)] = -1;
-                    continue;
-                }
-                
-                if (search_find_one(budget, depth + 1)) return true;
-                
-                rollback_to(active_marker, col_marker);
-                ws_.solution_rows[static_cast<size_t>(depth)] = -1;
-                
-                if (budget != nullptr && budget->aborted()) return false;
+                if (row_id < ws_.rows) return row_id;
             }
         }
-        return false;
+        return -1;
     }
 
-    bool search_with_limit(int& out_count, int limit, SearchAbortControl* budget, int depth) const {
-        if (budget != nullptr && !budget->step()) return false;
-
-        bool has_uncovered = false;
-        for (int cw = 0; cw < ws_.col_words; ++cw) {
-            if (ws_.uncovered_cols[static_cast<size_t>(cw)] != 0ULL) {
-                has_uncovered = true;
-                break;
-            }
-        }
-        if (!has_uncovered) {
-            ++out_count;
-            return out_count >= limit; // True przerywa jako "Osiągnięto limit znalezień"
-        }
-
-        if (depth < 0 || depth >= ws_.max_depth) return false;
-
-        const size_t best_base = static_cast<size_t>(depth) * static_cast<size_t>(ws_.row_words);
-        uint64_t* const local_best = &ws_.recursion_stack[best_base];
-
-        int best_col = -1;
-        int best_count = std::numeric_limits<int>::max();
-
-        for (int cw = 0; cw < ws_.col_words; ++cw) {
-            uint64_t col_word = ws_.uncovered_cols[static_cast<size_t>(cw)];
-            while (col_word != 0ULL) {
-                const int bit = config::bit_ctz_u64(col_word);
-                const int col = (cw << 6) + bit;
-                col_word = config::bit_clear_lsb_u64(col_word);
-                if (col >= ws_.cols) continue;
-
-                const uint64_t* const col_rows =
-                    &ws_.col_rows_bits[static_cast<size_t>(col) * static_cast<size_t>(ws_.row_words)];
-                int cnt = 0;
-                for (int w = 0; w < ws_.row_words; ++w) {
-                    const uint64_t v = ws_.active_rows[static_cast<size_t>(w)] & col_rows[static_cast<size_t>(w)];
-                    cnt += static_cast<int>(std::popcount(v));
+    // Iteracyjny DFS z jawnym stosem ramek. Kolejność węzłów i liczenie budget->step()
+    // odpowiadają dawnej wersji rekurencyjnej. Przy wyczerpaniu budżetu stan (zastosowane
+    // wiersze, ramki, licznik rozwiązań) zostaje w ws_ i resume_search() kontynuuje od frontu.
+    DlxSearchStatus run_search(SearchAbortControl* budget) const {
+        int depth = ws_.search_depth;
+        bool entering = ws_.search_entering;
+        ws_.search_resumable = false;
+
+        while (true) {
+            if (entering) {
+                if (budget != nullptr && !budget->step()) {
+                    ws_.search_depth = depth;
+                    ws_.search_entering = true;
+                    ws_.search_resumable = true;
+                    return DlxSearchStatus::Suspended;
                 }
 
-                if (cnt == 0) return false;
+                bool expanded = false;
+                while (true) {
+                    bool has_uncovered = false;
+                    for (int cw = 0; cw < ws_.col_words; ++cw) {
+                        if (ws_.uncovered_cols[static_cast<size_t>(cw)] != 0ULL) {
+                            has_uncovered = true;
+                            break;
+                        }
+                    }
 
-                if (cnt < best_count) {
-                    best_count = cnt;
-                    best_col = col;
-                    for (int w = 0; w < ws_.row_words; ++w) {
-                        local_best[static_cast<size_t>(w)] =
-                            ws_.active_rows[static_cast<size_t>(w)] & col_rows[static_cast<size_t>(w)];
+                    if (!has_uncovered) {
+                        ws_.solution_depth = depth;
+                        if (++ws_.search_count >= ws_.search_limit) {
+                            // Kursor za liściem: wznowienie szuka kolejnych rozwiązań.
+                            ws_.search_depth = depth - 1;
+                            ws_.search_entering = false;
+                            ws_.search_resumable = depth > 0;
+                            return DlxSearchStatus::LimitReached;
+                        }
+                        break;
                     }
-                    if (cnt == 1) break;
+                    if (depth < 0 || depth >= ws_.max_depth) break;
+
+                    const int best_count = expand_frame(depth);
+                    if (best_count == 0) break;
+                    if (best_count == 1 && ws_.propagate_singles) {
+                        // Wymuszony wiersz trafia do logu cofania tej głębokości; powrót
+                        // do ramki rodzica zdejmuje go razem z wierszem rozgałęzienia.
+                        apply_row(next_frame_row(depth));
+                        continue;
+                    }
+                    expanded = true;
+                    break;
                 }
-            }
-            if (best_count == 1) break;
-        }
-
-        if (best_col < 0) return false;
 
-        for (int w = 0; w < ws_.row_words; ++w) {
-            uint64_t rows_word = local_best[static_cast<size_t>(w)];
-            while (rows_word != 0ULL) {
-                const int rb = config::bit_ctz_u64(rows_word);
-                const int row_id = (w << 6) + rb;
-                rows_word = config::bit_clear_lsb_u64(rows_word);
-                
-                if (row_id >= ws_.rows) continue;
-
-                const size_t active_marker = ws_.undo_active_idx.size();
-                const size_t col_marker = ws_.undo_col_idx.size();
-                
-                if (!apply_row(row_id)) {
-                    rollback_to(active_marker, col_marker);
+                entering = false;
+                if (!expanded) {
+                    // Liść lub węzeł martwy: nic nie zastosowano na tej głębokości.
+                    if (depth == 0) return DlxSearchStatus::Exhausted;
+                    --depth;
                     continue;
                 }
-                
-                if (search_with_limit(out_count, limit, budget, depth + 1)) return true;
-                
-                rollback_to(active_marker, col_marker);
-                if (budget != nullptr && budget->aborted()) return false;
             }
+
+            const size_t active_marker = ws_.frame_active_marker[static_cast<size_t>(depth)];
+            const size_t col_marker = ws_.frame_col_marker[static_cast<size_t>(depth)];
+            rollback_to(active_marker, col_marker);
+            ws_.solution_rows[static_cast<size_t>(depth)] = -1;
+
+            const int row_id = next_frame_row(depth);
+            if (row_id < 0) {
+                if (depth == 0) return DlxSearchStatus::Exhausted;
+                --depth;
+                continue;
+            }
+
+            ws_.solution_rows[static_cast<size_t>(depth)] = row_id;
+            if (!apply_row(row_id)) continue;
+            ++depth;
+            entering = true;
         }
-        return false;
     }
 
-    int count_solutions_limit(
-        std::span<const uint16_t> puzzle,
-        const GenericTopology& topo,
-        int limit,
-        SearchAbortControl* budget = nullptr) const {
-            
-        if (limit <= 0) return 0;
-        if (topo.n <= 0 || topo.n > kUnifiedMaxN) return 0;
-        if (static_cast<int>(puzzle.size()) != topo.nn) return 0;
+    DlxSearchStatus start_search(int limit, SearchAbortControl* budget) const {
+        ws_.search_depth = 0;
+        ws_.search_entering = true;
+        ws_.search_count = 0;
+        ws_.search_limit = limit;
+        return run_search(budget);
+    }
+
+    bool search_find_one(SearchAbortControl* budget) const {
+        return start_search(1, budget) == DlxSearchStatus::LimitReached;
+    }
+
+    // Stan startowy liczenia: wskazówki zastosowane jako wiersze DLX.
+    bool prepare_count(std::span<const uint16_t> puzzle, const GenericTopology& topo) const {
+        if (topo.n <= 0 || topo.n > kUnifiedMaxN) return false;
+        if (static_cast<int>(puzzle.size()) != topo.nn) return false;
 
         build_if_needed(topo);
-        if (!ws_.matches(topo)) return 0;
+        if (!ws_.matches(topo)) return false;
 
         initialize_state();
 
@@ -476,8 +516,8 @@ struct GenericUniquenessCounter {
         for (int idx = 0; idx < topo.nn; ++idx) {
             const int d = static_cast<int>(puzzle_ptr[static_cast<size_t>(idx)]);
             if (d == 0) continue;
-            if (d < 1 || d > topo.n) return 0;
-            
+            if (d < 1 || d > topo.n) return false;
+                        
             const uint32_t rcb = packed_ptr[static_cast<size_t>(idx)];
             const int r = GenericBoard::packed_row(rcb);
             const int c = GenericBoard::packed_col(rcb);
@@ -488,16 +528,73 @@ struct GenericUniquenessCounter {
             
             if (!apply_row(row_id)) {
                 rollback_to(active_marker, col_marker);
-                return 0;
+                return false;
             }
         }
+        return true;
+    }
 
-        int out_count = 0;
-        const bool finished = search_with_limit(out_count, limit, budget, 0);
-        const bool aborted = budget != nullptr && budget->aborted() && !finished;
-        
-        if (aborted) return -1;
-        return out_count;
+    int count_solutions_limit(
+        std::span<const uint16_t> puzzle,
+        const GenericTopology& topo,
+        int limit,
+        SearchAbortControl* budget = nullptr) const {
+        if (limit <= 0) return 0;
+        if (bitboard9_for(topo)) return bb9_.count_solutions_limit(puzzle, std::span<const uint64_t>{}, limit, budget);
+        if (!prepare_count(puzzle, topo)) return 0;
+        if (start_search(limit, budget) == DlxSearchStatus::Suspended) return -1;
+        return ws_.search_count;
+    }
+
+    // Liczenie z zasiewem masek kandydatów (np. stan po logic.certify) i propagacją
+    // singli w każdym węźle. Maski muszą być poprawnymi nadzbiorami wszystkich rozwiązań
+    // (eliminacje zakładające unikalność, np. UR/BUG, wykluczone) - wtedy wynik jest
+    // równy count_solutions_limit, a liczba węzłów drastycznie mniejsza na 16x16+.
+    int count_solutions_limit_masked(
+        std::span<const uint16_t> puzzle,
+        const GenericTopology& topo,
+        std::span<const uint64_t> allowed_masks,
+        int limit,
+        SearchAbortControl* budget = nullptr) const {
+        if (limit <= 0) return 0;
+        if (bitboard9_for(topo)) return bb9_.count_solutions_limit(puzzle, allowed_masks, limit, budget);
+        if (!prepare_count(puzzle, topo)) return 0;
+        if (!restrict_rows_by_allowed_masks(topo, allowed_masks)) return 0;
+        ws_.propagate_singles = true;
+        if (start_search(limit, budget) == DlxSearchStatus::Suspended) return -1;
+        return ws_.search_count;
+    }
+
+    // Liczenie z podziałem czasu: po Suspended kolejne resume_count_solutions() z nowym
+    // budżetem kontynuuje od zachowanego frontu zamiast zaczynać od zera. Kursor żyje
+    // w tym liczniku - każde inne wywołanie (count/solve) go unieważnia. Zawsze DLX,
+    // także dla 9x9 (backend bitboardowy nie jest wznawialny).
+    DlxSearchStatus begin_count_solutions(
+        std::span<const uint16_t> puzzle,
+        const GenericTopology& topo,
+        int limit,
+        int& out_count,
+        SearchAbortControl* budget = nullptr) const {
+        out_count = 0;
+        if (limit <= 0 || !prepare_count(puzzle, topo)) return DlxSearchStatus::Exhausted;
+        const DlxSearchStatus status = start_search(limit, budget);
+        out_count = ws_.search_count;
+        return status;
+    }
+
+    DlxSearchStatus resume_count_solutions(int limit, int& out_count, SearchAbortControl* budget = nullptr) const {
+        if (!ws_.search_resumable) {
+            out_count = ws_.search_count;
+            return DlxSearchStatus::Exhausted;
+        }
+        ws_.search_limit = limit;
+        const DlxSearchStatus status = run_search(budget);
+        out_count = ws_.search_count;
+        return status;
+    }
+
+    bool has_resumable_search() const {
+        return ws_.search_resumable;
     }
 
     int count_solutions_limit(
@@ -533,6 +630,21 @@ struct GenericUniquenessCounter {
         if (topo.n <= 0 || topo.n > kUnifiedMaxN) return false;
         if (static_cast<int>(puzzle.size()) != topo.nn) return false;
 
+        if (bitboard9_for(topo)) {
+            std::span<const uint64_t> masks{};
+            if (allowed_masks != nullptr) {
+                if (static_cast<int>(allowed_masks->size()) != topo.nn) return false;
+                for (int idx = 0; idx < topo.nn; ++idx) {
+                    const int d = static_cast<int>(puzzle[static_cast<size_t>(idx)]);
+                    if (d > 0 && ((*allowed_masks)[static_cast<size_t>(idx)] & (1ULL << (d - 1))) == 0ULL) return false;
+                    if (d == 0 && ((*allowed_masks)[static_cast<size_t>(idx)] & 0x1FFULL) == 0ULL) return false;
+                }
+                masks = std::span<const uint64_t>(allowed_masks->data(), allowed_masks->size());
+            }
+            if (!bb9_.solve(puzzle, masks, out_solution, budget)) return false;
+            return budget == nullptr || !budget->aborted();
+        }
+
         build_if_needed(topo);
         if (!ws_.matches(topo)) return false;
 
@@ -564,7 +676,7 @@ struct GenericUniquenessCounter {
             }
         }
 
-        const bool found = search_find_one(budget, 0);
+        const bool found = search_find_one(budget);
         if (!found) return false;
         if (budget != nullptr && budget->aborted()) return false;
 
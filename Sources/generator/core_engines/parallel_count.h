@@ -0,0 +1,300 @@
+// ============================================================================
+// SUDOKU HPC - CORE ENGINES
+// Moduł: parallel_count.h
+// Opis: Równoległe liczenie rozwiązań jednej dużej łamigłówki (49x49, 64x64).
+//       Drzewo dzielone na płytkich poziomach (gałęzie MRV komórki o najmniejszej
+//       liczbie kandydatów) na podproblemy, rozdzielane dynamicznie po wątkach
+//       PersistentThreadPool ze wspólnego kursora. Wspólny licznik rozwiązań
+//       zatrzymuje wszystkie wątki po osiągnięciu limitu.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "../../core/geometry.h"
+#include "../concurrency/cpu_topology.h"
+#include "../concurrency/persistent_thread_pool.h"
+#include "dlx_solver.h"
+
+namespace sudoku_hpc::core_engines {
+
+struct ParallelCountConfig {
+    int threads = 1;  // szerokość (1 = zawsze sekwencyjnie)
+    int min_n = 49;   // od jakiego rozmiaru planszy opłaca się dzielić drzewo
+};
+
+// Workery generatora, które zakończyły pętlę prób (koniec runu); ich rdzenie
+// są wolne. Licznik prowadzi runner (runtime_runner.h).
+inline std::atomic<int>& idle_generator_workers() {
+    static std::atomic<int> idle{0};
+    return idle;
+}
+
+// Szerokość automatyczna: wątek liczący + wolne workery, najwyżej tyle, ile CPU
+// ma proces. Dopóki wszystkie workery pracują, liczenie zostaje sekwencyjne,
+// więc pula nie dokłada wątków na zajęte rdzenie.
+inline int auto_parallel_count_width() {
+    const int idle = idle_generator_workers().load(std::memory_order_relaxed);
+    return std::clamp(1 + idle, 1, concurrency::default_worker_count());
+}
+
+class ParallelSolutionCounter {
+public:
+    static constexpr int kMaxSplitDepth = 4;
+    static constexpr int kTasksPerThread = 8;
+
+    static bool applicable(const GenericTopology& topo, const ParallelCountConfig& pc) {
+        return pc.threads > 1 && topo.n >= pc.min_n;
+    }
+
+    // Zwraca min(liczba rozwiązań, limit) lub -1 po przerwaniu budżetem (jak
+    // GenericUniquenessCounter). `allowed_masks` puste = bez zasiewu masek. Gdy
+    // geometria jest za mała albo pula jest zajęta przez inny wątek, liczy
+    // sekwencyjnie przez `serial`. Limit węzłów budżetu jest egzekwowany per wątek
+    // (łączne zużycie może go przekroczyć najwyżej o szerokość), węzły wszystkich
+    // wątków są doliczane do budżetu wywołującego.
+    int count_solutions_limit(
+        const GenericUniquenessCounter& serial,
+        std::span<const uint16_t> puzzle,
+        const GenericTopology& topo,
+        std::span<const uint64_t> allowed_masks,
+        int limit,
+        SearchAbortControl* budget,
+        const ParallelCountConfig& pc) const {
+        auto count_serial = [&]() {
+            return allowed_masks.empty()
+                ? serial.count_solutions_limit(puzzle, topo, limit, budget)
+                : serial.count_solutions_limit_masked(puzzle, topo, allowed_masks, limit, budget);
+        };
+        if (limit <= 0) return 0;
+        if (!applicable(topo, pc) || static_cast<int>(puzzle.size()) != topo.nn) return count_serial();
+        if (!allowed_masks.empty() && static_cast<int>(allowed_masks.size()) != topo.nn) return 0;
+        if (!split(puzzle, topo, allowed_masks, pc.threads * kTasksPerThread)) return 0;
+        if (tasks_.empty()) return 0;
+
+        Shared shared;
+        shared.limit = limit;
+        const std::function<void(int)> job = [&](int) {
+            run_worker(shared, puzzle, topo, allowed_masks, budget);
+        };
+        if (!concurrency::PersistentThreadPool::instance().try_run(pc.threads, job)) {
+            return count_serial();
+        }
+
+        if (budget != nullptr) budget->nodes += shared.nodes.load(std::memory_order_relaxed);
+        const int total = shared.total.load(std::memory_order_relaxed);
+        if (total >= limit) return limit;
+        const uint32_t abort_bits = shared.abort_bits.load(std::memory_order_relaxed);
+        if (abort_bits != 0U) {
+            if (budget != nullptr) {
+                budget->aborted_by_time |= (abort_bits & kAbortTime) != 0U;
+                budget->aborted_by_nodes |= (abort_bits & kAbortNodes) != 0U;
+                budget->aborted_by_cancel |= (abort_bits & kAbortCancel) != 0U;
+                budget->aborted_by_pause |= (abort_bits & kAbortPause) != 0U;
+                budget->aborted_by_force |= (abort_bits & kAbortForce) != 0U;
+            }
+            return -1;
+        }
+        return total;
+    }
+
+private:
+    static constexpr uint32_t kAbortTime = 1U << 0;
+    static constexpr uint32_t kAbortNodes = 1U << 1;
+    static constexpr uint32_t kAbortCancel = 1U << 2;
+    static constexpr uint32_t kAbortPause = 1U << 3;
+    static constexpr uint32_t kAbortForce = 1U << 4;
+
+    // Podproblem = łamigłówka bazowa + do kMaxSplitDepth dodatkowych wpisów.
+    struct SplitTask {
+        int depth = 0;
+        std::array<int, kMaxSplitDepth> cell{};
+        std::array<uint16_t, kMaxSplitDepth> digit{};
+    };
+
+    struct Shared {
+        int limit = 0;
+        alignas(64) std::atomic<int> next{0};
+        alignas(64) std::atomic<int> total{0};
+        alignas(64) std::atomic<bool> stop{false};
+        std::atomic<uint32_t> abort_bits{0};
+        std::atomic<uint64_t> nodes{0};
+    };
+
+    mutable std::vector<SplitTask> tasks_;
+    mutable std::vector<SplitTask> next_tasks_;
+    mutable std::vector<uint64_t> row_used_;
+    mutable std::vector<uint64_t> col_used_;
+    mutable std::vector<uint64_t> box_used_;
+    mutable std::vector<uint8_t> filled_;
+
+    // Wybiera pustą komórkę MRV dla podproblemu. -1 = brak pustych (liść),
+    // -2 = komórka bez kandydatów (podproblem bez rozwiązań).
+    int choose_split_cell(
+        std::span<const uint16_t> puzzle,
+        const GenericTopology& topo,
+        std::span<const uint64_t> allowed_masks,
+        const SplitTask& t,
+        uint64_t& out_cands) const {
+        const uint64_t full = (topo.n >= 64) ? ~0ULL : ((1ULL << topo.n) - 1ULL);
+        std::fill(row_used_.begin(), row_used_.end(), 0ULL);
+        std::fill(col_used_.begin(), col_used_.end(), 0ULL);
+        std::fill(box_used_.begin(), box_used_.end(), 0ULL);
+        std::fill(filled_.begin(), filled_.end(), uint8_t{0});
+        auto mark = [&](int idx, int d) {
+            const uint64_t bit = 1ULL << (d - 1);
+            row_used_[static_cast<size_t>(topo.cell_row[static_cast<size_t>(idx)])] |= bit;
+            col_used_[static_cast<size_t>(topo.cell_col[static_cast<size_t>(idx)])] |= bit;
+            box_used_[static_cast<size_t>(topo.cell_box[static_cast<size_t>(idx)])] |= bit;
+            filled_[static_cast<size_t>(idx)] = 1;
+        };
+        for (int idx = 0; idx < topo.nn; ++idx) {
+            const int d = static_cast<int>(puzzle[static_cast<size_t>(idx)]);
+            if (d > 0) mark(idx, d);
+        }
+        for (int k = 0; k < t.depth; ++k) {
+            mark(t.cell[static_cast<size_t>(k)], static_cast<int>(t.digit[static_cast<size_t>(k)]));
+        }
+
+        int best = -1;
+        int best_count = 65;
+        for (int idx = 0; idx < topo.nn; ++idx) {
+            if (filled_[static_cast<size_t>(idx)] != 0) continue;
+            uint64_t cands = full &
+                ~(row_used_[static_cast<size_t>(topo.cell_row[static_cast<size_t>(idx)])] |
+                  col_used_[static_cast<size_t>(topo.cell_col[static_cast<size_t>(idx)])] |
+                  box_used_[static_cast<size_t>(topo.cell_box[static_cast<size_t>(idx)])]);
+            if (!allowed_masks.empty()) cands &= allowed_masks[static_cast<size_t>(idx)];
+            const int count = std::popcount(cands);
+            if (count == 0) return -2;
+            if (count < best_count) {
+                best = idx;
+                best_count = count;
+                out_cands = cands;
+                if (count == 1) break;
+            }
+        }
+        return best;
+    }
+
+    // Rozwija podproblemy wszerz, aż będzie ich co najmniej `target` albo
+    // osiągnięta zostanie maksymalna głębokość. Jedynki są dopinane bez
+    // zwiększania liczby zadań (też zajmują poziom).
+    bool split(
+        std::span<const uint16_t> puzzle,
+        const GenericTopology& topo,
+        std::span<const uint64_t> allowed_masks,
+        int target) const {
+        row_used_.assign(static_cast<size_t>(topo.n), 0ULL);
+        col_used_.assign(static_cast<size_t>(topo.n), 0ULL);
+        box_used_.assign(static_cast<size_t>(topo.n), 0ULL);
+        filled_.assign(static_cast<size_t>(topo.nn), uint8_t{0});
+        for (int idx = 0; idx < topo.nn; ++idx) {
+            if (static_cast<int>(puzzle[static_cast<size_t>(idx)]) > topo.n) return false;
+        }
+        tasks_.clear();
+        tasks_.push_back(SplitTask{});
+
+        for (int depth = 0; depth < kMaxSplitDepth && static_cast<int>(tasks_.size()) < target; ++depth) {
+            next_tasks_.clear();
+            for (const SplitTask& t : tasks_) {
+                uint64_t cands = 0ULL;
+                const int cell = choose_split_cell(puzzle, topo, allowed_masks, t, cands);
+                if (cell == -2) continue;
+                if (cell < 0) {
+                    next_tasks_.push_back(t);
+                    continue;
+                }
+                while (cands != 0ULL) {
+                    SplitTask child = t;
+                    child.cell[static_cast<size_t>(child.depth)] = cell;
+                    child.digit[static_cast<size_t>(child.depth)] = static_cast<uint16_t>(std::countr_zero(cands) + 1);
+                    ++child.depth;
+                    next_tasks_.push_back(child);
+                    cands &= cands - 1ULL;
+                }
+            }
+            tasks_.swap(next_tasks_);
+            if (tasks_.empty()) break;
+        }
+        return true;
+    }
+
+    void run_worker(
+        Shared& shared,
+        std::span<const uint16_t> puzzle,
+        const GenericTopology& topo,
+        std::span<const uint64_t> allowed_masks,
+        const SearchAbortControl* budget) const {
+        thread_local GenericUniquenessCounter local;
+        thread_local std::vector<uint16_t> sub;
+        sub.assign(puzzle.begin(), puzzle.end());
+
+        SearchAbortControl b{};
+        if (budget != nullptr) {
+            b.time_enabled = budget->time_enabled;
+            b.deadline = budget->deadline;
+            b.node_enabled = budget->node_enabled;
+            b.node_limit = budget->node_limit;
+            b.nodes = budget->nodes;
+            b.force_abort_ptr = budget->force_abort_ptr;
+            b.cancel_ptr = budget->cancel_ptr;
+            b.pause_ptr = budget->pause_ptr;
+        }
+        b.group_stop_ptr = &shared.stop;
+        const uint64_t nodes0 = b.nodes;
+
+        const int task_count = static_cast<int>(tasks_.size());
+        while (!shared.stop.load(std::memory_order_relaxed)) {
+            const int i = shared.next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= task_count) break;
+            const SplitTask& t = tasks_[static_cast<size_t>(i)];
+            for (int k = 0; k < t.depth; ++k) {
+                sub[static_cast<size_t>(t.cell[static_cast<size_t>(k)])] = t.digit[static_cast<size_t>(k)];
+            }
+
+            const int remaining = shared.limit - shared.total.load(std::memory_order_relaxed);
+            int c = 0;
+            if (remaining > 0) {
+                c = allowed_masks.empty()
+                    ? local.count_solutions_limit(std::span<const uint16_t>(sub.data(), sub.size()), topo, remaining, &b)
+                    : local.count_solutions_limit_masked(
+                          std::span<const uint16_t>(sub.data(), sub.size()), topo, allowed_masks, remaining, &b);
+            }
+
+            for (int k = 0; k < t.depth; ++k) {
+                sub[static_cast<size_t>(t.cell[static_cast<size_t>(k)])] = 0;
+            }
+
+            if (c < 0) {
+                if (!b.stopped_by_group) {
+                    uint32_t bits = 0U;
+                    if (b.aborted_by_time) bits |= kAbortTime;
+                    if (b.aborted_by_nodes) bits |= kAbortNodes;
+                    if (b.aborted_by_cancel) bits |= kAbortCancel;
+                    if (b.aborted_by_pause) bits |= kAbortPause;
+                    if (b.aborted_by_force) bits |= kAbortForce;
+                    shared.abort_bits.fetch_or(bits, std::memory_order_relaxed);
+                    shared.stop.store(true, std::memory_order_relaxed);
+                }
+                break;
+            }
+            if (c > 0 && shared.total.fetch_add(c, std::memory_order_relaxed) + c >= shared.limit) {
+                shared.stop.store(true, std::memory_order_relaxed);
+            }
+        }
+        shared.nodes.fetch_add(b.nodes - nodes0, std::memory_order_relaxed);
+    }
+};
+
+} // namespace sudoku_hpc::core_engines
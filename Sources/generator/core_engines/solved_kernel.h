@@ -111,27 +111,38 @@ private:
         std::vector<uint64_t> candidates;
         std::vector<uint8_t> candidate_popcnt;
         std::vector<uint64_t> singleton_words;
-        std::vector<int> undo_idx;
-        std::vector<uint64_t> undo_old;
-        std::vector<uint8_t> undo_old_count;
+        // Trail zmian o stałej pojemności: na ścieżce każda komórka wchodzi raz jako
+        // wstawiana i najwyżej raz na każde wstawienie rówieśnika, więc
+        // nn * (1 + max_peers) wpisów wystarcza bez realokacji. Licznik kandydatów
+        // przy cofaniu liczony z maski (popcount).
+        std::vector<int> trail_idx;
+        std::vector<uint64_t> trail_old;
+        size_t trail_top = 0;
+        int last_wiped = -1;
+        // Aktywność konfliktów per komórka: podbijana, gdy komórce zabraknie kandydatów,
+        // połowiona przy restarcie; steruje kolejnością cyfr (order_digits_by_conflict).
+        std::vector<uint32_t> conflict_activity;
 
         void ensure(const GenericTopology& topo) {
             if (prepared_nn != topo.nn) {
                 candidates.resize(static_cast<size_t>(topo.nn));
+                conflict_activity.assign(static_cast<size_t>(topo.nn), 0U);
                 candidate_popcnt.resize(static_cast<size_t>(topo.nn));
                 singleton_words.resize((static_cast<size_t>(topo.nn) + 63ULL) >> 6U);
-                const size_t per_depth_hint = static_cast<size_t>(std::max(8, std::min(3 * topo.n, 64)));
-                const size_t reserve_hint = static_cast<size_t>(topo.nn) * per_depth_hint;
-                if (undo_idx.capacity() < reserve_hint) {
-                    undo_idx.reserve(reserve_hint);
-                    undo_old.reserve(reserve_hint);
-                    undo_old_count.reserve(reserve_hint);
+                int max_peers = 0;
+                for (int idx = 0; idx < topo.nn; ++idx) {
+                    max_peers = std::max(
+                        max_peers,
+                        topo.peer_offsets[static_cast<size_t>(idx + 1)] - topo.peer_offsets[static_cast<size_t>(idx)]);
                 }
+                // +1: pętla rówieśników zapisuje wpis także wtedy, gdy nie przesuwa wierzchołka.
+                const size_t capacity = static_cast<size_t>(topo.nn) * static_cast<size_t>(max_peers + 1) + 1;
+                trail_idx.resize(capacity);
+                trail_old.resize(capacity);
                 prepared_nn = topo.nn;
             }
-            undo_idx.clear();
-            undo_old.clear();
-            undo_old_count.clear();
+            trail_top = 0;
+            last_wiped = -1;
         }
     };
 
@@ -159,6 +170,29 @@ private:
         }
     }
 
+    // Limit węzłów jednego przebiegu DFS w polityce restartów (Luby).
+    struct FillRun {
+        uint64_t nodes = 0;
+        uint64_t limit = UINT64_MAX;
+        bool cut = false;
+
+        SUDOKU_HOT_INLINE bool tick() {
+            if (++nodes <= limit) return true;
+            cut = true;
+            return false;
+        }
+    };
+
+    // Ciąg Luby'ego: 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ... (i >= 1).
+    static uint64_t luby(uint64_t i) {
+        while (true) {
+            int k = 1;
+            while (((1ULL << k) - 1ULL) < i) ++k;
+            if (i == (1ULL << k) - 1ULL) return 1ULL << (k - 1);
+            i -= (1ULL << (k - 1)) - 1ULL;
+        }
+    }
+
     struct MvrState {
         int best_bucket = 65;
         int best_idx = -1;
@@ -506,9 +540,8 @@ private:
             const uint8_t cnt = static_cast<uint8_t>(std::popcount(mask));
             cache_set_candidate(cache, idx, mask, cnt);
         }
-        cache.undo_idx.clear();
-        cache.undo_old.clear();
-        cache.undo_old_count.clear();
+        cache.trail_top = 0;
+        cache.last_wiped = -1;
         return true;
     }
 
@@ -562,55 +595,114 @@ private:
         const auto* topo = board.topo;
         const uint64_t placed_bit = 1ULL << (digit - 1);
 
-        out_marker = cache.undo_idx.size();
+        size_t top = cache.trail_top;
+        out_marker = top;
         const size_t idx_u = static_cast<size_t>(idx);
-        cache.undo_idx.push_back(idx);
-        cache.undo_old.push_back(cache.candidates[idx_u]);
-        cache.undo_old_count.push_back(cache.candidate_popcnt[idx_u]);
+        int* const trail_idx = cache.trail_idx.data();
+        uint64_t* const trail_old = cache.trail_old.data();
+        trail_idx[top] = idx;
+        trail_old[top] = cache.candidates[idx_u];
+        ++top;
         cache_set_candidate(cache, idx, 0ULL, 0U);
 
         board.place(idx, digit);
-        const int off0 = topo->peer_offsets[static_cast<size_t>(idx)];
-        const int off1 = topo->peer_offsets[static_cast<size_t>(idx + 1)];
+        // Bez rozgałęzień po rówieśnikach: wpis na trail zawsze, wierzchołek przesuwany
+        // tylko przy zmianie maski. Wyzerowanie rówieśnika nie przerywa pętli - cofnięcie
+        // i tak przywraca wszystkie wpisy.
+        uint64_t* const cand_ptr = cache.candidates.data();
+        uint8_t* const cnt_ptr = cache.candidate_popcnt.data();
+        uint64_t* const singles_ptr = cache.singleton_words.data();
+        const int* const peers = topo->peers_flat.data();
+        const int off0 = topo->peer_offsets[idx_u];
+        const int off1 = topo->peer_offsets[idx_u + 1];
+        int wiped = -1;
         for (int p = off0; p < off1; ++p) {
-            const int peer_idx = topo->peers_flat[static_cast<size_t>(p)];
+            const int peer_idx = peers[p];
             const size_t peer_u = static_cast<size_t>(peer_idx);
-            const uint64_t old_mask = cache.candidates[peer_u];
-            if (old_mask == 0ULL) continue;
-            
+            const uint64_t old_mask = cand_ptr[peer_u];
+            const uint64_t hit = (old_mask & placed_bit) >> (digit - 1);
+            trail_idx[top] = peer_idx;
+            trail_old[top] = old_mask;
+            top += static_cast<size_t>(hit);
+
             const uint64_t new_mask = old_mask & ~placed_bit;
-            if (new_mask == old_mask) continue;
-            
-            cache.undo_idx.push_back(peer_idx);
-            cache.undo_old.push_back(old_mask);
-            cache.undo_old_count.push_back(cache.candidate_popcnt[peer_u]);
-            
-            if (new_mask == 0ULL) {
-                cache_set_candidate(cache, peer_idx, 0ULL, 0U);
-                return false;
-            }
-            const uint8_t new_cnt = static_cast<uint8_t>(std::popcount(new_mask));
-            cache_set_candidate(cache, peer_idx, new_mask, new_cnt);
+            const uint8_t new_cnt = static_cast<uint8_t>(cnt_ptr[peer_u] - hit);
+            cand_ptr[peer_u] = new_mask;
+            cnt_ptr[peer_u] = new_cnt;
+            const uint64_t bit = 1ULL << (peer_u & 63ULL);
+            uint64_t& word = singles_ptr[peer_u >> 6U];
+            word = (word & ~bit) | ((new_cnt == 1U) ? bit : 0ULL);
+            wiped = (hit != 0ULL && new_mask == 0ULL) ? peer_idx : wiped;
         }
-        return true;
+        cache.trail_top = top;
+        cache.last_wiped = wiped;
+        return wiped < 0;
     }
 
     void rollback_place_with_cache(GenericBoard& board, CandidateCache& cache, int idx, int digit, size_t marker) const {
-        while (cache.undo_idx.size() > marker) {
-            const int changed_idx = cache.undo_idx.back();
-            const uint64_t old_mask = cache.undo_old.back();
-            const uint8_t old_count = cache.undo_old_count.back();
-            cache.undo_idx.pop_back();
-            cache.undo_old.pop_back();
-            cache.undo_old_count.pop_back();
-            cache_set_candidate(cache, changed_idx, old_mask, old_count);
+        size_t top = cache.trail_top;
+        while (top > marker) {
+            --top;
+            const uint64_t old_mask = cache.trail_old[top];
+            cache_set_candidate(
+                cache, cache.trail_idx[top], old_mask, static_cast<uint8_t>(std::popcount(old_mask)));
         }
+        cache.trail_top = top;
         board.unplace(idx, digit);
     }
 
-    bool fill_cached(GenericBoard& board, std::mt19937_64& rng, SearchAbortControl* budget, CandidateCache& cache) const {
+    static SUDOKU_HOT_INLINE void note_conflict(CandidateCache& cache) {
+        // Rówieśnik, któremu ostatnie wstawienie zabrało ostatniego kandydata.
+        ++cache.conflict_activity[static_cast<size_t>(cache.last_wiped)];
+    }
+
+    // Stabilnie (po tasowaniu) układa cyfry rosnąco wg sumy aktywności rówieśników,
+    // którym dana cyfra zabrałaby kandydata - najpierw cyfry omijające komórki konfliktowe.
+    static void order_digits_by_conflict(
+        const GenericBoard& board,
+        const CandidateCache& cache,
+        int idx,
+        uint64_t digit_mask,
+        int* digits,
+        int digit_count) {
+        const auto* topo = board.topo;
+        uint64_t weight[64] = {};
+        bool any = false;
+        const int off0 = topo->peer_offsets[static_cast<size_t>(idx)];
+        const int off1 = topo->peer_offsets[static_cast<size_t>(idx + 1)];
+        for (int p = off0; p < off1; ++p) {
+            const size_t peer_u = static_cast<size_t>(topo->peers_flat[static_cast<size_t>(p)]);
+            const uint32_t activity = cache.conflict_activity[peer_u];
+            if (activity == 0U) continue;
+            uint64_t m = cache.candidates[peer_u] & digit_mask;
+            any |= (m != 0ULL);
+            while (m != 0ULL) {
+                weight[std::countr_zero(m)] += activity;
+                m &= (m - 1ULL);
+            }
+        }
+        if (!any) return;
+        for (int i = 1; i < digit_count; ++i) {
+            const int d = digits[i];
+            const uint64_t w = weight[d - 1];
+            int j = i;
+            while (j > 0 && weight[digits[j - 1] - 1] > w) {
+                digits[j] = digits[j - 1];
+                --j;
+            }
+            digits[j] = d;
+        }
+    }
+
+    bool fill_cached(
+        GenericBoard& board,
+        std::mt19937_64& rng,
+        SearchAbortControl* budget,
+        CandidateCache& cache,
+        FillRun& run) const {
         if (budget != nullptr && !budget->step()) return false;
-        
+        if (!run.tick()) return false;
+                
         int best_idx = -1;
         uint64_t best_mask = 0ULL;
         if (!select_best_cell_cached(board, cache, best_idx, best_mask)) return false;
@@ -618,12 +710,15 @@ private:
 
         int digits[64];
         const int digit_count = shuffled_digits_from_mask(best_mask, rng, digits);
+        if (digit_count > 1) order_digits_by_conflict(board, cache, best_idx, best_mask, digits, digit_count);
         
         if (digit_count == 1) {
             size_t marker = 0;
             const int d = digits[0];
             if (try_place_with_cache(board, cache, best_idx, d, marker)) {
-                if (fill_cached(board, rng, budget, cache)) return true;
+                if (fill_cached(board, rng, budget, cache, run)) return true;
+            } else {
+                note_conflict(cache);
             }
             rollback_place_with_cache(board, cache, best_idx, d, marker);
             return false;
@@ -633,17 +728,20 @@ private:
             const int d = digits[i];
             size_t marker = 0;
             if (try_place_with_cache(board, cache, best_idx, d, marker)) {
-                if (fill_cached(board, rng, budget, cache)) return true;
+                if (fill_cached(board, rng, budget, cache, run)) return true;
+            } else {
+                note_conflict(cache);
             }
             rollback_place_with_cache(board, cache, best_idx, d, marker);
-            if (budget != nullptr && budget->aborted()) return false;
+            if (run.cut || (budget != nullptr && budget->aborted())) return false;
         }
         return false;
     }
 
-    bool fill_recompute(GenericBoard& board, std::mt19937_64& rng, SearchAbortControl* budget) const {
+    bool fill_recompute(GenericBoard& board, std::mt19937_64& rng, SearchAbortControl* budget, FillRun& run) const {
         if (budget != nullptr && !budget->step()) return false;
-        
+        if (!run.tick()) return false;
+                
         int best_idx = -1;
         uint64_t best_mask = 0ULL;
         if (!select_best_cell_bucketed(board, best_idx, best_mask)) return false;
@@ -655,7 +753,7 @@ private:
         if (digit_count == 1) {
             const int d = digits[0];
             board.place(best_idx, d);
-            if (fill_recompute(board, rng, budget)) return true;
+            if (fill_recompute(board, rng, budget, run)) return true;
             board.unplace(best_idx, d);
             return false;
         }
@@ -663,24 +761,47 @@ private:
         for (int i = 0; i < digit_count; ++i) {
             const int d = digits[i];
             board.place(best_idx, d);
-            if (fill_recompute(board, rng, budget)) return true;
+            if (fill_recompute(board, rng, budget, run)) return true;
             board.unplace(best_idx, d);
-            if (budget != nullptr && budget->aborted()) return false;
+            if (run.cut || (budget != nullptr && budget->aborted())) return false;
         }
         return false;
     }
 
     bool fill(GenericBoard& board, std::mt19937_64& rng, SearchAbortControl* budget) const {
-        // Cache przyspiesza proces tylko przy wyższych wartościach N
-        static constexpr int kCacheMrvMinN = 25;
-        if (board.topo->n < kCacheMrvMinN) {
-            return fill_recompute(board, rng, budget);
+        // Cache z trailem jest szybszy od przeliczania masek dla każdego N; ścieżka
+        // bucketed (przeliczanie) zostaje dla jawnie wybranego backendu SIMD.
+        // Od 16x16 pojedynczy DFS ma ciężki ogon czasu - restarty wg ciągu Luby'ego
+        // z jednostką kRestartUnitPerCell * nn węzłów. Przerwany przebieg cofa wszystkie
+        // wstawienia, więc kolejny startuje z tej samej planszy i dalszego strumienia rng.
+        static constexpr int kRestartMinN = 16;
+        static constexpr uint64_t kRestartUnitPerCell = 2;
+        const int n = board.topo->n;
+        const bool cached = backend_ == Backend::Scalar;
+        CandidateCache* cache = nullptr;
+        if (cached) {
+            cache = &candidate_cache_for(*board.topo);
+            if (!init_candidate_cache(board, *cache)) {
+                return false;
+            }
+            std::fill(cache->conflict_activity.begin(), cache->conflict_activity.end(), 0U);
         }
-        CandidateCache& cache = candidate_cache_for(*board.topo);
-        if (!init_candidate_cache(board, cache)) {
-            return false;
+        FillRun run{};
+        if (n < kRestartMinN) {
+            return cached ? fill_cached(board, rng, budget, *cache, run) : fill_recompute(board, rng, budget, run);
+        }
+        const uint64_t unit = kRestartUnitPerCell * static_cast<uint64_t>(board.topo->nn);
+        for (uint64_t attempt = 1;; ++attempt) {
+            run.nodes = 0;
+            run.cut = false;
+            run.limit = luby(attempt) * unit;
+            const bool ok = cached ? fill_cached(board, rng, budget, *cache, run) : fill_recompute(board, rng, budget, run);
+            if (ok) return true;
+            if (!run.cut) return false; // budżet albo brak rozwiązania
+            if (cached) {
+                for (uint32_t& a : cache->conflict_activity) a >>= 1U;
+            }
         }
-        return fill_cached(board, rng, budget, cache);
     }
 };
 
@@ -0,0 +1,185 @@
+// ============================================================================
+// SUDOKU HPC - CORE ENGINES
+// Moduł: transform_grid_source.h
+// Opis: Szybkie źródło pełnych plansz dla geometrii prostokątnych (box_rows x
+//       box_cols) bez ograniczeń allowed_masks. Siatki powstają z małej puli
+//       ziaren przez przekształcenia zachowujące poprawność: relabel cyfr,
+//       permutacje wierszy/kolumn w pasach i stosach, permutacje pasów i stosów,
+//       transpozycję (box_rows == box_cols) oraz zamiany cykli dwóch linii
+//       (zbiory nieuniknione). Wynik wraca do puli, więc ziarna dryfują od
+//       wzorca startowego. Koszt O(n^2) na planszę, zero-allocation po starcie.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../core/geometry.h"
+
+namespace sudoku_hpc::core_engines {
+
+class TransformGridSource {
+public:
+    static constexpr int kPoolSize = 4;
+    static constexpr int kMaxN = 64;
+
+    static bool applicable(const GenericTopology& topo) {
+        return topo.box_rows > 0 && topo.box_cols > 0 &&
+               topo.n == topo.box_rows * topo.box_cols &&
+               topo.n <= kMaxN && topo.nn == topo.n * topo.n;
+    }
+
+    // Zwraca false tylko dla geometrii spoza applicable() - poza tym zawsze daje siatkę.
+    bool generate(const GenericTopology& topo, std::mt19937_64& rng, std::vector<uint16_t>& out_solution) {
+        if (!applicable(topo)) return false;
+        if (topo.box_rows != pool_box_rows_ || topo.box_cols != pool_box_cols_) {
+            init_pool(topo, rng);
+        }
+
+        std::vector<uint16_t>& seed = pool_[static_cast<size_t>(rng() % static_cast<uint64_t>(kPoolSize))];
+        if (out_solution.size() != static_cast<size_t>(topo.nn)) {
+            out_solution.resize(static_cast<size_t>(topo.nn));
+        }
+        permute_into(topo, rng, seed, out_solution);
+        for (int s = 0; s < topo.n; ++s) {
+            cycle_swap(topo, rng, out_solution);
+        }
+        // Wynik zastępuje ziarno: kolejne siatki nie są już orbitą jednego wzorca.
+        std::copy(out_solution.begin(), out_solution.end(), seed.begin());
+        return true;
+    }
+
+private:
+    int pool_box_rows_ = 0;
+    int pool_box_cols_ = 0;
+    std::array<std::vector<uint16_t>, kPoolSize> pool_{};
+
+    std::array<int, kMaxN> row_map_{};
+    std::array<int, kMaxN> col_map_{};
+    std::array<int, kMaxN> group_perm_{};
+    std::array<int, kMaxN> inner_perm_{};
+    std::array<uint16_t, kMaxN + 1> relabel_{};
+    std::array<int, kMaxN + 1> pos_in_a_{};
+    std::array<int, kMaxN> cycle_{};
+
+    template <size_t N>
+    static void shuffle_prefix(std::array<int, N>& a, int count, std::mt19937_64& rng) {
+        for (int i = count - 1; i > 0; --i) {
+            const int j = static_cast<int>(rng() % static_cast<uint64_t>(i + 1));
+            std::swap(a[static_cast<size_t>(i)], a[static_cast<size_t>(j)]);
+        }
+    }
+
+    void init_pool(const GenericTopology& topo, std::mt19937_64& rng) {
+        const int n = topo.n;
+        const int br = topo.box_rows;
+        const int bc = topo.box_cols;
+        // Wzorzec bazowy: wiersz (pas p, pozycja q) to przesunięcie o bc*q + p.
+        for (auto& grid : pool_) {
+            grid.assign(static_cast<size_t>(topo.nn), 0);
+            for (int r = 0; r < n; ++r) {
+                const int shift = bc * (r % br) + r / br;
+                for (int c = 0; c < n; ++c) {
+                    grid[static_cast<size_t>(r * n + c)] = static_cast<uint16_t>((shift + c) % n + 1);
+                }
+            }
+            // Rozgrzanie: pierwsze siatki nie powinny zdradzać cyklicznego wzorca.
+            for (int s = 0; s < 4 * n; ++s) {
+                cycle_swap(topo, rng, grid);
+            }
+        }
+        pool_box_rows_ = br;
+        pool_box_cols_ = bc;
+    }
+
+    // map[i] dla linii w grupach po group_size: permutacja grup, potem linii w każdej grupie.
+    void build_line_map(int group_size, int group_count, std::mt19937_64& rng, std::array<int, kMaxN>& map) {
+        for (int g = 0; g < group_count; ++g) group_perm_[static_cast<size_t>(g)] = g;
+        shuffle_prefix(group_perm_, group_count, rng);
+        for (int g = 0; g < group_count; ++g) {
+            for (int i = 0; i < group_size; ++i) inner_perm_[static_cast<size_t>(i)] = i;
+            shuffle_prefix(inner_perm_, group_size, rng);
+            for (int i = 0; i < group_size; ++i) {
+                map[static_cast<size_t>(g * group_size + i)] =
+                    group_perm_[static_cast<size_t>(g)] * group_size + inner_perm_[static_cast<size_t>(i)];
+            }
+        }
+    }
+
+    void permute_into(
+        const GenericTopology& topo,
+        std::mt19937_64& rng,
+        const std::vector<uint16_t>& src,
+        std::vector<uint16_t>& dst) {
+        const int n = topo.n;
+        // Pasy: box_rows wierszy, box_cols pasów; stosy: box_cols kolumn, box_rows stosów.
+        build_line_map(topo.box_rows, topo.box_cols, rng, row_map_);
+        build_line_map(topo.box_cols, topo.box_rows, rng, col_map_);
+
+        for (int d = 1; d <= n; ++d) group_perm_[static_cast<size_t>(d - 1)] = d;
+        shuffle_prefix(group_perm_, n, rng);
+        relabel_[0] = 0;
+        for (int d = 1; d <= n; ++d) {
+            relabel_[static_cast<size_t>(d)] = static_cast<uint16_t>(group_perm_[static_cast<size_t>(d - 1)]);
+        }
+
+        const bool transpose = (topo.box_rows == topo.box_cols) && ((rng() & 1ULL) != 0ULL);
+        for (int r = 0; r < n; ++r) {
+            const int sr = row_map_[static_cast<size_t>(r)];
+            for (int c = 0; c < n; ++c) {
+                const int sc = col_map_[static_cast<size_t>(c)];
+                const int sidx = transpose ? (sc * n + sr) : (sr * n + sc);
+                dst[static_cast<size_t>(r * n + c)] = relabel_[src[static_cast<size_t>(sidx)]];
+            }
+        }
+    }
+
+    // Dwie linie tej samej grupy (wiersze jednego pasa albo kolumny jednego stosu):
+    // cykl pozycji, na których obie linie mają ten sam zbiór cyfr, zamieniamy między
+    // liniami. Wiersze/kolumny i bloki zachowują swoje zbiory cyfr.
+    void cycle_swap(const GenericTopology& topo, std::mt19937_64& rng, std::vector<uint16_t>& grid) {
+        const int n = topo.n;
+        const bool rows = (rng() & 1ULL) != 0ULL;
+        const int group_size = rows ? topo.box_rows : topo.box_cols;
+        if (group_size < 2) return;
+        const int group = static_cast<int>(rng() % static_cast<uint64_t>(n / group_size));
+        const int i1 = static_cast<int>(rng() % static_cast<uint64_t>(group_size));
+        int i2 = static_cast<int>(rng() % static_cast<uint64_t>(group_size - 1));
+        if (i2 >= i1) ++i2;
+        const int line_a = group * group_size + i1;
+        const int line_b = group * group_size + i2;
+        // Indeks komórki: linia = wiersz (krok 1) albo kolumna (krok n).
+        const int base_a = rows ? line_a * n : line_a;
+        const int base_b = rows ? line_b * n : line_b;
+        const int step = rows ? 1 : n;
+
+        for (int p = 0; p < n; ++p) {
+            pos_in_a_[static_cast<size_t>(grid[static_cast<size_t>(base_a + p * step)])] = p;
+        }
+        const int start = static_cast<int>(rng() % static_cast<uint64_t>(n));
+        const uint16_t first = grid[static_cast<size_t>(base_a + start * step)];
+        int len = 0;
+        int p = start;
+        while (true) {
+            cycle_[static_cast<size_t>(len++)] = p;
+            const uint16_t b = grid[static_cast<size_t>(base_b + p * step)];
+            if (b == first) break;
+            p = pos_in_a_[static_cast<size_t>(b)];
+        }
+        // Cykl przez całą linię = zamiana linii, to już robi permute_into.
+        if (len == n) return;
+        for (int k = 0; k < len; ++k) {
+            const int q = cycle_[static_cast<size_t>(k)];
+            std::swap(grid[static_cast<size_t>(base_a + q * step)], grid[static_cast<size_t>(base_b + q * step)]);
+        }
+    }
+};
+
+} // namespace sudoku_hpc::core_engines
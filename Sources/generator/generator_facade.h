@@ -15,6 +15,8 @@
 #include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 // Core & Config
@@ -23,7 +25,9 @@
 
 // Core Engines
 #include "core_engines/dlx_solver.h"
+#include "core_engines/parallel_count.h"
 #include "core_engines/solved_kernel.h"
+#include "core_engines/transform_grid_source.h"
 #include "core_engines/quick_prefilter.h"
 
 // Logic & Strategies (Fasada silnika certyfikacji)
@@ -48,6 +52,9 @@ struct GenericPuzzleCandidate {
     std::vector<uint16_t> puzzle;
     std::vector<uint16_t> solution;
     int clues = 0;
+    // Dowód unikalności z kopania (hash planszy z chwili dowodu) - podróżuje
+    // z kandydatem między etapami, ETAP 6 sprawdza go na bieżącej planszy.
+    post_processing::UniquenessProof uniq_proof{};
 };
 
 // ============================================================================
@@ -55,13 +62,15 @@ struct GenericPuzzleCandidate {
 // Zamiast std::ostringstream i tworzenia wielu mniejszych stringów używamy
 // jednego bufora, a wartości wpisujemy przez systemowy std::to_chars().
 // ============================================================================
-inline std::string serialize_line_generic(
+// Wariant do bufora wielokrotnego użytku (arena wątku): resize w obrębie
+// pojemności nie alokuje.
+inline void serialize_line_generic_into(
+    std::string& out,
     uint64_t seed,
     const GenerateRunConfig& cfg,
     const GenericPuzzleCandidate& candidate,
     int nn) {
     
-    std::string out;
     // Prealokacja maksymalnego bezpiecznego rozmiaru
     out.resize(128 + static_cast<size_t>(nn) * 4); 
     char* ptr = out.data();
@@ -90,6 +99,15 @@ inline std::string serialize_line_generic(
     
     // Ucinamy sznurek do faktycznie wykorzystanego zakresu
     out.resize(ptr - out.data());
+}
+
+inline std::string serialize_line_generic(
+    uint64_t seed,
+    const GenerateRunConfig& cfg,
+    const GenericPuzzleCandidate& candidate,
+    int nn) {
+    std::string out;
+    serialize_line_generic_into(out, seed, cfg, candidate, nn);
     return out;
 }
 
@@ -237,7 +255,179 @@ inline bool evaluate_required_strategy_contract_generic(
 // ============================================================================
 // GŁÓWNA FUNKCJA KONTROLI PIPELINE'U (Wykonywana per każda próba generowania)
 // ============================================================================
-inline bool generate_one_generic(
+// Stan próby przekazywany między etapami: ETAP 1-2 (siatka i kopanie) oraz
+// ETAP 3-7 (filtry, certyfikacja, unikalność). Wykopany kandydat może czekać na
+// dokończenie (attempt_interleaver.h); generate_one_generic robi oba etapy od razu.
+
+// Wynik szablonu wzorca z certyfikacji dla stanu mutacji (thread_local) wątku,
+// który szablon zasadził - w trybie potokowym to inny wątek niż certyfikujący.
+struct PatternTemplateFeedback {
+    bool due = false;
+    RequiredStrategy required_strategy = RequiredStrategy::None;
+    pattern_forcing::PatternKind kind = pattern_forcing::PatternKind::None;
+    bool exact_template = false;
+    int template_score = 0;
+    int required_analyzed = 0;
+    int required_use = 0;
+    int required_hit = 0;
+};
+
+inline void apply_pattern_feedback(const PatternTemplateFeedback& fb) {
+    if (!fb.due) return;
+    pattern_forcing::note_template_attempt_feedback(
+        fb.required_strategy, fb.kind, fb.exact_template, fb.template_score,
+        fb.required_analyzed, fb.required_use, fb.required_hit);
+}
+
+struct GenericAttemptStageState {
+    mcts_digger::GenericMctsBottleneckDigger::RunStats mcts_stats{};
+    SearchAbortControl budget{};
+    bool budget_enabled = false;
+    int dig_anchor_count = 0;
+    int dig_protected_count = 0;
+    bool dig_exact_template = false;
+    int dig_template_score = 0;
+    int dig_best_template_score = 0;
+    int dig_template_score_delta = 0;
+    int dig_mutation_strength = 0;
+    int dig_planner_zero_use_streak = 0;
+    int dig_planner_failure_streak = 0;
+    int dig_adaptive_target_strength = 0;
+    bool dig_family_fallback_used = false;
+    bool dig_exact_contract_met = false;
+    pattern_forcing::PatternKind dig_pattern_kind = pattern_forcing::PatternKind::None;
+    PatternGeneratorPolicy dig_generator_policy = PatternGeneratorPolicy::Unsupported;
+    pattern_forcing::PatternMutationSource dig_mutation_source = pattern_forcing::PatternMutationSource::Random;
+    // Ustawiane przez ETAP 3-7; stosuje wątek kopiący (apply_pattern_feedback).
+    PatternTemplateFeedback pattern_feedback{};
+
+    // Czas oczekiwania odłożonej próby nie zjada jej budżetu czasu.
+    void shift_deadline(std::chrono::steady_clock::duration parked) {
+        if (!budget.time_enabled) return;
+        budget.deadline += parked;
+        if (budget.deadline_tick_ns != 0) {
+            budget.deadline_tick_ns += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(parked).count());
+        }
+    }
+};
+
+// Diagnostyka etapów (fast_test / wymagana strategia) wspólna dla obu etapów próby.
+namespace attempt_trace {
+
+inline bool enabled(const GenerateRunConfig& cfg) {
+    return cfg.fast_test_mode || cfg.required_strategy != RequiredStrategy::None;
+}
+
+inline void stage_begin(const GenerateRunConfig& cfg, const char* stage) {
+    if (!enabled(cfg)) {
+        return;
+    }
+    log_info(
+        "generator.stage",
+        "stage=" + std::string(stage) +
+        " phase=begin geom=" + std::to_string(cfg.box_rows) + "x" + std::to_string(cfg.box_cols) +
+        " difficulty=" + std::to_string(cfg.difficulty_level_required) +
+        " required=" + std::string(to_string(cfg.required_strategy)) +
+        " fast_test=" + std::string(cfg.fast_test_mode ? "1" : "0"));
+}
+
+inline void stage_end(
+    const GenerateRunConfig& cfg, const char* stage, bool ok, const SearchAbortControl* stage_budget, std::string_view extra = {}) {
+    if (!enabled(cfg)) {
+        return;
+    }
+    std::string msg =
+        "stage=" + std::string(stage) +
+        " phase=end ok=" + std::string(ok ? "1" : "0");
+    if (stage_budget != nullptr) {
+        msg +=
+            " aborted=" + std::string(stage_budget->aborted() ? "1" : "0") +
+            " by_time=" + std::string(stage_budget->aborted_by_time ? "1" : "0") +
+            " by_nodes=" + std::string(stage_budget->aborted_by_nodes ? "1" : "0") +
+            " by_pause=" + std::string(stage_budget->aborted_by_pause ? "1" : "0") +
+            " nodes=" + std::to_string(stage_budget->nodes);
+    }
+    if (!extra.empty()) {
+        msg += ' ';
+        msg += extra;
+    }
+    log_info("generator.stage", msg);
+}
+
+inline void pattern_contract(
+    const GenerateRunConfig& cfg, const GenericAttemptStageState& st, const char* phase, std::string_view extra = {}) {
+    if (!enabled(cfg)) {
+        return;
+    }
+    std::string msg =
+        "phase=" + std::string(phase) +
+        " required=" + std::string(to_string(cfg.required_strategy)) +
+        " kind=" + std::string(pattern_forcing::pattern_kind_label(st.dig_pattern_kind)) +
+        " policy=" + std::string(to_string(st.dig_generator_policy)) +
+        " exact=" + std::string(st.dig_exact_template ? "1" : "0") +
+        " family_fallback=" + std::string(st.dig_family_fallback_used ? "1" : "0") +
+        " exact_contract=" + std::string(st.dig_exact_contract_met ? "1" : "0") +
+        " anchors=" + std::to_string(st.dig_anchor_count) +
+        " protected=" + std::to_string(st.dig_protected_count) +
+        " score=" + std::to_string(st.dig_template_score) +
+        " best_score=" + std::to_string(st.dig_best_template_score) +
+        " score_delta=" + std::to_string(st.dig_template_score_delta) +
+        " mutation=" + std::string(pattern_forcing::pattern_mutation_source_label(st.dig_mutation_source)) +
+        " mutation_strength=" + std::to_string(st.dig_mutation_strength) +
+        " planner_zero_use=" + std::to_string(st.dig_planner_zero_use_streak) +
+        " planner_fail=" + std::to_string(st.dig_planner_failure_streak) +
+        " adaptive_target=" + std::to_string(st.dig_adaptive_target_strength);
+    if (!extra.empty()) {
+        msg += ' ';
+        msg += extra;
+    }
+    log_info("pattern.contract", msg);
+}
+
+inline void strategy_contract(
+    const GenerateRunConfig& cfg,
+    const GenericAttemptStageState& st,
+    const char* phase,
+    RejectReason reject_reason,
+    const logic::GenericLogicCertifyResult* logic_result = nullptr) {
+    if (!enabled(cfg) || cfg.required_strategy == RequiredStrategy::None) {
+        return;
+    }
+    size_t required_slot = 0;
+    std::ostringstream oss;
+    oss << "phase=" << phase
+        << " required=" << to_string(cfg.required_strategy)
+        << " reject=" << static_cast<int>(reject_reason)
+        << " reqA/U/H=" << st.mcts_stats.required_strategy_analyzed
+        << "/" << st.mcts_stats.required_strategy_uses
+        << "/" << st.mcts_stats.required_strategy_hits;
+    if (logic::GenericLogicCertify::slot_from_required_strategy(cfg.required_strategy, required_slot)) {
+        const auto& meta = logic::GenericLogicCertify::strategy_meta_for_slot(required_slot);
+        oss << " slot=" << required_slot
+            << " slot_id=" << meta.id
+            << " coverage=" << to_string(meta.coverage_grade)
+            << " generator_policy=" << to_string(meta.generator_policy)
+            << " zero_alloc=" << to_string(meta.zero_alloc_grade)
+            << " audit_decision=" << to_string(meta.audit_decision);
+        if (logic_result != nullptr) {
+            const auto& stats = logic_result->strategy_stats[required_slot];
+            oss << " logic_use/hit=" << stats.use_count
+                << "/" << stats.hit_count
+                << " solved=" << (logic_result->solved ? 1 : 0)
+                << " timed_out=" << (logic_result->timed_out ? 1 : 0)
+                << " budget_aborts=" << stats.budget_aborts
+                << " steps=" << logic_result->steps;
+        }
+    }
+    log_info("strategy.contract", oss.str());
+}
+
+} // namespace attempt_trace
+
+// ETAP 1-2: siatka rozwiązania (wzorzec albo fallback) i kopanie MCTS. true =
+// kandydat wykopany, stan w st; false = odrzucenie (reason) albo pauza (None).
+inline bool generate_dig_stage_generic(
     const GenerateRunConfig& cfg,
     const GenericTopology& topo,
     std::mt19937_64& rng,
@@ -245,163 +435,32 @@ inline bool generate_one_generic(
     RejectReason& reason,
     RequiredStrategyAttemptInfo& strategy_info,
     const core_engines::GenericSolvedKernel& solved,
-    const core_engines::GenericQuickPrefilter& prefilter,
     const logic::GenericLogicCertify& logic,
     const core_engines::GenericUniquenessCounter& uniq,
+    GenericAttemptStageState& st,
     const std::atomic<bool>* force_abort_ptr = nullptr,
     bool* timed_out = nullptr,
     const std::atomic<bool>* external_cancel_ptr = nullptr,
     const std::atomic<bool>* external_pause_ptr = nullptr,
-    post_processing::QualityContract* quality_contract_out = nullptr,
-    post_processing::QualityMetrics* quality_metrics_out = nullptr,
-    post_processing::ReplayValidationResult* replay_out = nullptr,
     AttemptPerfStats* perf_out = nullptr) {
-    
+
     const bool has_timed_out_ptr = (timed_out != nullptr);
-    const bool has_quality_contract_out = (quality_contract_out != nullptr);
-    const bool has_quality_metrics_out = (quality_metrics_out != nullptr);
-    const bool has_replay_out = (replay_out != nullptr);
     const bool collect_perf = (perf_out != nullptr);
-    
+
     if (has_timed_out_ptr) *timed_out = false;
     strategy_info = {};
-    if (has_quality_contract_out) *quality_contract_out = {};
-    if (has_quality_metrics_out) *quality_metrics_out = {};
-    if (has_replay_out) *replay_out = {};
     if (collect_perf) *perf_out = {};
-    
-    const bool quality_contract_enabled = cfg.enable_quality_contract;
-    const bool distribution_filter_enabled = quality_contract_enabled && cfg.enable_distribution_filter;
-    const bool replay_validation_enabled = quality_contract_enabled && cfg.enable_replay_validation;
-    const bool need_quality_metrics = quality_contract_enabled || quality_contract_out != nullptr || quality_metrics_out != nullptr;
+    st = {};
+
     const bool budget_enabled = cfg.attempt_time_budget_s > 0.0 || cfg.attempt_node_budget > 0 || force_abort_ptr != nullptr;
-    const bool trace_stage_diag = cfg.fast_test_mode || cfg.required_strategy != RequiredStrategy::None;
-    mcts_digger::GenericMctsBottleneckDigger::RunStats mcts_stats{};
+    const bool trace = attempt_trace::enabled(cfg);
+    st.budget_enabled = budget_enabled;
     const uint8_t* dig_protected_cells = nullptr;
     const uint64_t* dig_allowed_masks = nullptr;
     const int* dig_anchor_idx = nullptr;
     const uint64_t* dig_anchor_masks = nullptr;
-    int dig_anchor_count = 0;
-    bool dig_exact_template = false;
-    int dig_template_score = 0;
-    int dig_best_template_score = 0;
-    int dig_template_score_delta = 0;
-    int dig_mutation_strength = 0;
-    int dig_planner_zero_use_streak = 0;
-    int dig_planner_failure_streak = 0;
-    int dig_adaptive_target_strength = 0;
-    bool dig_family_fallback_used = false;
-    bool dig_exact_contract_met = false;
-    pattern_forcing::PatternKind dig_pattern_kind = pattern_forcing::PatternKind::None;
-    PatternGeneratorPolicy dig_generator_policy = PatternGeneratorPolicy::Unsupported;
-    pattern_forcing::PatternMutationSource dig_mutation_source = pattern_forcing::PatternMutationSource::Random;
-
-    auto log_stage_begin = [&](const char* stage) {
-        if (!trace_stage_diag) {
-            return;
-        }
-        log_info(
-            "generator.stage",
-            "stage=" + std::string(stage) +
-            " phase=begin geom=" + std::to_string(cfg.box_rows) + "x" + std::to_string(cfg.box_cols) +
-            " difficulty=" + std::to_string(cfg.difficulty_level_required) +
-            " required=" + std::string(to_string(cfg.required_strategy)) +
-            " fast_test=" + std::string(cfg.fast_test_mode ? "1" : "0"));
-    };
-
-    auto log_stage_end = [&](const char* stage, bool ok, const SearchAbortControl* stage_budget, const std::string& extra = std::string()) {
-        if (!trace_stage_diag) {
-            return;
-        }
-        std::string msg =
-            "stage=" + std::string(stage) +
-            " phase=end ok=" + std::string(ok ? "1" : "0");
-        if (stage_budget != nullptr) {
-            msg +=
-                " aborted=" + std::string(stage_budget->aborted() ? "1" : "0") +
-                " by_time=" + std::string(stage_budget->aborted_by_time ? "1" : "0") +
-                " by_nodes=" + std::string(stage_budget->aborted_by_nodes ? "1" : "0") +
-                " by_pause=" + std::string(stage_budget->aborted_by_pause ? "1" : "0") +
-                " nodes=" + std::to_string(stage_budget->nodes);
-        }
-        if (!extra.empty()) {
-            msg += " " + extra;
-        }
-        log_info("generator.stage", msg);
-    };
-
-    auto count_protected_cells = [&](const uint8_t* protected_cells) -> int {
-        if (protected_cells == nullptr) {
-            return 0;
-        }
-        int count = 0;
-        for (int i = 0; i < topo.nn; ++i) {
-            count += protected_cells[i] ? 1 : 0;
-        }
-        return count;
-    };
-
-    auto log_pattern_contract = [&](const char* phase, const std::string& extra = std::string()) {
-        if (!trace_stage_diag) {
-            return;
-        }
-        std::string msg =
-            "phase=" + std::string(phase) +
-            " required=" + std::string(to_string(cfg.required_strategy)) +
-            " kind=" + std::string(pattern_forcing::pattern_kind_label(dig_pattern_kind)) +
-            " policy=" + std::string(to_string(dig_generator_policy)) +
-            " exact=" + std::string(dig_exact_template ? "1" : "0") +
-            " family_fallback=" + std::string(dig_family_fallback_used ? "1" : "0") +
-            " exact_contract=" + std::string(dig_exact_contract_met ? "1" : "0") +
-            " anchors=" + std::to_string(dig_anchor_count) +
-            " protected=" + std::to_string(count_protected_cells(dig_protected_cells)) +
-            " score=" + std::to_string(dig_template_score) +
-            " best_score=" + std::to_string(dig_best_template_score) +
-            " score_delta=" + std::to_string(dig_template_score_delta) +
-            " mutation=" + std::string(pattern_forcing::pattern_mutation_source_label(dig_mutation_source)) +
-            " mutation_strength=" + std::to_string(dig_mutation_strength) +
-            " planner_zero_use=" + std::to_string(dig_planner_zero_use_streak) +
-            " planner_fail=" + std::to_string(dig_planner_failure_streak) +
-            " adaptive_target=" + std::to_string(dig_adaptive_target_strength);
-        if (!extra.empty()) {
-            msg += " " + extra;
-        }
-        log_info("pattern.contract", msg);
-    };
-
-    auto log_strategy_contract = [&](const char* phase, RejectReason reject_reason, const logic::GenericLogicCertifyResult* logic_result = nullptr) {
-        if (!trace_stage_diag || cfg.required_strategy == RequiredStrategy::None) {
-            return;
-        }
-        size_t required_slot = 0;
-        std::ostringstream oss;
-        oss << "phase=" << phase
-            << " required=" << to_string(cfg.required_strategy)
-            << " reject=" << static_cast<int>(reject_reason)
-            << " reqA/U/H=" << mcts_stats.required_strategy_analyzed
-            << "/" << mcts_stats.required_strategy_uses
-            << "/" << mcts_stats.required_strategy_hits;
-        if (logic::GenericLogicCertify::slot_from_required_strategy(cfg.required_strategy, required_slot)) {
-            const auto& meta = logic::GenericLogicCertify::strategy_meta_for_slot(required_slot);
-            oss << " slot=" << required_slot
-                << " slot_id=" << meta.id
-                << " coverage=" << to_string(meta.coverage_grade)
-                << " generator_policy=" << to_string(meta.generator_policy)
-                << " zero_alloc=" << to_string(meta.zero_alloc_grade)
-                << " audit_decision=" << to_string(meta.audit_decision);
-            if (logic_result != nullptr) {
-                const auto& stats = logic_result->strategy_stats[required_slot];
-                oss << " logic_use/hit=" << stats.use_count
-                    << "/" << stats.hit_count
-                    << " solved=" << (logic_result->solved ? 1 : 0)
-                    << " timed_out=" << (logic_result->timed_out ? 1 : 0)
-                    << " steps=" << logic_result->steps;
-            }
-        }
-        log_info("strategy.contract", oss.str());
-    };
-    
-    SearchAbortControl budget;
+
+    SearchAbortControl& budget = st.budget;
     if (cfg.attempt_time_budget_s > 0.0) {
         budget.time_enabled = true;
         budget.deadline = std::chrono::steady_clock::now() + 
@@ -420,6 +479,7 @@ inline bool generate_one_generic(
     candidate.solution.resize(static_cast<size_t>(topo.nn), 0);
     candidate.puzzle.resize(static_cast<size_t>(topo.nn), 0);
     candidate.clues = 0;
+    candidate.uniq_proof = {};
 
     // ------------------------------------------------------------------------
     // ETAP 1: Generowanie pełnej, poprawnej planszy "Solved Grid"
@@ -432,9 +492,9 @@ inline bool generate_one_generic(
     const bool strict_exact_contract =
         cfg.pattern_forcing_enabled &&
         pattern_forcing::pattern_policy_requires_exact(required_generator_policy);
-    dig_generator_policy = required_generator_policy;
-    dig_exact_contract_met = !strict_exact_contract;
-
+    st.dig_generator_policy = required_generator_policy;
+    st.dig_exact_contract_met = !strict_exact_contract;
+
     if (cfg.pattern_forcing_enabled) {
         const int pf_tries = std::max(1, cfg.pattern_forcing_tries);
         for (int pf_try = 0; pf_try < pf_tries && !solved_ok; ++pf_try) {
@@ -463,47 +523,57 @@ inline bool generate_one_generic(
             }
 
             // Rozwiązanie narzuconego układu przez DLX Solver
-            log_stage_begin("pattern_solve");
+            attempt_trace::stage_begin(cfg, "pattern_solve");
             solved_ok = uniq.solve_and_capture(
                 *pf_seed.seed_puzzle, topo, candidate.solution, budget_ptr, pf_seed.allowed_masks);
-            log_stage_end(
-                "pattern_solve",
-                solved_ok,
-                budget_ptr,
-                "pf_try=" + std::to_string(pf_try) +
-                " exact=" + std::string(pf_seed.exact_template ? "1" : "0") +
-                " kind=" + std::string(pattern_forcing::pattern_kind_label(pf_seed.kind)) +
-                " score=" + std::to_string(pf_seed.template_score));
+            if (trace) {
+                attempt_trace::stage_end(
+                    cfg,
+                    "pattern_solve",
+                    solved_ok,
+                    budget_ptr,
+                    "pf_try=" + std::to_string(pf_try) +
+                    " exact=" + std::string(pf_seed.exact_template ? "1" : "0") +
+                    " kind=" + std::string(pattern_forcing::pattern_kind_label(pf_seed.kind)) +
+                    " score=" + std::to_string(pf_seed.template_score));
+            }
                 
             if (solved_ok && cfg.pattern_forcing_lock_anchors && pf_seed.protected_cells != nullptr &&
                 !pf_seed.protected_cells->empty()) {
                 dig_protected_cells = pf_seed.protected_cells->data();
+                if (trace) {
+                    st.dig_protected_count = static_cast<int>(
+                        std::count(pf_seed.protected_cells->begin(), pf_seed.protected_cells->end(), uint8_t{1}));
+                }
             }
             if (solved_ok && pf_seed.allowed_masks != nullptr && !pf_seed.allowed_masks->empty()) {
                 dig_allowed_masks = pf_seed.allowed_masks->data();
                 dig_anchor_idx = pf_seed.anchor_idx;
                 dig_anchor_masks = pf_seed.anchor_masks;
-                dig_anchor_count = pf_seed.anchor_count;
-                dig_exact_template = pf_seed.exact_template;
-                dig_family_fallback_used = pf_seed.family_fallback_used;
-                dig_exact_contract_met = pf_seed.required_strategy_exact_contract_met;
-                dig_template_score = pf_seed.template_score;
-                dig_best_template_score = pf_seed.best_template_score;
-                dig_template_score_delta = pf_seed.template_score_delta;
-                dig_mutation_strength = pf_seed.mutation_strength;
-                dig_planner_zero_use_streak = pf_seed.planner_zero_use_streak;
-                dig_planner_failure_streak = pf_seed.planner_failure_streak;
-                dig_adaptive_target_strength = pf_seed.adaptive_target_strength;
-                dig_pattern_kind = pf_seed.kind;
-                dig_generator_policy = pf_seed.generator_policy;
-                dig_mutation_source = pf_seed.mutation_source;
+                st.dig_anchor_count = pf_seed.anchor_count;
+                st.dig_exact_template = pf_seed.exact_template;
+                st.dig_family_fallback_used = pf_seed.family_fallback_used;
+                st.dig_exact_contract_met = pf_seed.required_strategy_exact_contract_met;
+                st.dig_template_score = pf_seed.template_score;
+                st.dig_best_template_score = pf_seed.best_template_score;
+                st.dig_template_score_delta = pf_seed.template_score_delta;
+                st.dig_mutation_strength = pf_seed.mutation_strength;
+                st.dig_planner_zero_use_streak = pf_seed.planner_zero_use_streak;
+                st.dig_planner_failure_streak = pf_seed.planner_failure_streak;
+                st.dig_adaptive_target_strength = pf_seed.adaptive_target_strength;
+                st.dig_pattern_kind = pf_seed.kind;
+                st.dig_generator_policy = pf_seed.generator_policy;
+                st.dig_mutation_source = pf_seed.mutation_source;
             }
             if (solved_ok) {
-                log_pattern_contract(
-                    "seed-built",
-                    "pf_try=" + std::to_string(pf_try) +
-                    " allowed_masks=" + std::to_string(
-                        (pf_seed.allowed_masks != nullptr) ? static_cast<int>(pf_seed.allowed_masks->size()) : 0));
+                if (trace) {
+                    attempt_trace::pattern_contract(
+                        cfg, st,
+                        "seed-built",
+                        "pf_try=" + std::to_string(pf_try) +
+                        " allowed_masks=" + std::to_string(
+                            (pf_seed.allowed_masks != nullptr) ? static_cast<int>(pf_seed.allowed_masks->size()) : 0));
+                }
             } else {
                 log_info(
                     "pattern.contract",
@@ -519,14 +589,21 @@ inline bool generate_one_generic(
             }
             if (budget_ptr != nullptr && budget_ptr->aborted()) break;
         }
-    }
+    }
 
     // Fallback dla zwykłego generatora jeśli wzorzec nie jest wymagany
     if (!solved_ok && !strict_exact_contract) {
-        log_stage_begin("fallback_solve");
-        solved_ok = solved.generate(topo, rng, candidate.solution, budget_ptr);
-        log_stage_end("fallback_solve", solved_ok, budget_ptr);
-    }
+        // Duże plansze bez allowed_masks: siatka z puli przekształceń zamiast backtrackingu.
+        static thread_local core_engines::TransformGridSource transform_grids;
+        const bool use_transform =
+            cfg.transform_grid_min_n > 0 && topo.n >= cfg.transform_grid_min_n &&
+            core_engines::TransformGridSource::applicable(topo);
+        attempt_trace::stage_begin(cfg, "fallback_solve");
+        solved_ok = use_transform
+            ? transform_grids.generate(topo, rng, candidate.solution)
+            : solved.generate(topo, rng, candidate.solution, budget_ptr);
+        attempt_trace::stage_end(cfg, "fallback_solve", solved_ok, budget_ptr, use_transform ? "source=transform" : "source=kernel");
+    }
     
     if (collect_perf) {
         perf_out->solved_elapsed_ns += static_cast<uint64_t>(
@@ -539,22 +616,22 @@ inline bool generate_one_generic(
             if (budget_ptr->aborted_by_pause) {
                 reason = RejectReason::None;
                 return false;
-            }
+            }
             if (has_timed_out_ptr) *timed_out = budget_ptr->aborted_by_time || budget_ptr->aborted_by_nodes;
-        }
+        }
         reason = RejectReason::Logic;
         return false;
     }
     
-    // ------------------------------------------------------------------------
+    // ------------------------------------------------------------------------
     // ETAP 2: Wykopywanie dziur w planszy i ocena przez Bottleneck Digger
-    // ------------------------------------------------------------------------
+    // ------------------------------------------------------------------------
     const auto dig_t0 = std::chrono::steady_clock::now();
     if (cfg.mcts_digger_enabled) {
         mcts_digger::GenericMctsBottleneckDigger mcts_digger;
         candidate.puzzle.resize(candidate.solution.size());
-        
-        log_stage_begin("dig");
+        
+        attempt_trace::stage_begin(cfg, "dig");
         const bool dig_ok = mcts_digger.dig_into(
             std::span<const uint16_t>(candidate.solution.data(), candidate.solution.size()),
             topo,
@@ -565,33 +642,38 @@ inline bool generate_one_generic(
             std::span<uint16_t>(candidate.puzzle.data(), candidate.puzzle.size()),
             candidate.clues,
             dig_protected_cells,
-            dig_allowed_masks, dig_anchor_idx, dig_anchor_masks, dig_anchor_count, dig_exact_template,
-            budget_ptr, &mcts_stats);
-        log_stage_end(
-            "dig",
-            dig_ok,
-            budget_ptr,
-            "advanced_evals=" + std::to_string(mcts_stats.advanced_evals) +
-            " reqA/U/H=" + std::to_string(mcts_stats.required_strategy_analyzed) + "/" +
-                std::to_string(mcts_stats.required_strategy_uses) + "/" +
-                std::to_string(mcts_stats.required_strategy_hits));
-            
+            dig_allowed_masks, dig_anchor_idx, dig_anchor_masks, st.dig_anchor_count, st.dig_exact_template,
+            budget_ptr, &st.mcts_stats);
+        if (trace) {
+            attempt_trace::stage_end(
+                cfg,
+                "dig",
+                dig_ok,
+                budget_ptr,
+                "advanced_evals=" + std::to_string(st.mcts_stats.advanced_evals) +
+                " reqA/U/H=" + std::to_string(st.mcts_stats.required_strategy_analyzed) + "/" +
+                    std::to_string(st.mcts_stats.required_strategy_uses) + "/" +
+                    std::to_string(st.mcts_stats.required_strategy_hits));
+        }
+            
         if (!dig_ok) {
             pattern_forcing::note_template_attempt_feedback(
-                cfg.required_strategy, dig_pattern_kind, dig_exact_template, dig_template_score,
-                static_cast<int>(mcts_stats.required_strategy_analyzed),
-                static_cast<int>(mcts_stats.required_strategy_uses),
-                static_cast<int>(mcts_stats.required_strategy_hits));
+                cfg.required_strategy, st.dig_pattern_kind, st.dig_exact_template, st.dig_template_score,
+                static_cast<int>(st.mcts_stats.required_strategy_analyzed),
+                static_cast<int>(st.mcts_stats.required_strategy_uses),
+                static_cast<int>(st.mcts_stats.required_strategy_hits));
             if (budget_ptr != nullptr && budget_ptr->aborted()) {
                 if (budget_ptr->aborted_by_pause) {
                     reason = RejectReason::None;
                     return false;
-                }
+                }
                 if (has_timed_out_ptr) *timed_out = budget_ptr->aborted_by_time || budget_ptr->aborted_by_nodes;
-            }
-            reason = RejectReason::Logic;
+            }
+            // Klasyfikator przewidział odrzucenie kontraktu trudności/strategii.
+            reason = st.mcts_stats.early_aborted ? RejectReason::Strategy : RejectReason::Logic;
             return false;
-        }
+        }
+        candidate.uniq_proof = st.mcts_stats.uniq_proof;
     } else {
         // Fallback dla małych plansz lub gdy użytkownik prosi o brak MCTS
         // (Do dorzucenia np. standardowy random digger - tutaj uproszczony fallback na fail, jeśli wymagane)
@@ -599,62 +681,108 @@ inline bool generate_one_generic(
         return false;
     }
     
-    if (collect_perf) {
+    if (collect_perf) {
         perf_out->dig_elapsed_ns += static_cast<uint64_t>(
-            std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
                 std::chrono::steady_clock::now() - dig_t0).count());
-        perf_out->mcts_advanced_evals += static_cast<uint64_t>(std::max(0, mcts_stats.advanced_evals));
-        perf_out->mcts_required_strategy_analyzed += static_cast<uint64_t>(std::max(0, mcts_stats.required_strategy_analyzed));
-        perf_out->mcts_required_strategy_use += static_cast<uint64_t>(std::max(0, mcts_stats.required_strategy_uses));
-        perf_out->mcts_required_strategy_hit += static_cast<uint64_t>(std::max(0, mcts_stats.required_strategy_hits));
-        perf_out->pattern_template_score = dig_template_score;
-        perf_out->pattern_best_template_score = dig_best_template_score;
-        perf_out->pattern_exact_template = dig_exact_template;
-        perf_out->pattern_family_fallback_used = dig_family_fallback_used;
-        perf_out->required_strategy_exact_contract_met = dig_exact_contract_met;
-        perf_out->pattern_template_score_delta = dig_template_score_delta;
-        perf_out->pattern_mutation_strength = dig_mutation_strength;
-        perf_out->pattern_planner_zero_use_streak = dig_planner_zero_use_streak;
-        perf_out->pattern_planner_failure_streak = dig_planner_failure_streak;
-        perf_out->pattern_adaptive_target_strength = dig_adaptive_target_strength;
-        perf_out->pattern_template_family = dig_pattern_kind;
-        perf_out->pattern_generator_policy = dig_generator_policy;
-        perf_out->pattern_mutation_source = dig_mutation_source;
-    }
-
-    strategy_info.family_fallback_used = dig_family_fallback_used;
-    strategy_info.required_strategy_exact_contract_met = dig_exact_contract_met;
-
+        perf_out->mcts_advanced_evals += static_cast<uint64_t>(std::max(0, st.mcts_stats.advanced_evals));
+        perf_out->mcts_required_strategy_analyzed += static_cast<uint64_t>(std::max(0, st.mcts_stats.required_strategy_analyzed));
+        perf_out->mcts_required_strategy_use += static_cast<uint64_t>(std::max(0, st.mcts_stats.required_strategy_uses));
+        perf_out->mcts_required_strategy_hit += static_cast<uint64_t>(std::max(0, st.mcts_stats.required_strategy_hits));
+        perf_out->pattern_template_score = st.dig_template_score;
+        perf_out->pattern_best_template_score = st.dig_best_template_score;
+        perf_out->pattern_exact_template = st.dig_exact_template;
+        perf_out->pattern_family_fallback_used = st.dig_family_fallback_used;
+        perf_out->required_strategy_exact_contract_met = st.dig_exact_contract_met;
+        perf_out->pattern_template_score_delta = st.dig_template_score_delta;
+        perf_out->pattern_mutation_strength = st.dig_mutation_strength;
+        perf_out->pattern_planner_zero_use_streak = st.dig_planner_zero_use_streak;
+        perf_out->pattern_planner_failure_streak = st.dig_planner_failure_streak;
+        perf_out->pattern_adaptive_target_strength = st.dig_adaptive_target_strength;
+        perf_out->pattern_template_family = st.dig_pattern_kind;
+        perf_out->pattern_generator_policy = st.dig_generator_policy;
+        perf_out->pattern_mutation_source = st.dig_mutation_source;
+    }
+
+    strategy_info.family_fallback_used = st.dig_family_fallback_used;
+    strategy_info.required_strategy_exact_contract_met = st.dig_exact_contract_met;
+
+    return true;
+}
+
+// ETAP 3-7 dla kandydata wykopanego przez generate_dig_stage_generic (ten sam st).
+inline bool generate_certify_stage_generic(
+    const GenerateRunConfig& cfg,
+    const GenericTopology& topo,
+    GenericPuzzleCandidate& candidate,
+    RejectReason& reason,
+    RequiredStrategyAttemptInfo& strategy_info,
+    const core_engines::GenericQuickPrefilter& prefilter,
+    const logic::GenericLogicCertify& logic,
+    const core_engines::GenericUniquenessCounter& uniq,
+    GenericAttemptStageState& st,
+    bool* timed_out = nullptr,
+    post_processing::QualityContract* quality_contract_out = nullptr,
+    post_processing::QualityMetrics* quality_metrics_out = nullptr,
+    post_processing::ReplayValidationResult* replay_out = nullptr,
+    AttemptPerfStats* perf_out = nullptr) {
+
+    const bool has_timed_out_ptr = (timed_out != nullptr);
+    const bool has_quality_contract_out = (quality_contract_out != nullptr);
+    const bool has_quality_metrics_out = (quality_metrics_out != nullptr);
+    const bool has_replay_out = (replay_out != nullptr);
+    const bool collect_perf = (perf_out != nullptr);
+
+    if (has_quality_contract_out) *quality_contract_out = {};
+    if (has_quality_metrics_out) *quality_metrics_out = {};
+    if (has_replay_out) *replay_out = {};
+
+    const bool quality_contract_enabled = cfg.enable_quality_contract;
+    const bool distribution_filter_enabled = quality_contract_enabled && cfg.enable_distribution_filter;
+    const bool replay_validation_enabled = quality_contract_enabled && cfg.enable_replay_validation;
+    const bool need_quality_metrics = quality_contract_enabled || quality_contract_out != nullptr || quality_metrics_out != nullptr;
+    const bool trace = attempt_trace::enabled(cfg);
+    SearchAbortControl* budget_ptr = st.budget_enabled ? &st.budget : nullptr;
+
+    // Token dowodu unikalności z diggera - ETAP 6 nie liczy ponownie tej samej planszy.
+    // Plansza zmieniona po dowodzie ma inny hash, więc token jej nie pokrywa.
+    const post_processing::UniquenessProof& uniq_proof = candidate.uniq_proof;
+
     auto note_pattern_feedback = [&]() {
-        pattern_forcing::note_template_attempt_feedback(
+        st.pattern_feedback = PatternTemplateFeedback{
+            true,
             cfg.required_strategy,
-            dig_pattern_kind,
-            dig_exact_template,
-            dig_template_score,
-            static_cast<int>(mcts_stats.required_strategy_analyzed),
-            static_cast<int>(mcts_stats.required_strategy_uses),
-            static_cast<int>(mcts_stats.required_strategy_hits));
+            st.dig_pattern_kind,
+            st.dig_exact_template,
+            st.dig_template_score,
+            static_cast<int>(st.mcts_stats.required_strategy_analyzed),
+            static_cast<int>(st.mcts_stats.required_strategy_uses),
+            static_cast<int>(st.mcts_stats.required_strategy_hits)};
     };
 
     // ------------------------------------------------------------------------
     // ETAP 3: Quick Prefilter
     // ------------------------------------------------------------------------
     const auto prefilter_t0 = std::chrono::steady_clock::now();
-    log_stage_begin("prefilter");
+    attempt_trace::stage_begin(cfg, "prefilter");
     const bool prefilter_ok = prefilter.check(candidate.puzzle, topo, cfg.min_clues, cfg.max_clues);
-    log_stage_end("prefilter", prefilter_ok, nullptr, "clues=" + std::to_string(candidate.clues));
-    if (collect_perf) {
+    if (trace) {
+        attempt_trace::stage_end(cfg, "prefilter", prefilter_ok, nullptr, "clues=" + std::to_string(candidate.clues));
+    }
+    if (collect_perf) {
         perf_out->prefilter_elapsed_ns += static_cast<uint64_t>(
-            std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
                 std::chrono::steady_clock::now() - prefilter_t0).count());
-    }
+    }
     if (!prefilter_ok) {
-        log_pattern_contract("prefilter-reject", "clues=" + std::to_string(candidate.clues));
-        log_strategy_contract("prefilter-reject", RejectReason::Prefilter, nullptr);
+        if (trace) {
+            attempt_trace::pattern_contract(cfg, st, "prefilter-reject", "clues=" + std::to_string(candidate.clues));
+        }
+        attempt_trace::strategy_contract(cfg, st, "prefilter-reject", RejectReason::Prefilter, nullptr);
         note_pattern_feedback();
         reason = RejectReason::Prefilter;
-        return false;
-    }
+        return false;
+    }
     
     // ------------------------------------------------------------------------
     // ETAP 4: Weryfikacja Jakości i Symetrii (Quality Contract)
@@ -669,23 +797,23 @@ inline bool generate_one_generic(
             quality_contract_out->symmetry_ok = quality_metrics.symmetry_ok;
             quality_contract_out->distribution_balance_ok = quality_metrics.distribution_balance_ok;
             quality_contract_out->givens_entropy_ok = quality_metrics.normalized_entropy >= quality_metrics.entropy_threshold;
-        }
+        }
 
         if (quality_contract_enabled) {
             if (!quality_metrics.symmetry_ok) {
                 note_pattern_feedback();
                 reason = RejectReason::DistributionBias;
-                return false;
+                return false;
             }
             if (distribution_filter_enabled) {
                 if (!(quality_metrics.normalized_entropy >= quality_metrics.entropy_threshold) || 
                     !quality_metrics.distribution_balance_ok) {
                     note_pattern_feedback();
                     reason = RejectReason::DistributionBias;
-                    return false;
+                    return false;
                 }
-            }
-        }
+            }
+        }
     }
     
     // ------------------------------------------------------------------------
@@ -693,17 +821,30 @@ inline bool generate_one_generic(
     // ------------------------------------------------------------------------
     const bool capture_logic_solution = replay_validation_enabled;
     const auto logic_t0 = std::chrono::steady_clock::now();
+    // Próbkowany audyt: co N-ty kandydat wątku przechodzi pełne liczenie i replay mimo tokenu.
+    static thread_local uint64_t tls_audit_tick = 0;
+    const bool audit_pass =
+        cfg.uniqueness_audit_every > 0 &&
+        (++tls_audit_tick % static_cast<uint64_t>(cfg.uniqueness_audit_every)) == 0;
+    const bool uniqueness_proven = !audit_pass && uniq_proof.covers(candidate.puzzle);
+    // Maski kandydatów z punktu stałego P1/P2 - zasiew dla licznika DLX w ETAPIE 6.
+    static thread_local std::vector<uint64_t> tls_seed_masks;
+    std::vector<uint64_t>* const seed_masks_ptr = (cfg.require_unique && !uniqueness_proven) ? &tls_seed_masks : nullptr;
     
     // Wywołanie głównego silnika z ewaluacją wszystkich wymaganych strategii
-    log_stage_begin("logic");
-    const logic::GenericLogicCertifyResult logic_result = logic.certify(candidate.puzzle, topo, budget_ptr, capture_logic_solution);
-    log_stage_end(
-        "logic",
-        !logic_result.timed_out,
-        budget_ptr,
-        "timed_out=" + std::string(logic_result.timed_out ? "1" : "0") +
-        " solved=" + std::string(logic_result.solved ? "1" : "0") +
-        " steps=" + std::to_string(std::max(0, logic_result.steps)));
+    attempt_trace::stage_begin(cfg, "logic");
+    const logic::GenericLogicCertifyResult logic_result =
+        logic.certify(candidate.puzzle, topo, budget_ptr, capture_logic_solution, seed_masks_ptr);
+    if (trace) {
+        attempt_trace::stage_end(
+            cfg,
+            "logic",
+            !logic_result.timed_out,
+            budget_ptr,
+            "timed_out=" + std::string(logic_result.timed_out ? "1" : "0") +
+            " solved=" + std::string(logic_result.solved ? "1" : "0") +
+            " steps=" + std::to_string(std::max(0, logic_result.steps)));
+    }
     
     if (collect_perf) {
         perf_out->logic_elapsed_ns += static_cast<uint64_t>(
@@ -714,8 +855,8 @@ inline bool generate_one_generic(
         note_pattern_feedback();
         if (budget_ptr != nullptr && budget_ptr->aborted_by_pause) {
             reason = RejectReason::None;
-            return false;
-        }
+            return false;
+        }
         if (has_timed_out_ptr) *timed_out = (budget_ptr == nullptr) ? true : (budget_ptr->aborted_by_time || budget_ptr->aborted_by_nodes);
         reason = RejectReason::Logic;
         return false;
@@ -731,15 +872,17 @@ inline bool generate_one_generic(
 
     if (!cfg.fast_test_mode) {
         if (!evaluate_difficulty_contract_generic(logic_result, cfg.difficulty_level_required)) {
-            log_pattern_contract("difficulty-reject", "clues=" + std::to_string(candidate.clues));
-            log_strategy_contract("difficulty-reject", RejectReason::Strategy, &logic_result);
+            if (trace) {
+                attempt_trace::pattern_contract(cfg, st, "difficulty-reject", "clues=" + std::to_string(candidate.clues));
+            }
+            attempt_trace::strategy_contract(cfg, st, "difficulty-reject", RejectReason::Strategy, &logic_result);
             note_pattern_feedback();
             reason = RejectReason::Strategy;
-            return false;
+            return false;
         }
-    }
+    }
     const bool contract_ok = evaluate_required_strategy_contract_generic(logic_result, cfg, cfg.required_strategy, strategy_info);
-    if (collect_perf) {
+    if (collect_perf) {
         size_t required_slot = 0;
         const bool has_required_slot =
             logic::GenericLogicCertify::slot_from_required_strategy(cfg.required_strategy, required_slot);
@@ -748,25 +891,30 @@ inline bool generate_one_generic(
             has_required_slot ? logic_result.strategy_stats[required_slot].use_count : 0ULL;
         perf_out->certifier_required_strategy_hit =
             has_required_slot ? logic_result.strategy_stats[required_slot].hit_count : 0ULL;
-    }
+    }
     if (cfg.required_strategy != RequiredStrategy::None && !contract_ok) {
-        log_pattern_contract("strategy-reject", "clues=" + std::to_string(candidate.clues));
-        log_strategy_contract("strategy-reject", RejectReason::Strategy, &logic_result);
+        if (trace) {
+            attempt_trace::pattern_contract(cfg, st, "strategy-reject", "clues=" + std::to_string(candidate.clues));
+        }
+        attempt_trace::strategy_contract(cfg, st, "strategy-reject", RejectReason::Strategy, &logic_result);
         note_pattern_feedback();
         reason = RejectReason::Strategy;
-        return false;
-    }
+        return false;
+    }
     if (cfg.strict_logical && !logic_result.solved && cfg.required_strategy != RequiredStrategy::Backtracking) {
         note_pattern_feedback();
-        reason = RejectReason::Logic;
-        return false;
-    }
+        reason = RejectReason::Logic;
+        return false;
+    }
     
     // ------------------------------------------------------------------------
     // ETAP 6: Gwarancja Unikalności przez algorytm Dancing Links X (DLX)
     // ------------------------------------------------------------------------
     bool uniqueness_ok = true;
-    if (cfg.require_unique) {
+    if (cfg.require_unique && uniqueness_proven) {
+        attempt_trace::stage_begin(cfg, "uniqueness");
+        attempt_trace::stage_end(cfg, "uniqueness", true, nullptr, "solutions=1 proof=dig");
+    } else if (cfg.require_unique) {
         auto record_uniqueness_perf = [&](const SearchAbortControl& b, uint64_t elapsed_ns) {
             if (!collect_perf) return;
             ++perf_out->uniqueness_calls;
@@ -774,33 +922,58 @@ inline bool generate_one_generic(
             perf_out->uniqueness_elapsed_ns += elapsed_ns;
         };
         
-        SearchAbortControl uniq_budget = budget;
-        SearchAbortControl* uniq_budget_ptr = budget_enabled ? &uniq_budget : nullptr;
+        SearchAbortControl uniq_budget = st.budget;
+        SearchAbortControl* uniq_budget_ptr = st.budget_enabled ? &uniq_budget : nullptr;
         
         const auto uniq_t0 = std::chrono::steady_clock::now();
         // Limitujemy wyjście DLX na poziomie 2, by nie przeszukiwać całej choinki rozwiązań.
-        log_stage_begin("uniqueness");
-        const int solutions = uniq.count_solutions_limit2(candidate.puzzle, topo, uniq_budget_ptr);
+        // Z zasiewem masek DLX startuje ze zredukowanych kandydatów i propaguje single w węzłach.
+        const bool seeded = tls_seed_masks.size() == static_cast<size_t>(topo.nn);
+        attempt_trace::stage_begin(cfg, "uniqueness");
+        // Duże plansze (n >= 49) mogą liczyć jedno drzewo na kilku wątkach puli.
+        static thread_local core_engines::ParallelSolutionCounter parallel_uniq;
+        core_engines::ParallelCountConfig parallel_cfg{};
+        parallel_cfg.threads = (cfg.uniqueness_parallel_threads > 0)
+            ? cfg.uniqueness_parallel_threads
+            : core_engines::auto_parallel_count_width();
+        const int solutions = parallel_uniq.count_solutions_limit(
+            uniq,
+            candidate.puzzle,
+            topo,
+            seeded ? std::span<const uint64_t>(tls_seed_masks) : std::span<const uint64_t>{},
+            2,
+            uniq_budget_ptr,
+            parallel_cfg);
         const auto uniq_elapsed_ns = static_cast<uint64_t>(
             std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - uniq_t0).count());
-        log_stage_end("uniqueness", solutions == 1, uniq_budget_ptr, "solutions=" + std::to_string(solutions));
+        if (trace) {
+            attempt_trace::stage_end(
+                cfg,
+                "uniqueness",
+                solutions == 1,
+                uniq_budget_ptr,
+                "solutions=" + std::to_string(solutions) + " seeded=" + std::string(seeded ? "1" : "0"));
+        }
             
         record_uniqueness_perf(uniq_budget, uniq_elapsed_ns);
         
         if (solutions < 0) {
             note_pattern_feedback();
             if (uniq_budget_ptr != nullptr && uniq_budget_ptr->aborted_by_pause) {
-                reason = RejectReason::None;
-                return false;
-            }
+                reason = RejectReason::None;
+                return false;
+            }
             if (has_timed_out_ptr) *timed_out = true;
             reason = RejectReason::Logic;
             return false;
-        }
+        }
         if (solutions != 1) {
+            if (uniq_proof.covers(candidate.puzzle)) {
+                log_warn("generator.audit", "dig uniqueness proof contradicted: solutions=" + std::to_string(solutions));
+            }
             note_pattern_feedback();
             reason = RejectReason::Uniqueness;
-            return false;
+            return false;
         }
     }
 
@@ -809,13 +982,18 @@ inline bool generate_one_generic(
     // ------------------------------------------------------------------------
     post_processing::ReplayValidationResult replay{};
     if (replay_validation_enabled) {
-        replay = post_processing::run_replay_validation(candidate.puzzle, candidate.solution, topo, logic);
-        
+        // ETAP 5 certyfikował tę samą planszę z przechwyceniem siatki; jeśli żaden slot nie
+        // został ucięty budżetem, drugie przejście dałoby identyczny wynik.
+        const bool reuse_certify = !audit_pass && logic_result.solved && logic_result.budget_aborted_slots == 0;
+        replay = reuse_certify
+            ? post_processing::replay_validation_from_certify(candidate.puzzle, candidate.solution, logic_result)
+            : post_processing::run_replay_validation(candidate.puzzle, candidate.solution, topo, logic);
+                
         if (has_replay_out) *replay_out = replay;
         if (!replay.ok) {
             note_pattern_feedback();
             reason = RejectReason::Replay;
-            return false;
+            return false;
         }
     }
     
@@ -825,18 +1003,59 @@ inline bool generate_one_generic(
     }
     
     if (has_quality_contract_out && !post_processing::quality_contract_passed(*quality_contract_out, cfg)) {
-        log_pattern_contract("quality-reject", "clues=" + std::to_string(candidate.clues));
-        log_strategy_contract("quality-reject", RejectReason::DistributionBias, &logic_result);
+        if (trace) {
+            attempt_trace::pattern_contract(cfg, st, "quality-reject", "clues=" + std::to_string(candidate.clues));
+        }
+        attempt_trace::strategy_contract(cfg, st, "quality-reject", RejectReason::DistributionBias, &logic_result);
         note_pattern_feedback();
         reason = RejectReason::DistributionBias;
-        return false;
-    }
-    
-    log_pattern_contract("accepted", "clues=" + std::to_string(candidate.clues));
-    log_strategy_contract("accepted", RejectReason::None, &logic_result);
+        return false;
+    }
+    
+    if (trace) {
+        attempt_trace::pattern_contract(cfg, st, "accepted", "clues=" + std::to_string(candidate.clues));
+    }
+    attempt_trace::strategy_contract(cfg, st, "accepted", RejectReason::None, &logic_result);
     note_pattern_feedback();
     reason = RejectReason::None;
     return true; // Sukces, plansza wygenerowana i obłożona wszelkimi certyfikatami.
 }
 
+inline bool generate_one_generic(
+    const GenerateRunConfig& cfg,
+    const GenericTopology& topo,
+    std::mt19937_64& rng,
+    GenericPuzzleCandidate& candidate,
+    RejectReason& reason,
+    RequiredStrategyAttemptInfo& strategy_info,
+    const core_engines::GenericSolvedKernel& solved,
+    const core_engines::GenericQuickPrefilter& prefilter,
+    const logic::GenericLogicCertify& logic,
+    const core_engines::GenericUniquenessCounter& uniq,
+    const std::atomic<bool>* force_abort_ptr = nullptr,
+    bool* timed_out = nullptr,
+    const std::atomic<bool>* external_cancel_ptr = nullptr,
+    const std::atomic<bool>* external_pause_ptr = nullptr,
+    post_processing::QualityContract* quality_contract_out = nullptr,
+    post_processing::QualityMetrics* quality_metrics_out = nullptr,
+    post_processing::ReplayValidationResult* replay_out = nullptr,
+    AttemptPerfStats* perf_out = nullptr) {
+
+    if (quality_contract_out != nullptr) *quality_contract_out = {};
+    if (quality_metrics_out != nullptr) *quality_metrics_out = {};
+    if (replay_out != nullptr) *replay_out = {};
+
+    GenericAttemptStageState st;
+    if (!generate_dig_stage_generic(
+            cfg, topo, rng, candidate, reason, strategy_info, solved, logic, uniq, st,
+            force_abort_ptr, timed_out, external_cancel_ptr, external_pause_ptr, perf_out)) {
+        return false;
+    }
+    const bool ok = generate_certify_stage_generic(
+        cfg, topo, candidate, reason, strategy_info, prefilter, logic, uniq, st,
+        timed_out, quality_contract_out, quality_metrics_out, replay_out, perf_out);
+    apply_pattern_feedback(st.pattern_feedback);
+    return ok;
+}
+
 } // namespace sudoku_hpc::generator
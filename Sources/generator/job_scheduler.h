@@ -0,0 +1,663 @@
+// ============================================================================
+// SUDOKU HPC - GENERATOR PIPELINE
+// Moduł: job_scheduler.h
+// Opis: Kolejka zadań (--jobs): jeden proces obsługuje wiele celów (geometria,
+//       poziom, strategia) wspólną pulą workerów zamiast kilku procesów, które
+//       przeciążają rdzenie i każdy od nowa buduje topologie i scratchpady.
+//       Worker wybiera zadanie planowaniem krokowym (stride) ważonym
+//       priorytetem i trzyma je przez kwant CPU, więc zmiana geometrii w
+//       cache'ach wątku amortyzuje się na wielu próbach. Topologia powstaje raz
+//       na geometrię, silniki i bufory wątku służą wszystkim zadaniom, a stan
+//       uczony per zadanie (klasyfikator przerwań, mutacje wzorca, kontroler
+//       budżetów) jest podmieniany przy zmianie zadania.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../core/tick_clock.h"
+#include "concurrency/cpu_topology.h"
+#include "runtime_runner.h"
+
+namespace sudoku_hpc {
+
+struct JobRunResult {
+    std::string name;
+    int priority = 1;
+    // Konfiguracja po heurystykach runtime (resolve_runtime_config).
+    GenerateRunConfig cfg;
+    GenerateRunResult result;
+    bool valid = false;
+};
+
+namespace job_scheduler_detail {
+
+// Kwant CPU, po którym worker wraca do planisty. Próba dłuższa od kwantu
+// (duże geometrie) kończy kwant sama.
+inline constexpr uint64_t kSliceNs = 50'000'000ULL;
+
+struct JobSlot {
+    std::string name;
+    int priority = 1;
+    GenerateRunConfig cfg;
+    const GenericTopology* topo = nullptr;
+    // Kopie topologii per węzeł NUMA (wspólne dla zadań tej samej geometrii).
+    concurrency::NodeReplicas<GenericTopology>* topo_replicas = nullptr;
+    // Etykieta "job <name>" w wierszach workerów monitora (id z intern_label).
+    uint16_t monitor_label = 0;
+    logic::StrategyTierPolicy tier_policy{};
+    bool valid = false;
+    bool adaptive_budget = false;
+    bool user_budget_fixed = false;
+    bool user_iterations_fixed = false;
+    generator::BudgetSettings budget_start{};
+    std::string budget_profile_path;
+    std::string budget_key;
+
+    std::mutex write_mu;
+    std::ofstream out;
+
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> attempts{0};
+    std::atomic<bool> done{false};
+
+    // Pod sched_mu: wirtualny czas planisty i zużyte CPU puli.
+    double pass = 0.0;
+    uint64_t cpu_ns = 0;
+    bool started = false;
+    std::chrono::steady_clock::time_point start_tp{};
+    std::chrono::steady_clock::time_point end_tp{};
+
+    // Pod result_mu: liczniki zsumowane z workerów na końcu.
+    std::mutex result_mu;
+    GenerateRunResult partial{};
+    generator::BudgetSettings best_budget{};
+    bool has_best_budget = false;
+};
+
+// Stan workera dla jednego zadania; żyje przez całą kolejkę.
+struct WorkerJobState {
+    bool started = false;
+    uint64_t seed_state = 0;
+    uint64_t attempt_seed = 0;
+    std::mt19937_64 rng;
+    std::chrono::steady_clock::time_point last_reseed_tp{};
+    core_engines::GenericSolvedKernel solved;
+    GenerateRunConfig cfg;
+    generator::AdaptiveBudgetController budget_ctl;
+    // Kopie stanu thread_local zadania, gdy worker pracuje nad innym.
+    mcts_digger::DigAbortClassifier classifier;
+    pattern_forcing::PatternMutationState mutation;
+    uint64_t local_attempts = 0;
+    GenerateRunResult stats{};
+};
+
+// Zadanie kończy się po osiągnięciu celu, limitu prób albo limitu czasu. Limit
+// czasu liczy się w sekundach puli (CPU zadania / liczba workerów), więc zadanie
+// o niskim priorytecie nie traci go, czekając na swoją kolej.
+inline bool job_exhausted(const JobSlot& job, uint64_t cpu_ns, int worker_count) {
+    if (job.accepted.load(std::memory_order_relaxed) >= job.cfg.target_puzzles) return true;
+    if (job.cfg.max_attempts > 0 && job.attempts.load(std::memory_order_relaxed) >= job.cfg.max_attempts) return true;
+    if (job.cfg.max_total_time_s > 0) {
+        const double pool_s = static_cast<double>(cpu_ns) * 1e-9 / static_cast<double>(std::max(1, worker_count));
+        if (pool_s >= static_cast<double>(job.cfg.max_total_time_s)) return true;
+    }
+    return false;
+}
+
+} // namespace job_scheduler_detail
+
+inline std::vector<JobRunResult> run_job_queue(
+    const std::vector<JobSpec>& specs,
+    int threads,
+    concurrency::AffinityPolicy affinity,
+    ConsoleStatsMonitor* monitor = nullptr,
+    std::atomic<bool>* cancel_flag = nullptr,
+    std::atomic<bool>* pause_flag = nullptr,
+    std::function<void(uint64_t, uint64_t)> on_progress = nullptr,
+    std::function<void(const std::string&)> on_log = nullptr) {
+
+    using namespace std::chrono;
+    using job_scheduler_detail::JobSlot;
+    using job_scheduler_detail::WorkerJobState;
+
+    const int job_count = static_cast<int>(specs.size());
+    std::vector<JobRunResult> out(specs.size());
+
+    // Topologia raz na geometrię - wspólna (tylko do odczytu) dla zadań i workerów.
+    std::map<std::pair<int, int>, std::unique_ptr<GenericTopology>> topologies;
+    std::map<std::pair<int, int>, std::unique_ptr<concurrency::NodeReplicas<GenericTopology>>> topo_replicas;
+    const int replica_nodes =
+        (affinity == concurrency::AffinityPolicy::None) ? 1 : concurrency::cpu_topology().node_count();
+    std::vector<std::unique_ptr<JobSlot>> jobs;
+    jobs.reserve(specs.size());
+    uint64_t total_target = 0;
+
+    for (int j = 0; j < job_count; ++j) {
+        const JobSpec& spec = specs[static_cast<size_t>(j)];
+        auto job = std::make_unique<JobSlot>();
+        job->name = spec.name;
+        job->priority = std::max(1, spec.priority);
+        if (monitor != nullptr) job->monitor_label = monitor->intern_label("job " + spec.name);
+        out[static_cast<size_t>(j)].name = spec.name;
+        out[static_cast<size_t>(j)].priority = job->priority;
+
+        const auto geom = std::make_pair(spec.cfg.box_rows, spec.cfg.box_cols);
+        auto topo_it = topologies.find(geom);
+        if (topo_it == topologies.end()) {
+            auto topo = std::make_unique<GenericTopology>();
+            std::string topo_err;
+            if (!build_generic_topology(spec.cfg.box_rows, spec.cfg.box_cols, *topo, &topo_err)) {
+                log_error("jobs", "job=" + spec.name + " invalid geometry: " + topo_err);
+                if (on_log) on_log("job " + spec.name + ": invalid geometry: " + topo_err);
+                topo.reset();
+            }
+            if (topo) {
+                topo_replicas.emplace(geom, std::make_unique<concurrency::NodeReplicas<GenericTopology>>(*topo, replica_nodes));
+            }
+            topo_it = topologies.emplace(geom, std::move(topo)).first;
+        }
+        job->topo = topo_it->second.get();
+        if (job->topo != nullptr) job->topo_replicas = topo_replicas.at(geom).get();
+
+        bool ok = job->topo != nullptr;
+        if (ok && !logic::GenericLogicCertify::parse_tier_policy(spec.cfg.strategy_tier_policy, job->tier_policy)) {
+            log_error("jobs", "job=" + spec.name + " invalid strategy tier policy: " + spec.cfg.strategy_tier_policy);
+            if (on_log) on_log("job " + spec.name + ": invalid strategy tier policy: " + spec.cfg.strategy_tier_policy);
+            ok = false;
+        }
+        if (ok) {
+            job->cfg = resolve_runtime_config(spec.cfg, *job->topo);
+            std::filesystem::create_directories(job->cfg.output_folder);
+            const std::filesystem::path output_path =
+                std::filesystem::path(job->cfg.output_folder) / job->cfg.output_file;
+            job->out.open(output_path, std::ios::out | std::ios::app);
+            if (!job->out) {
+                log_error("jobs", "job=" + spec.name + " cannot open output file: " + output_path.string());
+                if (on_log) on_log("job " + spec.name + ": cannot open output file: " + output_path.string());
+                ok = false;
+            }
+        }
+        if (ok) {
+            job->user_budget_fixed = spec.cfg.attempt_node_budget != 0 || spec.cfg.attempt_time_budget_s > 0.0;
+            job->user_iterations_fixed = spec.cfg.mcts_digger_iterations > 0;
+            job->adaptive_budget = job->cfg.adaptive_budget && !job->cfg.fast_test_mode;
+            job->budget_profile_path = job->cfg.budget_profile_file.empty()
+                ? std::string()
+                : (std::filesystem::path(job->cfg.output_folder) / job->cfg.budget_profile_file).string();
+            job->budget_key = generator::budget_profile_key(job->cfg);
+            if (job->adaptive_budget) {
+                const auto profiles = generator::load_budget_profiles(job->budget_profile_path);
+                const auto it = profiles.find(job->budget_key);
+                if (it != profiles.end()) job->budget_start = it->second;
+            }
+            total_target += job->cfg.target_puzzles;
+            log_info(
+                "jobs",
+                "job=" + job->name +
+                " priority=" + std::to_string(job->priority) +
+                " config " + cfg_diag_label(job->cfg) +
+                " clue_range=" + std::to_string(job->cfg.min_clues) + "-" + std::to_string(job->cfg.max_clues) +
+                " output=" + job->cfg.output_file);
+        } else {
+            job->cfg = spec.cfg;
+            job->done.store(true, std::memory_order_relaxed);
+        }
+        job->valid = ok;
+        jobs.push_back(std::move(job));
+    }
+
+    const int worker_count = std::max(1, threads <= 0 ? concurrency::default_worker_count() : threads);
+
+    if (monitor != nullptr) {
+        monitor->set_target(total_target);
+        monitor->set_active_workers(worker_count);
+        if (!jobs.empty()) {
+            monitor->set_grid_info(jobs.front()->cfg.box_rows, jobs.front()->cfg.box_cols, jobs.front()->cfg.difficulty_level_required);
+        }
+        monitor->set_background_status("job queue jobs=" + std::to_string(job_count));
+    }
+    log_info(
+        "jobs",
+        "queue start jobs=" + std::to_string(job_count) + " workers=" + std::to_string(worker_count) +
+        " cpu_affinity=" + concurrency::to_string(affinity));
+
+    std::mutex sched_mu;
+    std::atomic<uint64_t> total_accepted{0};
+
+    auto is_cancelled = [&]() -> bool {
+        return (cancel_flag != nullptr) && cancel_flag->load(std::memory_order_relaxed);
+    };
+    auto is_paused = [&]() -> bool {
+        return (pause_flag != nullptr) && pause_flag->load(std::memory_order_relaxed);
+    };
+
+    // Stride scheduling: zadanie z najmniejszym pass dostaje kwant; pass rośnie o
+    // zużyte CPU / priorytet. Rezerwacja kwantu z góry rozkłada równoległe wybory.
+    auto pick_job = [&]() -> int {
+        std::lock_guard<std::mutex> lock(sched_mu);
+        int best = -1;
+        for (int j = 0; j < job_count; ++j) {
+            JobSlot& job = *jobs[static_cast<size_t>(j)];
+            if (job.done.load(std::memory_order_relaxed)) continue;
+            if (job_scheduler_detail::job_exhausted(job, job.cpu_ns, worker_count)) {
+                job.done.store(true, std::memory_order_relaxed);
+                job.end_tp = steady_clock::now();
+                continue;
+            }
+            if (best < 0 || job.pass < jobs[static_cast<size_t>(best)]->pass) best = j;
+        }
+        if (best >= 0) {
+            JobSlot& job = *jobs[static_cast<size_t>(best)];
+            if (!job.started) {
+                job.started = true;
+                job.start_tp = steady_clock::now();
+                // Nowe zadanie nie odrabia czasu sprzed startu.
+                double min_pass = job.pass;
+                for (const auto& other : jobs) {
+                    if (other->started && !other->done.load(std::memory_order_relaxed)) {
+                        min_pass = std::min(min_pass, other->pass);
+                    }
+                }
+                job.pass = std::max(job.pass, min_pass);
+            }
+            job.pass += static_cast<double>(job_scheduler_detail::kSliceNs) * 1e-9 / static_cast<double>(job.priority);
+        }
+        return best;
+    };
+
+    auto charge_job = [&](int j, uint64_t slice_cpu_ns) {
+        std::lock_guard<std::mutex> lock(sched_mu);
+        JobSlot& job = *jobs[static_cast<size_t>(j)];
+        job.cpu_ns += slice_cpu_ns;
+        job.pass += (static_cast<double>(slice_cpu_ns) - static_cast<double>(job_scheduler_detail::kSliceNs)) * 1e-9 /
+                    static_cast<double>(job.priority);
+        if (!job.done.load(std::memory_order_relaxed) &&
+            job_scheduler_detail::job_exhausted(job, job.cpu_ns, worker_count)) {
+            job.done.store(true, std::memory_order_relaxed);
+            job.end_tp = steady_clock::now();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(worker_count));
+
+    for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
+        workers.emplace_back([&, worker_idx]() {
+            const concurrency::CpuPlacement placement = concurrency::place_current_thread(affinity, worker_idx);
+            std::vector<WorkerJobState> states(static_cast<size_t>(job_count));
+            int current_job = -1;
+            uint64_t worker_attempts = 0;
+
+            // Stan thread_local uczony per zadanie wędruje między wątkiem a slotem zadania.
+            auto swap_job_state = [&](int j) {
+                WorkerJobState& st = states[static_cast<size_t>(j)];
+                std::swap(mcts_digger::tls_dig_abort_classifier(), st.classifier);
+                std::swap(pattern_forcing::tls_pattern_mutation_state(), st.mutation);
+            };
+
+            try {
+                // Silniki i bufory wątku - jedne dla wszystkich zadań i geometrii.
+                core_engines::GenericQuickPrefilter prefilter;
+                logic::GenericLogicCertify logic;
+                core_engines::GenericUniquenessCounter uniq;
+                generator::GenericPuzzleCandidate candidate;
+                std::string line;
+
+                while (!is_cancelled()) {
+                    while (is_paused() && !is_cancelled()) {
+                        std::this_thread::sleep_for(milliseconds(20));
+                    }
+                    const int j = pick_job();
+                    if (j < 0) break;
+                    JobSlot& job = *jobs[static_cast<size_t>(j)];
+                    WorkerJobState& st = states[static_cast<size_t>(j)];
+                    const GenericTopology& topo = job.topo_replicas->local(placement.node);
+
+                    if (j != current_job) {
+                        if (current_job >= 0) swap_job_state(current_job);
+                        swap_job_state(j);
+                        current_job = j;
+                        logic.set_tier_policy(job.tier_policy);
+                        logic.set_strategy_work_cap(job.cfg.strategy_work_cap);
+                        logic.set_strategy_timing_sample(static_cast<uint32_t>(std::max(0, job.cfg.strategy_timing_sample)));
+                    }
+                    if (!st.started) {
+                        st.started = true;
+                        const uint64_t base_seed = (job.cfg.seed == 0)
+                            ? static_cast<uint64_t>(high_resolution_clock::now().time_since_epoch().count())
+                            : job.cfg.seed;
+                        st.seed_state =
+                            base_seed ^
+                            (0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(worker_idx) * 0x100000001B3ULL);
+                        st.attempt_seed = splitmix64_next(st.seed_state);
+                        st.rng.seed(st.attempt_seed);
+                        st.last_reseed_tp = steady_clock::now();
+                        st.solved = core_engines::GenericSolvedKernel(
+                            core_engines::GenericSolvedKernel::backend_from_string(job.cfg.cpu_backend));
+                        st.cfg = job.cfg;
+                        if (job.adaptive_budget) {
+                            st.budget_ctl.init(job.cfg, topo,  job.budget_start, job.user_budget_fixed, job.user_iterations_fixed);
+                            st.budget_ctl.apply(st.cfg);
+                        }
+                        log_info(
+                            "jobs.worker.start",
+                            "worker=" + std::to_string(worker_idx) +
+                            " job=" + job.name +
+                            " base_seed=" + std::to_string(base_seed) +
+                            " initial_attempt_seed=" + std::to_string(st.attempt_seed));
+                    }
+
+                    uint64_t job_cpu_ns = 0;
+                    {
+                        std::lock_guard<std::mutex> lock(sched_mu);
+                        job_cpu_ns = job.cpu_ns;
+                    }
+                    const uint64_t slice_t0 = thread_cpu_now_ns();
+                    uint64_t slice_ns = 0;
+                    while (slice_ns < job_scheduler_detail::kSliceNs && !is_cancelled() && !is_paused()) {
+                        if (job_scheduler_detail::job_exhausted(job, job_cpu_ns + slice_ns, worker_count)) break;
+
+                        ++st.local_attempts;
+                        ++worker_attempts;
+                        job.attempts.fetch_add(1, std::memory_order_relaxed);
+
+                        if (job.cfg.force_new_seed_per_attempt) {
+                            st.attempt_seed = splitmix64_next(st.seed_state);
+                            st.rng.seed(st.attempt_seed);
+                        } else if (job.cfg.reseed_interval_s > 0) {
+                            const auto now_tp = steady_clock::now();
+                            if (duration_cast<seconds>(now_tp - st.last_reseed_tp).count() >=
+                                static_cast<long long>(job.cfg.reseed_interval_s)) {
+                                st.attempt_seed = splitmix64_next(st.seed_state);
+                                st.rng.seed(st.attempt_seed);
+                                st.last_reseed_tp = now_tp;
+                            }
+                        }
+
+                        RejectReason reason = RejectReason::None;
+                        RequiredStrategyAttemptInfo strategy_info{};
+                        generator::AttemptPerfStats perf{};
+                        bool timed_out = false;
+                        const uint64_t attempt_cpu_t0 = thread_cpu_now_ns();
+
+                        const bool ok = generator::generate_one_generic(
+                            st.cfg,
+                            topo,
+                            st.rng,
+                            candidate,
+                            reason,
+                            strategy_info,
+                            st.solved,
+                            prefilter,
+                            logic,
+                            uniq,
+                            nullptr,
+                            &timed_out,
+                            cancel_flag,
+                            pause_flag,
+                            nullptr,
+                            nullptr,
+                            nullptr,
+                            &perf);
+
+                        const uint64_t attempt_cpu_t1 = thread_cpu_now_ns();
+                        slice_ns = attempt_cpu_t1 - slice_t0;
+                        if (!ok && reason == RejectReason::None) {
+                            mcts_digger::tls_dig_abort_classifier().discard_pending();
+                        } else {
+                            mcts_digger::tls_dig_abort_classifier().resolve(ok);
+                            if (job.adaptive_budget && st.budget_ctl.on_attempt(ok, attempt_cpu_t1 - attempt_cpu_t0)) {
+                                st.budget_ctl.apply(st.cfg);
+                            }
+                        }
+
+                        GenerateRunResult& s = st.stats;
+                        s.kernel_time_ms += static_cast<double>(perf.solved_elapsed_ns + perf.dig_elapsed_ns) / 1e6;
+                        ++s.kernel_calls;
+                        s.uniqueness_calls += perf.uniqueness_calls;
+                        s.uniqueness_nodes += perf.uniqueness_nodes;
+                        s.uniqueness_elapsed_ms += static_cast<double>(perf.uniqueness_elapsed_ns) / 1e6;
+                        s.logic_steps_total += perf.logic_steps;
+                        s.strategy_naked_use += perf.strategy_naked_use;
+                        s.strategy_naked_hit += perf.strategy_naked_hit;
+                        s.strategy_hidden_use += perf.strategy_hidden_use;
+                        s.strategy_hidden_hit += perf.strategy_hidden_hit;
+                        s.mcts_advanced_evals += perf.mcts_advanced_evals;
+                        s.certifier_required_strategy_analyzed += perf.certifier_required_strategy_analyzed;
+                        s.certifier_required_strategy_use += perf.certifier_required_strategy_use;
+                        s.certifier_required_strategy_hit += perf.certifier_required_strategy_hit;
+                        s.mcts_required_strategy_analyzed += perf.mcts_required_strategy_analyzed;
+                        s.mcts_required_strategy_use += perf.mcts_required_strategy_use;
+                        s.mcts_required_strategy_hit += perf.mcts_required_strategy_hit;
+                        if (perf.pattern_exact_template) ++s.pattern_exact_template_used;
+                        if (perf.pattern_family_fallback_used) ++s.pattern_family_fallback_used;
+                        if (perf.required_strategy_exact_contract_met) ++s.required_strategy_exact_contract_met;
+
+                        if (ok) {
+                            uint64_t accepted_idx = 0;
+                            bool slot_acquired = false;
+                            while (true) {
+                                uint64_t cur = job.accepted.load(std::memory_order_relaxed);
+                                if (cur >= job.cfg.target_puzzles) break;
+                                if (job.accepted.compare_exchange_weak(cur, cur + 1, std::memory_order_relaxed, std::memory_order_relaxed)) {
+                                    accepted_idx = cur + 1;
+                                    slot_acquired = true;
+                                    break;
+                                }
+                            }
+                            if (!slot_acquired) break;
+
+                            generator::serialize_line_generic_into(line, st.attempt_seed, job.cfg, candidate, topo.nn);
+                            {
+                                std::lock_guard<std::mutex> lock(job.write_mu);
+                                job.out << line << '\n';
+                                if (job.cfg.write_individual_files) {
+                                    const std::filesystem::path file_path =
+                                        std::filesystem::path(job.cfg.output_folder) /
+                                        ("sudoku_" + job.name + "_" + std::to_string(accepted_idx) + ".txt");
+                                    std::ofstream one(file_path, std::ios::out | std::ios::trunc);
+                                    if (one) {
+                                        one << line << '\n';
+                                    }
+                                }
+                            }
+                            job.written.fetch_add(1, std::memory_order_relaxed);
+                            const uint64_t accepted_total = total_accepted.fetch_add(1, std::memory_order_relaxed) + 1;
+
+                            if (on_progress) {
+                                on_progress(accepted_total, total_target);
+                            }
+                            if (on_log && (accepted_idx % 10ULL == 0ULL || accepted_idx == job.cfg.target_puzzles)) {
+                                on_log("job " + job.name + " accepted=" + std::to_string(accepted_idx) + "/" +
+                                       std::to_string(job.cfg.target_puzzles));
+                            }
+                        } else {
+                            ++s.rejected;
+                            accumulate_reject_reason(s, reason, timed_out);
+                            if (should_trace_attempt_diag(job.cfg, st.local_attempts, false, reason, timed_out)) {
+                                log_warn(
+                                    "jobs.worker.reject",
+                                    "worker=" + std::to_string(worker_idx) +
+                                    " job=" + job.name +
+                                    " attempt=" + std::to_string(st.local_attempts) +
+                                    " seed=" + std::to_string(st.attempt_seed) +
+                                    " reason=" + std::string(reject_reason_label(reason)) +
+                                    " timed_out=" + std::string(timed_out ? "1" : "0"));
+                            }
+                        }
+                    }
+                    charge_job(j, thread_cpu_now_ns() - slice_t0);
+
+                    if (monitor != nullptr) {
+                        uint64_t attempts_sum = 0;
+                        uint64_t written_sum = 0;
+                        for (const auto& other : jobs) {
+                            attempts_sum += other->attempts.load(std::memory_order_relaxed);
+                            written_sum += other->written.load(std::memory_order_relaxed);
+                        }
+                        monitor->set_attempts(attempts_sum);
+                        monitor->set_accepted(total_accepted.load(std::memory_order_relaxed));
+                        monitor->set_written(written_sum);
+
+                        WorkerRow row{};
+                        row.clues = candidate.clues;
+                        row.seed = st.attempt_seed;
+                        row.applied = worker_attempts;
+                        row.status = WorkerStatus::Running;
+                        row.label_id = job.monitor_label;
+                        row.reseed_interval_s = job.cfg.reseed_interval_s;
+                        row.attempt_time_budget_s = st.cfg.attempt_time_budget_s;
+                        row.attempt_node_budget = st.cfg.attempt_node_budget;
+                        monitor->set_worker_row(static_cast<size_t>(worker_idx), row);
+                    }
+                }
+            } catch (const std::exception& ex) {
+                if (cancel_flag != nullptr) {
+                    cancel_flag->store(true, std::memory_order_relaxed);
+                }
+                log_error("jobs.worker.exception", "worker=" + std::to_string(worker_idx) + " what=" + ex.what());
+            } catch (...) {
+                if (cancel_flag != nullptr) {
+                    cancel_flag->store(true, std::memory_order_relaxed);
+                }
+                log_error("jobs.worker.exception", "worker=" + std::to_string(worker_idx) + " what=unknown");
+            }
+
+            if (current_job >= 0) swap_job_state(current_job);
+
+            for (int j = 0; j < job_count; ++j) {
+                WorkerJobState& st = states[static_cast<size_t>(j)];
+                if (!st.started) continue;
+                JobSlot& job = *jobs[static_cast<size_t>(j)];
+                const GenerateRunResult& s = st.stats;
+                const auto& abort_counters = st.classifier.counters();
+                std::lock_guard<std::mutex> lock(job.result_mu);
+                GenerateRunResult& r = job.partial;
+                r.rejected += s.rejected;
+                r.reject_prefilter += s.reject_prefilter;
+                r.reject_logic += s.reject_logic;
+                r.reject_uniqueness += s.reject_uniqueness;
+                r.reject_strategy += s.reject_strategy;
+                r.reject_replay += s.reject_replay;
+                r.reject_distribution_bias += s.reject_distribution_bias;
+                r.reject_uniqueness_budget += s.reject_uniqueness_budget;
+                r.uniqueness_calls += s.uniqueness_calls;
+                r.uniqueness_nodes += s.uniqueness_nodes;
+                r.uniqueness_elapsed_ms += s.uniqueness_elapsed_ms;
+                r.kernel_calls += s.kernel_calls;
+                r.kernel_time_ms += s.kernel_time_ms;
+                r.logic_steps_total += s.logic_steps_total;
+                r.strategy_naked_use += s.strategy_naked_use;
+                r.strategy_naked_hit += s.strategy_naked_hit;
+                r.strategy_hidden_use += s.strategy_hidden_use;
+                r.strategy_hidden_hit += s.strategy_hidden_hit;
+                r.mcts_advanced_evals += s.mcts_advanced_evals;
+                r.certifier_required_strategy_analyzed += s.certifier_required_strategy_analyzed;
+                r.certifier_required_strategy_use += s.certifier_required_strategy_use;
+                r.certifier_required_strategy_hit += s.certifier_required_strategy_hit;
+                r.mcts_required_strategy_analyzed += s.mcts_required_strategy_analyzed;
+                r.mcts_required_strategy_use += s.mcts_required_strategy_use;
+                r.mcts_required_strategy_hit += s.mcts_required_strategy_hit;
+                r.pattern_exact_template_used += s.pattern_exact_template_used;
+                r.pattern_family_fallback_used += s.pattern_family_fallback_used;
+                r.required_strategy_exact_contract_met += s.required_strategy_exact_contract_met;
+                r.early_abort_checkpoints += abort_counters.checkpoints;
+                r.early_abort_aborted += abort_counters.aborted;
+                r.early_abort_audits += abort_counters.audits;
+                r.early_abort_audit_false_negatives += abort_counters.audit_false_negatives;
+
+                const generator::BudgetSettings& inc = st.budget_ctl.incumbent();
+                if (job.adaptive_budget && st.budget_ctl.epochs() >= 2 && inc.rate > 0.0 &&
+                    (!job.has_best_budget || inc.rate > job.best_budget.rate)) {
+                    job.best_budget = inc;
+                    job.has_best_budget = true;
+                }
+                log_info(
+                    "jobs.worker",
+                    "worker=" + std::to_string(worker_idx) +
+                    " job=" + job.name +
+                    " attempts=" + std::to_string(st.local_attempts) +
+                    " last_seed=" + std::to_string(st.attempt_seed));
+            }
+
+            if (monitor != nullptr) {
+                WorkerRow row{};
+                row.applied = worker_attempts;
+                row.status = WorkerStatus::Done;
+                monitor->set_worker_row(static_cast<size_t>(worker_idx), row);
+            }
+        });
+    }
+
+    for (auto& t : workers) {
+        if (t.joinable()) t.join();
+    }
+    const auto t_end = steady_clock::now();
+    log_info("jobs", "all workers joined");
+
+    for (int j = 0; j < job_count; ++j) {
+        JobSlot& job = *jobs[static_cast<size_t>(j)];
+        JobRunResult& jr = out[static_cast<size_t>(j)];
+        jr.cfg = job.cfg;
+        jr.valid = job.valid;
+        GenerateRunResult& r = jr.result;
+        r = job.partial;
+        r.cpu_backend_selected = job.cfg.cpu_backend;
+        r.measurement_profile = detect_measurement_profile(job.cfg);
+        if (!job.valid) {
+            r.reject_logic = 1;
+            r.rejected = 1;
+            continue;
+        }
+        r.effective_min_clues = job.cfg.min_clues;
+        r.effective_max_clues = job.cfg.max_clues;
+        r.accepted = job.accepted.load(std::memory_order_relaxed);
+        r.written = job.written.load(std::memory_order_relaxed);
+        r.attempts = job.attempts.load(std::memory_order_relaxed);
+        r.uniqueness_avg_ms = (r.uniqueness_calls > 0)
+            ? (r.uniqueness_elapsed_ms / static_cast<double>(r.uniqueness_calls))
+            : 0.0;
+        if (job.started) {
+            const auto end_tp = job.done.load(std::memory_order_relaxed) ? job.end_tp : t_end;
+            r.elapsed_s = duration_cast<duration<double>>(end_tp - job.start_tp).count();
+        }
+        finalize_run_result(r, job.cfg);
+
+        if (job.has_best_budget && !job.budget_profile_path.empty()) {
+            generator::save_budget_profile(job.budget_profile_path, job.budget_key, job.best_budget);
+        }
+        log_info(
+            "jobs",
+            "done job=" + job.name +
+            " accepted=" + std::to_string(r.accepted) +
+            " written=" + std::to_string(r.written) +
+            " attempts=" + std::to_string(r.attempts) +
+            " pool_cpu_s=" + std::to_string(static_cast<double>(job.cpu_ns) * 1e-9) +
+            " elapsed_s=" + std::to_string(r.elapsed_s));
+    }
+
+    if (monitor != nullptr) {
+        monitor->set_accepted(total_accepted.load(std::memory_order_relaxed));
+        monitor->set_background_status("job queue done accepted=" + std::to_string(total_accepted.load(std::memory_order_relaxed)));
+    }
+    return out;
+}
+
+} // namespace sudoku_hpc
@@ -11,12 +11,14 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cstdint>
 #include <random>
 #include <span>
 #include <vector>
 
+#include "dig_abort_classifier.h"
 #include "mcts_node.h"
 #include "mcts_ucb_policy.h"
 
@@ -25,6 +27,8 @@
 #include "../../config/run_config.h"
 #include "../../utils/logging.h"
 #include "../core_engines/dlx_solver.h" // GenericUniquenessCounter
+#include "../core_engines/batch_lockstep_solver.h"
+#include "../post_processing/replay_validator.h" // UniquenessProof
 #include "../../logic/sudoku_logic_engine.h" // GenericLogicCertify i GenericLogicCertifyResult
 
 namespace sudoku_hpc::mcts_digger {
@@ -55,10 +59,128 @@ inline const char* mcts_termination_reason_label(int code) {
     case 3: return "fail-cap";
     case 4: return "iter-cap";
     case 5: return "logic-timeout";
+    case 6: return "early-abort";
     default: return "unknown";
     }
 }
 
+// Limit iteracji pętli MCTS, gdy cfg.mcts_digger_iterations == 0.
+inline int mcts_default_iteration_cap(const GenericTopology& topo) {
+    return std::max(256, topo.nn * 8);
+}
+
+// Werdykty usuwalności pojedynczych komórek dla małych geometrii (n <= 12), liczone
+// wsadowo w BatchLockstepCounter. Brak unikalności po usunięciu komórki jest trwały
+// w obrębie kopania (kolejne usunięcia tylko dokładają rozwiązań); werdykt "unikalna"
+// jest ważny do następnego zatwierdzonego usunięcia (epoka).
+struct MctsRemovalScreen {
+    static constexpr int kLanes = core_engines::BatchLockstepCounter::kLanes;
+    static constexpr int kMaxNN = core_engines::BatchLockstepCounter::kMaxNN;
+
+    core_engines::BatchLockstepCounter batch;
+    std::array<uint8_t, kMaxNN> non_removable{};
+    std::array<uint32_t, kMaxNN> unique_epoch{};
+    uint32_t epoch = 1;
+
+    std::array<std::array<uint16_t, kMaxNN>, kLanes> lane_puzzle{};
+    std::array<std::span<const uint16_t>, kLanes> lane_span{};
+    std::array<int, kLanes> lane_cell{};
+    std::array<int, kLanes> lane_count{};
+
+    // Poniżej 8x8 skalarne DLX jest tańsze od samego załadowania wsadu.
+    static bool applicable(const GenericTopology& topo) {
+        return topo.n >= 8 && core_engines::BatchLockstepCounter::applicable(topo);
+    }
+
+    void reset(int nn) {
+        std::fill_n(non_removable.data(), nn, uint8_t{0});
+        std::fill_n(unique_epoch.data(), nn, 0U);
+        epoch = 1;
+    }
+
+    void on_accept() {
+        ++epoch;
+    }
+};
+
+inline MctsRemovalScreen& tls_mcts_removal_screen() {
+    thread_local MctsRemovalScreen s;
+    return s;
+}
+
+// Zamiennik count_solutions_limit2 dla usunięcia idx (i sym_idx przy parze), już
+// wyzerowanych w out_puzzle. Przy `speculate` wolne pasy wsadu sprawdzają inne aktywne
+// komórki tej samej planszy (tylko propagacją lock-step, bez szukania) - opłaca się,
+// gdy plansza stoi w miejscu po odrzuceniach. Bez tego zwykłe liczenie skalarne.
+inline int mcts_screened_count_solutions2(
+    std::span<const uint16_t> out_puzzle,
+    const GenericTopology& topo,
+    const GenericUniquenessCounter& uniq,
+    SearchAbortControl* budget,
+    MctsRemovalScreen& screen,
+    const MctsNodeScratch& sc,
+    int idx,
+    int sym_idx,
+    bool remove_pair,
+    uint16_t old_a,
+    uint16_t old_b,
+    bool speculate) {
+    if (screen.non_removable[static_cast<size_t>(idx)] != 0 ||
+        (remove_pair && screen.non_removable[static_cast<size_t>(sym_idx)] != 0)) {
+        return 2;
+    }
+    if (!remove_pair && screen.unique_epoch[static_cast<size_t>(idx)] == screen.epoch) {
+        return 1;
+    }
+    if (!speculate) {
+        return uniq.count_solutions_limit2(out_puzzle, topo, budget);
+    }
+
+    const size_t nn = static_cast<size_t>(topo.nn);
+    std::copy_n(out_puzzle.data(), nn, screen.lane_puzzle[0].data());
+    screen.lane_span[0] = std::span<const uint16_t>(screen.lane_puzzle[0].data(), nn);
+    screen.lane_cell[0] = remove_pair ? -1 : idx;
+    int lanes = 1;
+    for (int i = 0; i < sc.active_count && lanes < MctsRemovalScreen::kLanes; ++i) {
+        const int cell = sc.active_cells[static_cast<size_t>(i)];
+        if (cell < 0 || cell == idx || (remove_pair && cell == sym_idx)) continue;
+        if (out_puzzle[static_cast<size_t>(cell)] == 0 ||
+            screen.non_removable[static_cast<size_t>(cell)] != 0 ||
+            screen.unique_epoch[static_cast<size_t>(cell)] == screen.epoch) {
+            continue;
+        }
+        std::array<uint16_t, MctsRemovalScreen::kMaxNN>& lane = screen.lane_puzzle[static_cast<size_t>(lanes)];
+        std::copy_n(out_puzzle.data(), nn, lane.data());
+        lane[static_cast<size_t>(idx)] = old_a;
+        if (remove_pair) lane[static_cast<size_t>(sym_idx)] = old_b;
+        lane[static_cast<size_t>(cell)] = 0;
+        screen.lane_span[static_cast<size_t>(lanes)] = std::span<const uint16_t>(lane.data(), nn);
+        screen.lane_cell[static_cast<size_t>(lanes)] = cell;
+        ++lanes;
+    }
+
+    const bool ok = screen.batch.count_solutions_limit_batch(
+        std::span<const std::span<const uint16_t>>(screen.lane_span.data(), static_cast<size_t>(lanes)),
+        topo,
+        2,
+        uniq,
+        std::span<int>(screen.lane_count.data(), static_cast<size_t>(lanes)),
+        budget,
+        1);
+    if (!ok) return -1;
+    for (int l = 0; l < lanes; ++l) {
+        const int cell = screen.lane_cell[static_cast<size_t>(l)];
+        const int count = screen.lane_count[static_cast<size_t>(l)];
+        if (cell < 0 || count < 0) continue;
+        if (count == 1) {
+            screen.unique_epoch[static_cast<size_t>(cell)] = screen.epoch;
+        } else if (count >= 2) {
+            screen.non_removable[static_cast<size_t>(cell)] = 1;
+        }
+    }
+    return screen.lane_count[0];
+}
+
 inline int select_seeded_high_clue_action(
     const MctsNodeScratch& sc,
     std::mt19937_64& rng,
@@ -929,6 +1051,12 @@ public:
         int final_active_count = 0;
         int protected_count = 0;
         int termination_reason = 0;
+        // Każde zaakceptowane usunięcie przeszło count == 1, a odrzucone są cofane,
+        // więc plansza zwrócona z sukcesem ma udowodnioną unikalność - token wiąże
+        // dowód z hashem dokładnie tej planszy (out_puzzle w chwili zakończenia).
+        post_processing::UniquenessProof uniq_proof{};
+        // Przerwane w punkcie kontrolnym przez DigAbortClassifier.
+        bool early_aborted = false;
     };
 
     // Przeprowadza proces "kopania" na gotowej planszy (solved)
@@ -980,6 +1108,9 @@ public:
         // Reset bufora MCTS (Zero-Allocation)
         MctsNodeScratch& sc = tls_mcts_node_scratch();
         sc.reset(topo.nn);
+        const bool use_removal_screen = MctsRemovalScreen::applicable(topo);
+        MctsRemovalScreen& removal_screen = tls_mcts_removal_screen();
+        if (use_removal_screen) removal_screen.reset(topo.nn);
 
         // Aktywacja wszystkich niechronionych komórek
         for (int idx = 0; idx < topo.nn; ++idx) {
@@ -1065,7 +1196,7 @@ public:
 
         int clues = topo.nn;
         int fail_streak = 0;
-        const int iter_cap = (cfg.mcts_digger_iterations > 0) ? cfg.mcts_digger_iterations : std::max(256, topo.nn * 8);
+        const int iter_cap = (cfg.mcts_digger_iterations > 0) ? cfg.mcts_digger_iterations : mcts_default_iteration_cap(topo);
         const int basic_level = std::clamp(cfg.mcts_basic_logic_level, 1, 5);
         const double ucb_c = std::clamp(cfg.mcts_ucb_c, 0.1, 4.0);
         
@@ -1114,6 +1245,22 @@ public:
             }
         }
 
+        // Punkt kontrolny wczesnego przerwania: 1/4 usunięć do celu za nami. Później
+        // cechy niewiele zyskują na trafności, a do zaoszczędzenia zostaje mniej kopania.
+        DigAbortClassifier* abort_clf = nullptr;
+        if (cfg.early_abort_ratio > 0.0) {
+            abort_clf = &tls_dig_abort_classifier();
+            abort_clf->bind(cfg, topo.n);
+        }
+        const int abort_checkpoint_clues = topo.nn - (topo.nn - target_clues) / 4;
+        bool abort_checkpoint_done = false;
+        DigAbortClassifier::DigState abort_state{};
+        abort_state.target_clues = target_clues;
+        abort_state.min_clues = min_clues;
+        abort_state.max_clues = max_clues;
+        abort_state.exact_pattern = exact_pattern;
+        abort_state.anchor_count = pattern_anchor_count;
+
         // Główna pętla MCTS
         for (int iter = 0; iter < iter_cap; ++iter) {
             if (stats != nullptr) stats->iterations = iter + 1;
@@ -1205,7 +1352,12 @@ public:
             if (remove_pair) out_puzzle[static_cast<size_t>(sym_idx)] = 0;
 
             // Odrzucenie: brak unikalności (wielokrotne rozwiązania)
-            const int solutions = uniq.count_solutions_limit2(out_puzzle, topo, budget);
+            const int solutions = use_removal_screen
+                ? mcts_screened_count_solutions2(
+                      std::span<const uint16_t>(out_puzzle.data(), out_puzzle.size()),
+                      topo, uniq, budget, removal_screen, sc, idx, sym_idx, remove_pair, old_a, old_b,
+                      fail_streak > 0)
+                : uniq.count_solutions_limit2(out_puzzle, topo, budget);
             if (solutions < 0) { // Timeout w DLX
                 out_puzzle[static_cast<size_t>(idx)] = old_a;
                 if (remove_pair) out_puzzle[static_cast<size_t>(sym_idx)] = old_b;
@@ -1225,6 +1377,7 @@ public:
                 }
                 
                 ++fail_streak;
+                ++abort_state.rejected;
                 if (stats != nullptr) ++stats->rejected_uniqueness;
                 continue;
             }
@@ -1405,6 +1558,10 @@ public:
                     }
 
                     ++fail_streak;
+                    ++abort_state.rejected;
+                    ++abort_state.advanced_evals;
+                    abort_state.advanced_hits += p7_hits + p8_hits;
+                    abort_state.required_uses += required_uses;
                     if (stats != nullptr) {
                         ++stats->advanced_evals;
                         stats->advanced_p7_hits += p7_hits;
@@ -1425,6 +1582,9 @@ public:
                     stopping_signal = (!basic_solved || advanced_signal || required_uses > 0);
                 }
 
+                ++abort_state.advanced_evals;
+                abort_state.advanced_hits += p7_hits + p8_hits;
+                abort_state.required_uses += required_uses;
                 if (stats != nullptr) {
                     ++stats->advanced_evals;
                     stats->advanced_p7_hits += p7_hits;
@@ -1444,6 +1604,7 @@ public:
             // Zatwierdzenie modyfikacji
             clues -= removal;
             fail_streak = 0;
+            if (use_removal_screen) removal_screen.on_accept();
             
             if (stats != nullptr) {
                 stats->accepted_removals += removal;
@@ -1451,6 +1612,23 @@ public:
                     stats->bottleneck_hit = true;
                 }
             }
+            ++abort_state.accepted_steps;
+            if (!basic_solved) ++abort_state.stalled_steps;
+            abort_state.reward_ema = 0.8 * abort_state.reward_ema + 0.2 * reward;
+
+            if (abort_clf != nullptr && !abort_checkpoint_done && clues <= abort_checkpoint_clues) {
+                abort_checkpoint_done = true;
+                abort_state.iterations = iter + 1;
+                const DigAbortClassifier::Features features = DigAbortClassifier::make_features(
+                    abort_state, topo, std::span<const uint16_t>(out_puzzle.data(), out_puzzle.size()));
+                if (abort_clf->checkpoint(features, cfg)) {
+                    if (stats != nullptr) {
+                        stats->early_aborted = true;
+                        stats->termination_reason = 6;
+                    }
+                    return false;
+                }
+            }
 
             // Osiągnięcie celu - wcześniejsze wyjście dla optymalizacji czasowej
             if (stopping_signal && clues <= max_clues && clues >= min_clues) {
@@ -1464,6 +1642,9 @@ public:
             stats->final_fail_streak = fail_streak;
             stats->final_active_count = sc.active_count;
             stats->termination_reason = termination_reason;
+            stats->uniq_proof = post_processing::make_uniqueness_proof(
+                post_processing::UniquenessProofStage::Dig,
+                std::span<const uint16_t>(out_puzzle.data(), out_puzzle.size()));
         }
         if (trace_required_contract) {
             std::ostringstream oss;
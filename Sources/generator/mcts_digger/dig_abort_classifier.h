@@ -0,0 +1,299 @@
+// ============================================================================
+// SUDOKU HPC - MCTS DIGGER
+// Moduł: dig_abort_classifier.h
+// Opis: Klasyfikator wczesnego przerwania próby. W punkcie kontrolnym kopania
+//       (1/4 usunięć do celu) cechy już policzone przez digger - docelowa liczba
+//       wskazówek, stan utknięcia logiki basic, gęstość kandydatów, trend nagrody
+//       MCTS, trafienia P7/P8, plan wzorca - po standaryzacji online trafiają do
+//       regresji logistycznej uczonej wynikiem całej próby (akceptacja /
+//       odrzucenie). Próby z przewidywaną szansą
+//       poniżej ratio * bazowa stopa akceptacji kończą się od razu. Co N-ta
+//       decyzja o przerwaniu jest audytem: próba idzie dalej, a jej akceptacja
+//       liczy się jako fałszywy negatyw. Stan per wątek, zero-allocation.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+
+#include "../../config/run_config.h"
+#include "../../core/geometry.h"
+
+namespace sudoku_hpc::mcts_digger {
+
+class DigAbortClassifier {
+public:
+    static constexpr int kFeatures = 10;
+    using Features = std::array<double, kFeatures>;
+
+    // Próbka czekająca na wynik próby - odkładana razem z próbą przeplataną
+    // (attempt_interleaver.h), żeby etykieta trafiła do właściwych cech.
+    struct PendingSample {
+        bool active = false;
+        bool audit = false;
+        double weight = 1.0;
+        Features x{};
+    };
+
+    // Przed progiem model tylko się uczy; przerwania wymagają też minimum trafień,
+    // inaczej przy stopie akceptacji ~0 model odrzucałby wszystko.
+    static constexpr uint64_t kMinSamples = 256;
+    static constexpr uint64_t kMinPositives = 8;
+
+    // Stan kopania w punkcie kontrolnym; wszystko poza gęstością kandydatów digger ma już policzone.
+    struct DigState {
+        int target_clues = 0;
+        int min_clues = 0;
+        int max_clues = 0;
+        int accepted_steps = 0;
+        int stalled_steps = 0;
+        int iterations = 0;
+        int rejected = 0;
+        int advanced_evals = 0;
+        int advanced_hits = 0;
+        int required_uses = 0;
+        double reward_ema = 0.0;
+        bool exact_pattern = false;
+        int anchor_count = 0;
+    };
+
+    struct Counters {
+        uint64_t checkpoints = 0;
+        uint64_t aborted = 0;
+        uint64_t audits = 0;
+        uint64_t audit_false_negatives = 0;
+    };
+
+    // Nowa geometria lub kontrakt trudności = nowy model.
+    void bind(const GenerateRunConfig& cfg, int n) {
+        if (bound_ && n == n_ && cfg.difficulty_level_required == difficulty_ &&
+            cfg.required_strategy == required_) {
+            return;
+        }
+        *this = DigAbortClassifier{};
+        bound_ = true;
+        n_ = n;
+        difficulty_ = cfg.difficulty_level_required;
+        required_ = cfg.required_strategy;
+    }
+
+    // Cechy surowe, ~[0, 1]; x[0] to wyraz wolny. Skalę wyrównuje standardize().
+    static Features make_features(const DigState& s, const GenericTopology& topo, std::span<const uint16_t> puzzle) {
+        Features x{};
+        const auto ratio = [](double v) { return v / (1.0 + v); };
+        x[0] = 1.0;
+        x[1] = static_cast<double>(s.target_clues - s.min_clues) /
+               static_cast<double>(std::max(1, s.max_clues - s.min_clues));
+        x[2] = (s.stalled_steps > 0) ? 1.0 : 0.0;
+        x[3] = static_cast<double>(s.stalled_steps) / static_cast<double>(std::max(1, s.accepted_steps));
+        x[4] = ratio(static_cast<double>(s.advanced_hits) / static_cast<double>(std::max(1, s.advanced_evals)));
+        x[5] = ratio(std::max(0.0, s.reward_ema) / 20.0);
+        x[6] = static_cast<double>(s.rejected) / static_cast<double>(std::max(1, s.iterations));
+        x[7] = candidate_density(topo, puzzle);
+        x[8] = 0.5 * (s.exact_pattern ? 1.0 : 0.0) + 0.5 * std::min(1.0, static_cast<double>(s.anchor_count) / 8.0);
+        x[9] = ratio(static_cast<double>(s.required_uses));
+        return x;
+    }
+
+    double predict(const Features& x) const {
+        double z = 0.0;
+        for (int i = 0; i < kFeatures; ++i) z += weights_[static_cast<size_t>(i)] * x[static_cast<size_t>(i)];
+        return 1.0 / (1.0 + std::exp(-std::clamp(z, -30.0, 30.0)));
+    }
+
+    bool ready() const {
+        return samples_ >= kMinSamples && positives_ >= kMinPositives;
+    }
+
+    // Ważona estymata stopy akceptacji w punkcie kontrolnym: audyty reprezentują
+    // też przerwane próby, więc filtr nie zawyża bazy (i progu) z czasem.
+    double base_rate() const {
+        return (weighted_samples_ > 0.0) ? (weighted_positives_ / weighted_samples_) : 0.0;
+    }
+
+    // Decyzja w punkcie kontrolnym. true = przerwać próbę teraz.
+    bool checkpoint(const Features& raw, const GenerateRunConfig& cfg) {
+        ++counters_.checkpoints;
+        const Features x = standardize(raw);
+        pending_ = true;
+        pending_x_ = x;
+        pending_audit_ = false;
+        pending_weight_ = 1.0;
+        if (cfg.early_abort_ratio <= 0.0 || !ready()) return false;
+        if (predict(x) >= cfg.early_abort_ratio * base_rate()) return false;
+
+        const uint64_t audit_every = static_cast<uint64_t>(std::max(0, cfg.early_abort_audit_every));
+        if (audit_every > 0 && (++abort_decisions_ % audit_every) == 0) {
+            ++counters_.audits;
+            pending_audit_ = true;
+            pending_weight_ = static_cast<double>(audit_every);
+            return false;
+        }
+        ++counters_.aborted;
+        pending_ = false;
+        return true;
+    }
+
+    // Wynik próby, która minęła punkt kontrolny. Bez oczekującej próbki nic nie robi.
+    void resolve(bool accepted) {
+        if (!pending_) return;
+        pending_ = false;
+        if (pending_audit_ && accepted) ++counters_.audit_false_negatives;
+
+        ++samples_;
+        if (accepted) ++positives_;
+        weighted_samples_ += pending_weight_;
+        if (accepted) weighted_positives_ += pending_weight_;
+
+        // SGD na log-loss z lekką regularyzacją L2 (bez wyrazu wolnego). Krok ważony
+        // odwrotnością prawdopodobieństwa próbki (audyt = N przerwanych prób), jak
+        // base_rate - inaczej model uczy się tylko na próbach, które przepuścił.
+        // Krok przycięty, żeby pojedynczy audyt nie rozhuśtał wag.
+        const double err = (accepted ? 1.0 : 0.0) - predict(pending_x_);
+        const double step = std::min(kLearningRate * pending_weight_, kMaxStep);
+        for (int i = 0; i < kFeatures; ++i) {
+            double& w = weights_[static_cast<size_t>(i)];
+            const double l2 = (i == 0) ? 0.0 : kL2 * w;
+            w += step * (err * pending_x_[static_cast<size_t>(i)] - l2);
+        }
+    }
+
+    // Próba przerwana z innego powodu (pauza) - etykieta nie jest wiarygodna.
+    void discard_pending() {
+        pending_ = false;
+    }
+
+    PendingSample take_pending() {
+        PendingSample s{pending_, pending_audit_, pending_weight_, pending_x_};
+        pending_ = false;
+        return s;
+    }
+
+    void restore_pending(const PendingSample& s) {
+        pending_ = s.active;
+        pending_audit_ = s.audit;
+        pending_weight_ = s.weight;
+        pending_x_ = s.x;
+    }
+
+    // Szansa akceptacji odłożonej próby; -1 = brak próbki albo model niegotowy.
+    double pending_prediction(const PendingSample& s) const {
+        if (!s.active || !ready()) return -1.0;
+        return predict(s.x);
+    }
+
+    const Counters& counters() const {
+        return counters_;
+    }
+
+    // Checkpoint runu (run_checkpoint.h): model, standaryzacja i liczniki jako
+    // tokeny tekstowe. Oczekująca próbka nie jest zapisywana.
+    void write_state(std::ostream& out) const {
+        out << (bound_ ? 1 : 0) << ' ' << n_ << ' ' << difficulty_ << ' ' << static_cast<int>(required_);
+        for (const double w : weights_) out << ' ' << w;
+        out << ' ' << seen_;
+        for (const double m : mean_) out << ' ' << m;
+        for (const double m : m2_) out << ' ' << m;
+        out << ' ' << samples_ << ' ' << positives_ << ' ' << weighted_samples_ << ' ' << weighted_positives_
+            << ' ' << abort_decisions_ << ' ' << counters_.checkpoints << ' ' << counters_.aborted
+            << ' ' << counters_.audits << ' ' << counters_.audit_false_negatives;
+    }
+
+    bool read_state(std::istream& in) {
+        DigAbortClassifier c{};
+        int bound = 0;
+        int required = 0;
+        in >> bound >> c.n_ >> c.difficulty_ >> required;
+        for (double& w : c.weights_) in >> w;
+        in >> c.seen_;
+        for (double& m : c.mean_) in >> m;
+        for (double& m : c.m2_) in >> m;
+        in >> c.samples_ >> c.positives_ >> c.weighted_samples_ >> c.weighted_positives_
+           >> c.abort_decisions_ >> c.counters_.checkpoints >> c.counters_.aborted
+           >> c.counters_.audits >> c.counters_.audit_false_negatives;
+        if (!in) return false;
+        c.bound_ = bound != 0;
+        c.required_ = static_cast<RequiredStrategy>(required);
+        *this = c;
+        return true;
+    }
+
+private:
+    // Welford na wszystkich punktach kontrolnych (także przerwanych): cechy o wąskim
+    // zakresie (gęstość, trend nagrody) dostają wagę porównywalną z pozostałymi.
+    Features standardize(const Features& raw) {
+        ++seen_;
+        Features x{};
+        x[0] = 1.0;
+        for (int i = 1; i < kFeatures; ++i) {
+            const size_t k = static_cast<size_t>(i);
+            const double delta = raw[k] - mean_[k];
+            mean_[k] += delta / static_cast<double>(seen_);
+            m2_[k] += delta * (raw[k] - mean_[k]);
+            const double var = (seen_ > 1) ? m2_[k] / static_cast<double>(seen_ - 1) : 0.0;
+            x[k] = (var > 1e-12) ? std::clamp((raw[k] - mean_[k]) / std::sqrt(var), -4.0, 4.0) : 0.0;
+        }
+        return x;
+    }
+
+    // Średnia liczba kandydatów pustej komórki / n (tylko eliminacja przez rówieśników).
+    static double candidate_density(const GenericTopology& topo, std::span<const uint16_t> puzzle) {
+        int empty = 0;
+        int total = 0;
+        for (int idx = 0; idx < topo.nn; ++idx) {
+            if (puzzle[static_cast<size_t>(idx)] != 0) continue;
+            uint64_t used = 0;
+            const int p0 = topo.peer_offsets[static_cast<size_t>(idx)];
+            const int p1 = topo.peer_offsets[static_cast<size_t>(idx + 1)];
+            for (int p = p0; p < p1; ++p) {
+                const uint16_t v = puzzle[static_cast<size_t>(topo.peers_flat[static_cast<size_t>(p)])];
+                if (v != 0) used |= (1ULL << (v - 1));
+            }
+            ++empty;
+            total += topo.n - std::popcount(used);
+        }
+        return (empty > 0) ? static_cast<double>(total) / static_cast<double>(empty * topo.n) : 0.0;
+    }
+
+    static constexpr double kLearningRate = 0.05;
+    static constexpr double kMaxStep = 0.4;
+    static constexpr double kL2 = 1e-4;
+
+    bool bound_ = false;
+    int n_ = 0;
+    int difficulty_ = 0;
+    RequiredStrategy required_ = RequiredStrategy::None;
+
+    Features weights_{};
+    uint64_t seen_ = 0;
+    Features mean_{};
+    Features m2_{};
+    uint64_t samples_ = 0;
+    uint64_t positives_ = 0;
+    double weighted_samples_ = 0.0;
+    double weighted_positives_ = 0.0;
+    uint64_t abort_decisions_ = 0;
+
+    bool pending_ = false;
+    bool pending_audit_ = false;
+    double pending_weight_ = 1.0;
+    Features pending_x_{};
+
+    Counters counters_{};
+};
+
+inline DigAbortClassifier& tls_dig_abort_classifier() {
+    thread_local DigAbortClassifier c;
+    return c;
+}
+
+} // namespace sudoku_hpc::mcts_digger
@@ -1,7 +1,8 @@
 // ============================================================================
 // SUDOKU HPC - POST PROCESSING
 // Moduł: replay_validator.h
-// Opis: Walidacja rozwiązania po procesie "kopania" (Replay Validation)
+// Opis: Walidacja rozwiązania po procesie "kopania" (Replay Validation),
+//       token dowodu unikalności przenoszony między etapami generatora
 //       oraz sprzętowo optymalizowane (64-bitowe) hashowanie FNV-1a.
 // ============================================================================
 //Author copyright Marcin Matysek (Rewertyn)
@@ -10,6 +11,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include "../../core/board.h"
@@ -56,27 +58,51 @@ inline uint64_t fnv1a64_bytes(const void* data, size_t len, uint64_t seed = 1469
 }
 
 // Hashowanie zoptymalizowane dla wektorów cyfr Sudoku (uint16_t)
-inline uint64_t hash_u16_vector(const std::vector<uint16_t>& data, uint64_t seed = 1469598103934665603ULL) {
+inline uint64_t hash_u16_span(std::span<const uint16_t> data, uint64_t seed = 1469598103934665603ULL) {
     if (data.empty()) return seed;
     return fnv1a64_bytes(data.data(), data.size() * sizeof(uint16_t), seed);
 }
 
-// Funkcja wykonująca pełne przejście kontrolne z weryfikacją poprawności
-// oraz budująca "Trace Hash" ze statystyk użytych strategii.
-inline ReplayValidationResult run_replay_validation(
+inline uint64_t hash_u16_vector(const std::vector<uint16_t>& data, uint64_t seed = 1469598103934665603ULL) {
+    return hash_u16_span(data, seed);
+}
+
+// Który etap udowodnił unikalność danego zestawu wskazówek.
+enum class UniquenessProofStage : uint8_t {
+    None = 0,
+    Dig = 1,   // ostatnie zaakceptowane usunięcie w diggerze (count == 1)
+    Count = 2, // liczenie DLX w ETAPIE 6
+};
+
+// Token dowodu unikalności: ważny tylko dla planszy o identycznym hashu wskazówek.
+// Każda zmiana planszy po dowodzie unieważnia token i wymusza ponowne liczenie.
+struct UniquenessProof {
+    UniquenessProofStage stage = UniquenessProofStage::None;
+    uint64_t puzzle_hash = 0;
+
+    bool covers(const std::vector<uint16_t>& puzzle) const {
+        return stage != UniquenessProofStage::None && puzzle_hash == hash_u16_vector(puzzle);
+    }
+};
+
+inline UniquenessProof make_uniqueness_proof(UniquenessProofStage stage, std::span<const uint16_t> puzzle) {
+    return UniquenessProof{stage, hash_u16_span(puzzle)};
+}
+
+// Werdykt replay z gotowego wyniku certyfikacji tej samej planszy (z capture_solution_grid).
+// Certyfikacja jest deterministyczna, więc drugie przejście dałoby ten sam wynik.
+inline ReplayValidationResult replay_validation_from_certify(
     const std::vector<uint16_t>& puzzle,
     const std::vector<uint16_t>& expected_solution,
-    const GenericTopology& topo,
-    const logic::GenericLogicCertify& logic) {
-    
+    const logic::GenericLogicCertifyResult& replay) {
+
     ReplayValidationResult out{};
     
     // 1. Hash wejścia i wzorca
     out.puzzle_hash = hash_u16_vector(puzzle);
     out.expected_solution_hash = hash_u16_vector(expected_solution);
     
-    // 2. Symulacja logiczna na "czysto" (Replay)
-    const logic::GenericLogicCertifyResult replay = logic.certify(puzzle, topo, nullptr, true);
+    // 2. Wynik symulacji logicznej
     out.solved = replay.solved;
     out.replay_solution_hash = hash_u16_vector(replay.solved_grid);
 
@@ -99,4 +125,17 @@ inline ReplayValidationResult run_replay_validation(
     return out;
 }
 
+// Funkcja wykonująca pełne przejście kontrolne z weryfikacją poprawności
+// oraz budująca "Trace Hash" ze statystyk użytych strategii.
+inline ReplayValidationResult run_replay_validation(
+    const std::vector<uint16_t>& puzzle,
+    const std::vector<uint16_t>& expected_solution,
+    const GenericTopology& topo,
+    const logic::GenericLogicCertify& logic) {
+    
+    // Symulacja logiczna na "czysto" (Replay)
+    const logic::GenericLogicCertifyResult replay = logic.certify(puzzle, topo, nullptr, true);
+    return replay_validation_from_certify(puzzle, expected_solution, replay);
+}
+
 } // namespace sudoku_hpc::post_processing
\ No newline at end of file
@@ -0,0 +1,266 @@
+// ============================================================================
+// SUDOKU HPC - GENERATOR PIPELINE
+// Moduł: run_checkpoint.h
+// Opis: Checkpoint długiego runu: liczniki, czas, strumienie seedów workerów i
+//       stan uczony per wątek (klasyfikator wczesnego przerwania, stan mutacji
+//       wzorca, ustawienia kontrolera budżetów). Plik tekstowy obok pliku
+//       wyjściowego, zapisywany atomowo (tmp + rename). --resume wczytuje go,
+//       liczbę zaakceptowanych bierze z pliku wyjściowego i kontynuuje run.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "../config/run_config.h"
+#include "budget_controller.h"
+#include "mcts_digger/dig_abort_classifier.h"
+#include "pattern_forcing/pattern_planter_types.h"
+
+namespace sudoku_hpc::generator {
+
+inline constexpr int kRunCheckpointVersion = 1;
+
+struct WorkerCheckpoint {
+    bool present = false;
+    uint64_t seed_state = 0;
+    uint64_t attempt_seed = 0;
+    uint64_t local_attempts = 0;
+    // Stan zserializowany przez właściciela (wątek workera).
+    std::string classifier;
+    std::string mutation;
+    bool has_budget = false;
+    BudgetSettings budget{};
+};
+
+struct RunCheckpoint {
+    std::string key;
+    uint64_t resume_count = 0;
+    double elapsed_s = 0.0;
+    std::vector<std::pair<std::string, uint64_t>> counters;
+    std::vector<WorkerCheckpoint> workers;
+
+    uint64_t counter(const std::string& name) const {
+        for (const auto& [k, v] : counters) {
+            if (k == name) return v;
+        }
+        return 0;
+    }
+};
+
+// Run wznawiany musi celować w to samo: geometria, poziom, strategia, seed, plik.
+inline std::string run_checkpoint_key(const GenerateRunConfig& cfg) {
+    return std::to_string(cfg.box_rows) + "x" + std::to_string(cfg.box_cols) +
+           "|L" + std::to_string(cfg.difficulty_level_required) +
+           "|" + std::string(to_string(cfg.required_strategy)) +
+           "|seed=" + std::to_string(cfg.seed) +
+           "|" + cfg.output_file;
+}
+
+inline std::filesystem::path run_checkpoint_path(const GenerateRunConfig& cfg) {
+    return std::filesystem::path(cfg.output_folder) / (cfg.output_file + ".ckpt");
+}
+
+inline void write_template_plan(std::ostream& out, const pattern_forcing::ExactPatternTemplatePlan& plan) {
+    out << ' ' << (plan.valid ? 1 : 0) << ' ' << (plan.explicit_skeleton ? 1 : 0) << ' ' << plan.anchor_count;
+    for (int i = 0; i < plan.anchor_count; ++i) {
+        out << ' ' << plan.anchor_idx[static_cast<size_t>(i)] << ' ' << plan.anchor_masks[static_cast<size_t>(i)];
+    }
+    out << ' ' << plan.skeleton_count;
+    for (int i = 0; i < plan.skeleton_count; ++i) {
+        out << ' ' << plan.skeleton_idx[static_cast<size_t>(i)] << ' ' << plan.skeleton_masks[static_cast<size_t>(i)];
+    }
+}
+
+inline bool read_template_plan(std::istream& in, pattern_forcing::ExactPatternTemplatePlan& plan) {
+    plan = {};
+    int valid = 0;
+    int explicit_skeleton = 0;
+    in >> valid >> explicit_skeleton >> plan.anchor_count;
+    if (!in || plan.anchor_count < 0 || plan.anchor_count > static_cast<int>(plan.anchor_idx.size())) return false;
+    for (int i = 0; i < plan.anchor_count; ++i) {
+        in >> plan.anchor_idx[static_cast<size_t>(i)] >> plan.anchor_masks[static_cast<size_t>(i)];
+    }
+    in >> plan.skeleton_count;
+    if (!in || plan.skeleton_count < 0 || plan.skeleton_count > static_cast<int>(plan.skeleton_idx.size())) return false;
+    for (int i = 0; i < plan.skeleton_count; ++i) {
+        in >> plan.skeleton_idx[static_cast<size_t>(i)] >> plan.skeleton_masks[static_cast<size_t>(i)];
+    }
+    plan.valid = valid != 0;
+    plan.explicit_skeleton = explicit_skeleton != 0;
+    return static_cast<bool>(in);
+}
+
+inline std::string serialize_mutation_state(const pattern_forcing::PatternMutationState& s) {
+    std::ostringstream out;
+    out << static_cast<int>(s.strategy) << ' ' << static_cast<int>(s.kind)
+        << ' ' << (s.have_last ? 1 : 0) << ' ' << (s.have_best ? 1 : 0)
+        << ' ' << s.last_score << ' ' << s.best_score
+        << ' ' << s.failure_streak << ' ' << s.zero_use_streak;
+    if (s.have_last) write_template_plan(out, s.last_plan);
+    if (s.have_best) write_template_plan(out, s.best_plan);
+    return out.str();
+}
+
+inline bool deserialize_mutation_state(const std::string& text, pattern_forcing::PatternMutationState& out_state) {
+    std::istringstream in(text);
+    pattern_forcing::PatternMutationState s{};
+    int strategy = 0;
+    int kind = 0;
+    int have_last = 0;
+    int have_best = 0;
+    in >> strategy >> kind >> have_last >> have_best >> s.last_score >> s.best_score >> s.failure_streak >> s.zero_use_streak;
+    if (!in) return false;
+    s.strategy = static_cast<RequiredStrategy>(strategy);
+    s.kind = static_cast<pattern_forcing::PatternKind>(kind);
+    s.have_last = have_last != 0;
+    s.have_best = have_best != 0;
+    if (s.have_last && !read_template_plan(in, s.last_plan)) return false;
+    if (s.have_best && !read_template_plan(in, s.best_plan)) return false;
+    out_state = s;
+    return true;
+}
+
+inline std::string serialize_classifier(const mcts_digger::DigAbortClassifier& c) {
+    std::ostringstream out;
+    out << std::setprecision(17);
+    c.write_state(out);
+    return out.str();
+}
+
+inline bool deserialize_classifier(const std::string& text, mcts_digger::DigAbortClassifier& out_classifier) {
+    std::istringstream in(text);
+    return out_classifier.read_state(in);
+}
+
+// Zapis przez plik tymczasowy: przerwany zapis nie niszczy poprzedniego checkpointu.
+inline bool save_run_checkpoint(const std::filesystem::path& path, const RunCheckpoint& ckpt) {
+    const std::filesystem::path tmp_path = path.string() + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::out | std::ios::trunc);
+        if (!out) return false;
+        out << std::setprecision(17);
+        out << "# sudoku_hpc run checkpoint\n";
+        out << "version " << kRunCheckpointVersion << "\n";
+        out << "key " << ckpt.key << "\n";
+        out << "resume_count " << ckpt.resume_count << "\n";
+        out << "elapsed_s " << ckpt.elapsed_s << "\n";
+        for (const auto& [name, value] : ckpt.counters) {
+            out << "counter " << name << " " << value << "\n";
+        }
+        for (size_t w = 0; w < ckpt.workers.size(); ++w) {
+            const WorkerCheckpoint& wc = ckpt.workers[w];
+            if (!wc.present) continue;
+            out << "worker " << w << " " << wc.seed_state << " " << wc.attempt_seed << " " << wc.local_attempts << "\n";
+            out << "worker_classifier " << w << " " << wc.classifier << "\n";
+            out << "worker_mutation " << w << " " << wc.mutation << "\n";
+            if (wc.has_budget) {
+                out << "worker_budget " << w << " " << wc.budget.budget_scale << " " << wc.budget.pattern_tries_scale
+                    << " " << wc.budget.mcts_iterations_scale << " " << wc.budget.rate << "\n";
+            }
+        }
+        out.flush();
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        // Windows: rename nie nadpisuje istniejącego pliku.
+        std::filesystem::remove(path, ec);
+        std::filesystem::rename(tmp_path, path, ec);
+    }
+    return !ec;
+}
+
+inline bool load_run_checkpoint(const std::filesystem::path& path, RunCheckpoint& out_ckpt, std::string* err = nullptr) {
+    std::ifstream in(path);
+    if (!in) {
+        if (err != nullptr) *err = "cannot open checkpoint: " + path.string();
+        return false;
+    }
+
+    RunCheckpoint ckpt{};
+    int version = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream iss(line);
+        std::string tag;
+        iss >> tag;
+        if (tag == "version") {
+            iss >> version;
+        } else if (tag == "key") {
+            std::getline(iss >> std::ws, ckpt.key);
+        } else if (tag == "resume_count") {
+            iss >> ckpt.resume_count;
+        } else if (tag == "elapsed_s") {
+            iss >> ckpt.elapsed_s;
+        } else if (tag == "counter") {
+            std::string name;
+            uint64_t value = 0;
+            if (iss >> name >> value) ckpt.counters.emplace_back(name, value);
+        } else if (tag == "worker" || tag == "worker_classifier" || tag == "worker_mutation" || tag == "worker_budget") {
+            size_t w = 0;
+            if (!(iss >> w) || w >= 4096) continue;
+            if (ckpt.workers.size() <= w) ckpt.workers.resize(w + 1);
+            WorkerCheckpoint& wc = ckpt.workers[w];
+            if (tag == "worker") {
+                wc.present = static_cast<bool>(iss >> wc.seed_state >> wc.attempt_seed >> wc.local_attempts);
+            } else if (tag == "worker_classifier") {
+                std::getline(iss >> std::ws, wc.classifier);
+            } else if (tag == "worker_mutation") {
+                std::getline(iss >> std::ws, wc.mutation);
+            } else {
+                wc.has_budget = static_cast<bool>(
+                    iss >> wc.budget.budget_scale >> wc.budget.pattern_tries_scale >>
+                    wc.budget.mcts_iterations_scale >> wc.budget.rate);
+            }
+        }
+    }
+
+    if (version != kRunCheckpointVersion) {
+        if (err != nullptr) *err = "unsupported checkpoint version " + std::to_string(version);
+        return false;
+    }
+    out_ckpt = std::move(ckpt);
+    return true;
+}
+
+// Zaakceptowane = pełne linie pliku wyjściowego; niedokończona ostatnia linia
+// (przerwany zapis) jest obcinana, żeby wznowiony run dopisywał czysto.
+inline uint64_t reconcile_output_lines(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in) return 0;
+    uint64_t lines = 0;
+    uint64_t complete_bytes = 0;
+    uint64_t bytes = 0;
+    char buf[1 << 16];
+    while (in) {
+        in.read(buf, sizeof(buf));
+        const std::streamsize got = in.gcount();
+        for (std::streamsize i = 0; i < got; ++i) {
+            ++bytes;
+            if (buf[i] == '\n') {
+                ++lines;
+                complete_bytes = bytes;
+            }
+        }
+    }
+    in.close();
+    if (complete_bytes != bytes) {
+        std::error_code ec;
+        std::filesystem::resize_file(path, complete_bytes, ec);
+    }
+    return lines;
+}
+
+} // namespace sudoku_hpc::generator
@@ -1,11 +1,13 @@
 ﻿//Author copyright Marcin Matysek (Rewertyn)
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <random>
 #include <string>
@@ -15,8 +17,15 @@
 #include "../config/run_config.h"
 #include "../core/geometry.h"
 #include "../monitor.h"
+#include "../utils/alloc_counter.h"
 #include "../utils/logging.h"
+#include "../generator/attempt_interleaver.h"
+#include "../generator/budget_controller.h"
+#include "../generator/concurrency/cpu_topology.h"
 #include "../generator/generator_facade.h"
+#include "../generator/run_checkpoint.h"
+#include "../generator/stage_pipeline.h"
+#include "../generator/mcts_digger/dig_abort_classifier.h"
 #include "../generator/post_processing/vip_scoring.h"
 
 namespace sudoku_hpc {
@@ -93,7 +102,9 @@ inline std::string cfg_diag_label(const GenerateRunConfig& cfg) {
         " attempt_time_budget_s=" + std::to_string(cfg.attempt_time_budget_s) +
         " attempt_node_budget=" + std::to_string(cfg.attempt_node_budget) +
         " reseed_interval_s=" + std::to_string(cfg.reseed_interval_s) +
-        " force_new_seed_per_attempt=" + std::string(cfg.force_new_seed_per_attempt ? "1" : "0");
+        " force_new_seed_per_attempt=" + std::string(cfg.force_new_seed_per_attempt ? "1" : "0") +
+        " strategy_tier_policy=" + cfg.strategy_tier_policy +
+        " strategy_work_cap=" + std::to_string(cfg.strategy_work_cap);
 }
 
 inline uint64_t splitmix64_next(uint64_t& state) {
@@ -126,36 +137,15 @@ inline bool should_trace_attempt_diag(
            reason == RejectReason::DistributionBias;
 }
 
-inline GenerateRunResult run_generic_sudoku(
-    const GenerateRunConfig& cfg,
-    ConsoleStatsMonitor* monitor = nullptr,
-    std::atomic<bool>* cancel_flag = nullptr,
-    std::atomic<bool>* pause_flag = nullptr,
-    std::function<void(uint64_t, uint64_t)> on_progress = nullptr,
-    std::function<void(const std::string&)> on_log = nullptr) {
-
-    using namespace std::chrono;
-
-    GenerateRunResult result{};
-    result.cpu_backend_selected = cfg.cpu_backend;
-    result.measurement_profile = detect_measurement_profile(cfg);
-
-    GenericTopology topo;
-    std::string topo_err;
-    if (!build_generic_topology(cfg.box_rows, cfg.box_cols, topo, &topo_err)) {
-        log_error("runner", "invalid geometry: " + topo_err);
-        if (on_log) on_log("invalid geometry: " + topo_err);
-        result.reject_logic = 1;
-        result.rejected = 1;
-        return result;
-    }
-
+// Heurystyki konfiguracji runtime: zakres wskazówek, limity prób i czasu, budżety
+// próby i profil pattern forcing zależne od geometrii i poziomu. Wspólne dla
+// pojedynczego runu i kolejki zadań (job_scheduler.h).
+inline GenerateRunConfig resolve_runtime_config(const GenerateRunConfig& cfg, const GenericTopology& topo) {
     const int n = topo.n;
     const int nn = topo.nn;
     GenerateRunConfig run_cfg = cfg;
     const bool auto_clue_range_requested =
         (run_cfg.min_clues <= 0 || run_cfg.max_clues <= 0 || run_cfg.max_clues < run_cfg.min_clues);
-    const std::string measurement_profile = detect_measurement_profile(run_cfg);
 
     if (run_cfg.min_clues <= 0 || run_cfg.max_clues <= 0 || run_cfg.max_clues < run_cfg.min_clues) {
         const ClueRange auto_range = resolve_auto_clue_range(run_cfg.box_rows, run_cfg.box_cols, run_cfg.difficulty_level_required, run_cfg.required_strategy);
@@ -171,8 +161,6 @@ inline GenerateRunResult run_generic_sudoku(
     }
     run_cfg.min_clues = std::clamp(run_cfg.min_clues, 0, nn);
     run_cfg.max_clues = std::clamp(run_cfg.max_clues, run_cfg.min_clues, nn);
-    result.effective_min_clues = run_cfg.min_clues;
-    result.effective_max_clues = run_cfg.max_clues;
 
     const bool wants_p7_plus = run_cfg.difficulty_level_required >= 7;
     const bool wants_p8 = run_cfg.difficulty_level_required >= 8;
@@ -321,11 +309,164 @@ inline GenerateRunResult run_generic_sudoku(
         run_cfg.attempt_time_budget_s = 0.0;
     }
 
-    const int hw = std::max(1u, std::thread::hardware_concurrency());
-    const int worker_count = std::max(1, run_cfg.threads <= 0 ? hw : run_cfg.threads);
+    return run_cfg;
+}
+
+// Pola pochodne wyniku (efektywność backendu, VIP, sygnatury) - po zsumowaniu
+// liczników i ustawieniu elapsed_s.
+inline void finalize_run_result(GenerateRunResult& result, const GenerateRunConfig& run_cfg) {
+    const double asymmetry_ratio = static_cast<double>(std::max(run_cfg.box_rows, run_cfg.box_cols)) /
+                                   static_cast<double>(std::max(1, std::min(run_cfg.box_rows, run_cfg.box_cols)));
+    result.asymmetry_efficiency_index = asymmetry_ratio;
+    result.backend_efficiency_score = (result.kernel_time_ms > 0.0)
+        ? static_cast<double>(result.accepted) / (result.kernel_time_ms / 1000.0)
+        : 0.0;
+
+    result.accepted_per_sec = (result.elapsed_s > 0.0)
+        ? static_cast<double>(result.accepted) / result.elapsed_s
+        : 0.0;
+
+    const auto vip_target = post_processing::resolve_vip_grade_target_for_geometry(run_cfg);
+    result.vip_score = post_processing::compute_vip_score(result, run_cfg, asymmetry_ratio);
+    result.vip_grade = post_processing::vip_grade_from_score(result.vip_score);
+    result.vip_contract_ok = post_processing::vip_contract_passed(result.vip_score, vip_target);
+    result.vip_contract_fail_reason = result.vip_contract_ok ? "" : ("required=" + vip_target + ", actual=" + result.vip_grade);
+
+    const std::string sig_raw =
+        std::to_string(result.accepted) + ":" +
+        std::to_string(result.written) + ":" +
+        std::to_string(result.attempts) + ":" +
+        std::to_string(result.uniqueness_nodes) + ":" +
+        std::to_string(run_cfg.box_rows) + "x" + std::to_string(run_cfg.box_cols);
+    const size_t h1 = std::hash<std::string>{}(sig_raw);
+    const size_t h2 = std::hash<std::string>{}(sig_raw + ":v2");
+    result.premium_signature = std::to_string(static_cast<unsigned long long>(h1));
+    result.premium_signature_v2 = std::to_string(static_cast<unsigned long long>(h2));
+}
+
+inline GenerateRunResult run_generic_sudoku(
+    const GenerateRunConfig& cfg,
+    ConsoleStatsMonitor* monitor = nullptr,
+    std::atomic<bool>* cancel_flag = nullptr,
+    std::atomic<bool>* pause_flag = nullptr,
+    std::function<void(uint64_t, uint64_t)> on_progress = nullptr,
+    std::function<void(const std::string&)> on_log = nullptr) {
+
+    using namespace std::chrono;
+
+    GenerateRunResult result{};
+    result.cpu_backend_selected = cfg.cpu_backend;
+    result.measurement_profile = detect_measurement_profile(cfg);
+
+    GenericTopology topo;
+    std::string topo_err;
+    if (!build_generic_topology(cfg.box_rows, cfg.box_cols, topo, &topo_err)) {
+        log_error("runner", "invalid geometry: " + topo_err);
+        if (on_log) on_log("invalid geometry: " + topo_err);
+        result.reject_logic = 1;
+        result.rejected = 1;
+        return result;
+    }
+
+    logic::StrategyTierPolicy tier_policy{};
+    if (!logic::GenericLogicCertify::parse_tier_policy(cfg.strategy_tier_policy, tier_policy)) {
+        log_error("runner", "invalid strategy tier policy: " + cfg.strategy_tier_policy);
+        if (on_log) on_log("invalid strategy tier policy: " + cfg.strategy_tier_policy);
+        result.reject_logic = 1;
+        result.rejected = 1;
+        return result;
+    }
+
+    const GenerateRunConfig run_cfg = resolve_runtime_config(cfg, topo);
+    // Jawnie podane budżety/iteracje nie są strojone przez kontroler.
+    const bool user_budget_fixed = cfg.attempt_node_budget != 0 || cfg.attempt_time_budget_s > 0.0;
+    const bool user_iterations_fixed = cfg.mcts_digger_iterations > 0;
+    const std::string measurement_profile = detect_measurement_profile(run_cfg);
+    result.effective_min_clues = run_cfg.min_clues;
+    result.effective_max_clues = run_cfg.max_clues;
+
+    // Heurystyki wyżej to tylko punkt startowy - dalej prowadzi kontroler budżetów.
+    // W trybie potokowym koszt CPU próby rozkłada się na dwa wątki, więc pomiar
+    // kontrolera per worker nie ma sensu - budżety zostają stałe.
+    const bool adaptive_budget = run_cfg.adaptive_budget && !run_cfg.fast_test_mode && run_cfg.pipeline_depth <= 0;
+    const std::string budget_profile_path = run_cfg.budget_profile_file.empty()
+        ? std::string()
+        : (std::filesystem::path(run_cfg.output_folder) / run_cfg.budget_profile_file).string();
+    const std::string budget_key = generator::budget_profile_key(run_cfg);
+    generator::BudgetSettings budget_start{};
+    if (adaptive_budget) {
+        const auto profiles = generator::load_budget_profiles(budget_profile_path);
+        const auto it = profiles.find(budget_key);
+        if (it != profiles.end()) {
+            budget_start = it->second;
+            log_info(
+                "runner.budget",
+                "profile key=" + budget_key +
+                " budget_scale=" + std::to_string(budget_start.budget_scale) +
+                " pattern_tries_scale=" + std::to_string(budget_start.pattern_tries_scale) +
+                " mcts_iterations_scale=" + std::to_string(budget_start.mcts_iterations_scale));
+        }
+    }
+
+    const int worker_count = std::max(1, run_cfg.threads <= 0 ? concurrency::default_worker_count() : run_cfg.threads);
+    // Przypięte workery czytają topologię z kopii na swoim węźle NUMA.
+    const concurrency::AffinityPolicy affinity = concurrency::affinity_policy_from_string(run_cfg.cpu_affinity);
+    concurrency::NodeReplicas<GenericTopology> topo_replicas(
+        topo, affinity == concurrency::AffinityPolicy::None ? 1 : concurrency::cpu_topology().node_count());
+    log_info(
+        "runner",
+        "workers=" + std::to_string(worker_count) +
+        " cpu_affinity=" + concurrency::to_string(affinity) +
+        " numa_nodes=" + std::to_string(concurrency::cpu_topology().node_count()) +
+        " allowed_cpus=" + std::to_string(concurrency::cpu_topology().cpus.size()));
+
+    // Tryb potokowy: grupy kopiąca i certyfikująca połączone kolejką (stage_pipeline.h).
+    std::unique_ptr<generator::StagePipeline> pipeline;
+    if (run_cfg.pipeline_depth > 0) {
+        pipeline = std::make_unique<generator::StagePipeline>(worker_count, run_cfg.pipeline_depth, topo.nn);
+        log_info(
+            "runner.pipeline",
+            "depth=" + std::to_string(run_cfg.pipeline_depth) +
+            " certify_workers=" + std::to_string(pipeline->certify_workers()));
+    }
 
     std::filesystem::create_directories(run_cfg.output_folder);
     const std::filesystem::path output_path = std::filesystem::path(run_cfg.output_folder) / run_cfg.output_file;
+
+    // Checkpoint obok pliku wyjściowego; przy --resume liczba zaakceptowanych to
+    // pełne linie tego pliku (puzzle zapisane po ostatnim checkpoincie też się liczą).
+    // Opt-in: okresowy zapis tylko z --checkpoint-interval-s; --resume bez interwału
+    // zapisuje jedynie checkpoint końcowy runu przerwanego przed celem.
+    const bool periodic_checkpoints = run_cfg.checkpoint_interval_s > 0;
+    const bool checkpoint_enabled = periodic_checkpoints || run_cfg.resume;
+    const std::filesystem::path checkpoint_path = generator::run_checkpoint_path(run_cfg);
+    const std::string checkpoint_key = generator::run_checkpoint_key(run_cfg);
+    generator::RunCheckpoint resume_ckpt{};
+    bool resumed = false;
+    uint64_t resumed_accepted = 0;
+    if (run_cfg.resume) {
+        std::string ckpt_err;
+        if (!generator::load_run_checkpoint(checkpoint_path, resume_ckpt, &ckpt_err)) {
+            log_warn("runner.checkpoint", "resume ignored: " + ckpt_err);
+            if (on_log) on_log("resume ignored: " + ckpt_err);
+        } else if (resume_ckpt.key != checkpoint_key) {
+            const std::string msg = "resume ignored: checkpoint key=" + resume_ckpt.key + " run key=" + checkpoint_key;
+            log_warn("runner.checkpoint", msg);
+            if (on_log) on_log(msg);
+        } else {
+            resumed = true;
+            ++resume_ckpt.resume_count;
+            resumed_accepted = std::min(generator::reconcile_output_lines(output_path), run_cfg.target_puzzles);
+            const std::string msg =
+                "resuming accepted=" + std::to_string(resumed_accepted) +
+                " attempts=" + std::to_string(resume_ckpt.counter("attempts")) +
+                " elapsed_s=" + std::to_string(resume_ckpt.elapsed_s) +
+                " resume_count=" + std::to_string(resume_ckpt.resume_count);
+            log_info("runner.checkpoint", msg);
+            if (on_log) on_log(msg);
+        }
+    }
+
     std::ofstream batch_out(output_path, std::ios::out | std::ios::app);
     if (!batch_out) {
         log_error("runner", "cannot open output file: " + output_path.string());
@@ -380,12 +521,92 @@ inline GenerateRunResult run_generic_sudoku(
     std::atomic<uint64_t> pattern_exact_template_used{0};
     std::atomic<uint64_t> pattern_family_fallback_used{0};
     std::atomic<uint64_t> required_strategy_exact_contract_met{0};
+    std::atomic<uint64_t> early_abort_checkpoints{0};
+    std::atomic<uint64_t> early_abort_aborted{0};
+    std::atomic<uint64_t> early_abort_audits{0};
+    std::atomic<uint64_t> early_abort_audit_false_negatives{0};
+    std::atomic<uint64_t> interleave_dropped{0};
+    std::atomic<uint64_t> interleave_unfinished{0};
+    std::atomic<uint64_t> pipeline_unfinished{0};
     std::atomic<uint64_t> required_zero_use_streak_max{0};
     std::atomic<int> best_template_score{0};
     std::atomic<uint64_t> kernel_elapsed_ns{0};
     std::atomic<uint64_t> kernel_calls{0};
-
-    const auto t0 = steady_clock::now();
+    std::vector<generator::BudgetSettings> worker_budgets(static_cast<size_t>(worker_count));
+    std::vector<uint64_t> worker_budget_epochs(static_cast<size_t>(worker_count), 0);
+
+    // Liczniki zapisywane w checkpoincie; liczniki klasyfikatora wracają z jego stanem.
+    const std::array<std::pair<const char*, std::atomic<uint64_t>*>, 32> checkpoint_counters{{
+        {"attempts", &attempts},
+        {"rejected", &rejected},
+        {"reject_prefilter", &reject_prefilter},
+        {"reject_logic", &reject_logic},
+        {"reject_uniqueness", &reject_uniqueness},
+        {"reject_strategy", &reject_strategy},
+        {"reject_replay", &reject_replay},
+        {"reject_distribution_bias", &reject_distribution_bias},
+        {"reject_uniqueness_budget", &reject_uniqueness_budget},
+        {"uniqueness_calls", &uniqueness_calls},
+        {"uniqueness_nodes", &uniqueness_nodes},
+        {"uniqueness_elapsed_ns", &uniqueness_elapsed_ns},
+        {"logic_steps_total", &logic_steps_total},
+        {"strategy_naked_use", &strategy_naked_use},
+        {"strategy_naked_hit", &strategy_naked_hit},
+        {"strategy_hidden_use", &strategy_hidden_use},
+        {"strategy_hidden_hit", &strategy_hidden_hit},
+        {"mcts_advanced_evals", &mcts_advanced_evals},
+        {"certifier_required_strategy_analyzed", &certifier_required_strategy_analyzed},
+        {"certifier_required_strategy_use", &certifier_required_strategy_use},
+        {"certifier_required_strategy_hit", &certifier_required_strategy_hit},
+        {"mcts_required_strategy_analyzed", &mcts_required_strategy_analyzed},
+        {"mcts_required_strategy_use", &mcts_required_strategy_use},
+        {"mcts_required_strategy_hit", &mcts_required_strategy_hit},
+        {"pattern_exact_template_used", &pattern_exact_template_used},
+        {"pattern_family_fallback_used", &pattern_family_fallback_used},
+        {"required_strategy_exact_contract_met", &required_strategy_exact_contract_met},
+        {"kernel_elapsed_ns", &kernel_elapsed_ns},
+        {"kernel_calls", &kernel_calls},
+        {"interleave_dropped", &interleave_dropped},
+        {"interleave_unfinished", &interleave_unfinished},
+        {"pipeline_unfinished", &pipeline_unfinished},
+    }};
+    if (resumed) {
+        for (const auto& [name, counter] : checkpoint_counters) {
+            counter->store(resume_ckpt.counter(name), std::memory_order_relaxed);
+        }
+        accepted.store(resumed_accepted, std::memory_order_relaxed);
+        written.store(resumed_accepted, std::memory_order_relaxed);
+    }
+    std::mutex checkpoint_mu;
+    std::vector<generator::WorkerCheckpoint> worker_checkpoints(static_cast<size_t>(worker_count));
+    std::atomic<uint64_t> checkpoint_generation{0};
+
+    // Wznowiony run liczy czas od startu pierwotnego (limit max_total_time_s też).
+    const auto t0 = steady_clock::now() - duration_cast<steady_clock::duration>(
+        duration<double>(resumed ? resume_ckpt.elapsed_s : 0.0));
+
+    auto write_checkpoint = [&]() {
+        generator::RunCheckpoint ckpt{};
+        ckpt.key = checkpoint_key;
+        ckpt.resume_count = resumed ? resume_ckpt.resume_count : 0;
+        ckpt.elapsed_s = duration_cast<duration<double>>(steady_clock::now() - t0).count();
+        for (const auto& [name, counter] : checkpoint_counters) {
+            ckpt.counters.emplace_back(name, counter->load(std::memory_order_relaxed));
+        }
+        {
+            std::lock_guard<std::mutex> lock(write_mu);
+            batch_out.flush();
+        }
+        bool saved = false;
+        {
+            std::lock_guard<std::mutex> lock(checkpoint_mu);
+            ckpt.workers = worker_checkpoints;
+            saved = generator::save_run_checkpoint(checkpoint_path, ckpt);
+        }
+        if (!saved) {
+            log_warn("runner.checkpoint", "cannot write checkpoint: " + checkpoint_path.string());
+        }
+    };
 
     auto is_cancelled = [&]() -> bool {
         return (cancel_flag != nullptr) && cancel_flag->load(std::memory_order_relaxed);
@@ -397,9 +618,13 @@ inline GenerateRunResult run_generic_sudoku(
 
     std::vector<std::thread> workers;
     workers.reserve(static_cast<size_t>(worker_count));
+    core_engines::idle_generator_workers().store(0, std::memory_order_relaxed);
 
     for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
         workers.emplace_back([&, worker_idx]() {
+            // Przed pierwszą alokacją wątku: first-touch stanu workera na jego węźle.
+            const concurrency::CpuPlacement placement = concurrency::place_current_thread(affinity, worker_idx);
+            const GenericTopology& topo = topo_replicas.local(placement.node);
             uint64_t local_attempts = 0;
             uint64_t local_written = 0;
             uint64_t local_required_analyzed = 0;
@@ -416,6 +641,10 @@ inline GenerateRunResult run_generic_sudoku(
             pattern_forcing::PatternKind local_template_family = pattern_forcing::PatternKind::None;
             pattern_forcing::PatternMutationSource local_mutation_source = pattern_forcing::PatternMutationSource::Random;
             uint64_t current_attempt_seed = 0;
+            // Debug (SUDOKU_COUNT_ALLOCATIONS): próby po rozgrzaniu, które jednak alokowały.
+            static constexpr uint64_t kAllocWarmupAttempts = 64;
+            uint64_t local_alloc_attempts = 0;
+            uint64_t local_alloc_total = 0;
 
             try {
                 const uint64_t base_seed = (run_cfg.seed == 0)
@@ -432,7 +661,76 @@ inline GenerateRunResult run_generic_sudoku(
                     core_engines::GenericSolvedKernel::backend_from_string(run_cfg.cpu_backend));
                 core_engines::GenericQuickPrefilter prefilter;
                 logic::GenericLogicCertify logic;
+                logic.set_tier_policy(tier_policy);
+                logic.set_strategy_work_cap(run_cfg.strategy_work_cap);
+                logic.set_strategy_timing_sample(static_cast<uint32_t>(std::max(0, run_cfg.strategy_timing_sample)));
                 core_engines::GenericUniquenessCounter uniq;
+                // Arena wątku: bufory próby żyją przez całą pętlę i tylko zmieniają rozmiar,
+                // więc po pierwszych próbach nie dotykają sterty.
+                generator::GenericPuzzleCandidate candidate;
+                std::string line;
+                // K > 1: próby przeplatane na granicy kopanie/certyfikacja (poza trybem potokowym).
+                const bool interleave = run_cfg.inflight_attempts > 1 && pipeline == nullptr;
+                generator::AttemptInterleaver interleaver;
+                if (interleave) interleaver.configure(run_cfg.inflight_attempts, topo.nn);
+
+                const generator::WorkerCheckpoint* resume_state =
+                    (resumed && static_cast<size_t>(worker_idx) < resume_ckpt.workers.size() &&
+                     resume_ckpt.workers[static_cast<size_t>(worker_idx)].present)
+                        ? &resume_ckpt.workers[static_cast<size_t>(worker_idx)]
+                        : nullptr;
+                if (resumed) {
+                    // Strumień przesunięty o numer wznowienia: próby między checkpointem
+                    // a zabiciem procesu (już zapisane) się nie powtórzą. Dotyczy każdego
+                    // workera - także bez sekcji w checkpoincie (np. więcej --threads
+                    // przy wznowieniu), inaczej powtórzyłby strumień pierwszego uruchomienia.
+                    const uint64_t stream_state =
+                        (resume_state != nullptr) ? resume_state->seed_state : worker_seed_state;
+                    worker_seed_state = stream_state ^ (0xD1B54A32D192ED03ULL * resume_ckpt.resume_count);
+                    current_attempt_seed = splitmix64_next(worker_seed_state);
+                    rng.seed(current_attempt_seed);
+                }
+                if (resume_state != nullptr) {
+                    local_attempts = resume_state->local_attempts;
+                    const bool classifier_ok = generator::deserialize_classifier(
+                        resume_state->classifier, mcts_digger::tls_dig_abort_classifier());
+                    const bool mutation_ok = generator::deserialize_mutation_state(
+                        resume_state->mutation, pattern_forcing::tls_pattern_mutation_state());
+                    if (!classifier_ok || !mutation_ok) {
+                        log_warn(
+                            "runner.checkpoint",
+                            "worker=" + std::to_string(worker_idx) +
+                            " learned state not restored classifier=" + std::string(classifier_ok ? "1" : "0") +
+                            " mutation=" + std::string(mutation_ok ? "1" : "0"));
+                    }
+                }
+
+                // Kopia konfiguracji pod pokrętła kontrolera budżetów tego workera.
+                GenerateRunConfig worker_cfg = run_cfg;
+                generator::AdaptiveBudgetController budget_ctl;
+                if (adaptive_budget) {
+                    const generator::BudgetSettings& start =
+                        (resume_state != nullptr && resume_state->has_budget) ? resume_state->budget : budget_start;
+                    budget_ctl.init(run_cfg, topo, start, user_budget_fixed, user_iterations_fixed);
+                    budget_ctl.apply(worker_cfg);
+                }
+
+                uint64_t local_checkpoint_gen = 0;
+                auto next_checkpoint_tp = steady_clock::now() + seconds(std::max(1, run_cfg.checkpoint_interval_s));
+                // Stan thread_local serializuje tylko wątek-właściciel.
+                auto publish_checkpoint = [&]() {
+                    generator::WorkerCheckpoint wc{};
+                    wc.present = true;
+                    wc.seed_state = worker_seed_state;
+                    wc.attempt_seed = current_attempt_seed;
+                    wc.local_attempts = local_attempts;
+                    wc.classifier = generator::serialize_classifier(mcts_digger::tls_dig_abort_classifier());
+                    wc.mutation = generator::serialize_mutation_state(pattern_forcing::tls_pattern_mutation_state());
+                    wc.has_budget = adaptive_budget;
+                    wc.budget = budget_ctl.incumbent();
+                    std::lock_guard<std::mutex> lock(checkpoint_mu);
+                    worker_checkpoints[static_cast<size_t>(worker_idx)] = std::move(wc);
+                };
 
                 log_info(
                     "runner.worker.start",
@@ -446,6 +744,22 @@ inline GenerateRunResult run_generic_sudoku(
                     break;
                 }
 
+                if (periodic_checkpoints) {
+                    const uint64_t gen = checkpoint_generation.load(std::memory_order_relaxed);
+                    if (gen != local_checkpoint_gen) {
+                        publish_checkpoint();
+                        local_checkpoint_gen = gen;
+                    }
+                    // Worker 0 taktuje checkpointy; pozostali dosyłają stan przy najbliższej
+                    // próbie, więc ich część pliku bywa o jeden interwał starsza.
+                    if (worker_idx == 0 && steady_clock::now() >= next_checkpoint_tp) {
+                        next_checkpoint_tp += seconds(run_cfg.checkpoint_interval_s);
+                        local_checkpoint_gen = checkpoint_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+                        publish_checkpoint();
+                        write_checkpoint();
+                    }
+                }
+
                 if (run_cfg.max_total_time_s > 0) {
                     const auto elapsed = duration_cast<seconds>(steady_clock::now() - t0).count();
                     if (elapsed >= static_cast<long long>(run_cfg.max_total_time_s)) {
@@ -495,31 +809,83 @@ inline GenerateRunResult run_generic_sudoku(
                         " seed=" + std::to_string(current_attempt_seed));
                 }
 
-                generator::GenericPuzzleCandidate candidate;
                 RejectReason reason = RejectReason::None;
                 RequiredStrategyAttemptInfo strategy_info{};
                 generator::AttemptPerfStats perf{};
                 bool timed_out = false;
+                const uint64_t allocs_before = debug_alloc::thread_allocations();
+                const uint64_t attempt_cpu_t0 = adaptive_budget ? thread_cpu_now_ns() : 0;
+
+                bool ok = false;
+                // Kolejne kopanie w tym samym wywołaniu = nowy seed, jak przy nowej próbie.
+                const auto reseed = [&]() {
+                    if (run_cfg.force_new_seed_per_attempt) {
+                        current_attempt_seed = splitmix64_next(worker_seed_state);
+                        rng.seed(current_attempt_seed);
+                    }
+                    return current_attempt_seed;
+                };
+                if (pipeline != nullptr) {
+                    const auto should_stop = [&]() {
+                        if (is_cancelled() || is_paused()) return true;
+                        if (accepted.load(std::memory_order_relaxed) >= run_cfg.target_puzzles) return true;
+                        return run_cfg.max_total_time_s > 0 &&
+                               duration_cast<seconds>(steady_clock::now() - t0).count() >=
+                                   static_cast<long long>(run_cfg.max_total_time_s);
+                    };
+                    const generator::StagePipeline::Outcome outcome = pipeline->next(
+                        worker_idx, worker_cfg, topo, rng, current_attempt_seed, reseed, should_stop, candidate, reason,
+                        strategy_info, solved, prefilter, logic, uniq, cancel_flag, pause_flag, perf);
+                    ok = outcome.ok;
+                    timed_out = outcome.timed_out;
+                    current_attempt_seed = outcome.seed;
+                } else if (interleave) {
+                    const generator::AttemptInterleaver::Outcome outcome = interleaver.next(
+                        worker_cfg, topo, rng, current_attempt_seed, reseed, candidate, reason, strategy_info,
+                        solved, prefilter, logic, uniq, cancel_flag, pause_flag, perf);
+                    ok = outcome.ok;
+                    timed_out = outcome.timed_out;
+                    current_attempt_seed = outcome.seed;
+                    if (outcome.dropped) interleave_dropped.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    ok = generator::generate_one_generic(
+                        worker_cfg,
+                        topo,
+                        rng,
+                        candidate,
+                        reason,
+                        strategy_info,
+                        solved,
+                        prefilter,
+                        logic,
+                        uniq,
+                        nullptr,
+                        &timed_out,
+                        cancel_flag,
+                        pause_flag,
+                        nullptr,
+                        nullptr,
+                        nullptr,
+                        &perf);
+                }
 
-                const bool ok = generator::generate_one_generic(
-                    run_cfg,
-                    topo,
-                    rng,
-                    candidate,
-                    reason,
-                    strategy_info,
-                    solved,
-                    prefilter,
-                    logic,
-                    uniq,
-                    nullptr,
-                    &timed_out,
-                    cancel_flag,
-                    pause_flag,
-                    nullptr,
-                    nullptr,
-                    nullptr,
-                    &perf);
+                if constexpr (debug_alloc::kEnabled) {
+                    const uint64_t attempt_allocs = debug_alloc::thread_allocations() - allocs_before;
+                    if (local_attempts > kAllocWarmupAttempts && attempt_allocs != 0) {
+                        ++local_alloc_attempts;
+                        local_alloc_total += attempt_allocs;
+                    }
+                }
+
+                // Etykieta dla klasyfikatora wczesnego przerwania; pauza nie jest wynikiem próby.
+                if (!ok && reason == RejectReason::None) {
+                    mcts_digger::tls_dig_abort_classifier().discard_pending();
+                } else {
+                    mcts_digger::tls_dig_abort_classifier().resolve(ok);
+                    if (adaptive_budget && budget_ctl.on_attempt(ok, thread_cpu_now_ns() - attempt_cpu_t0)) {
+                        budget_ctl.apply(worker_cfg);
+                    }
+                }
 
                 kernel_elapsed_ns.fetch_add(perf.solved_elapsed_ns + perf.dig_elapsed_ns, std::memory_order_relaxed);
                 kernel_calls.fetch_add(1, std::memory_order_relaxed);
@@ -599,7 +965,8 @@ inline GenerateRunResult run_generic_sudoku(
                         continue;
                     }
 
-                    const std::string line = generator::serialize_line_generic(
+                    generator::serialize_line_generic_into(
+                        line,
                         current_attempt_seed,
                         run_cfg,
                         candidate,
@@ -611,7 +978,9 @@ inline GenerateRunResult run_generic_sudoku(
                         if (run_cfg.write_individual_files) {
                             const std::filesystem::path file_path =
                                 std::filesystem::path(run_cfg.output_folder) /
-                                ("sudoku_" + std::to_string(accepted_idx) + ".txt");
+                                ("sudoku_" +
+                                 (run_cfg.shard_count > 1 ? ("s" + std::to_string(run_cfg.shard_index) + "_") : std::string()) +
+                                 std::to_string(accepted_idx) + ".txt");
                             std::ofstream one(file_path, std::ios::out | std::ios::trunc);
                             if (one) {
                                 one << line << '\n';
@@ -716,14 +1085,13 @@ inline GenerateRunResult run_generic_sudoku(
                     monitor->set_required_strategy_hits(mcts_required_strategy_hit.load(std::memory_order_relaxed));
 
                     WorkerRow row{};
-                    row.worker = "worker_" + std::to_string(worker_idx);
                     row.clues = candidate.clues;
                     row.seed = current_attempt_seed;
                     row.applied = local_attempts;
-                    row.status = is_paused() ? "paused" : "running";
+                    row.status = is_paused() ? WorkerStatus::Paused : WorkerStatus::Running;
                     row.reseed_interval_s = run_cfg.reseed_interval_s;
-                    row.attempt_time_budget_s = run_cfg.attempt_time_budget_s;
-                    row.attempt_node_budget = run_cfg.attempt_node_budget;
+                    row.attempt_time_budget_s = worker_cfg.attempt_time_budget_s;
+                    row.attempt_node_budget = worker_cfg.attempt_node_budget;
                     row.stage_solved_ms = static_cast<double>(perf.solved_elapsed_ns) / 1e6;
                     row.stage_dig_ms = static_cast<double>(perf.dig_elapsed_ns) / 1e6;
                     row.stage_prefilter_ms = static_cast<double>(perf.prefilter_elapsed_ns) / 1e6;
@@ -735,6 +1103,34 @@ inline GenerateRunResult run_generic_sudoku(
                     monitor->set_worker_row(static_cast<size_t>(worker_idx), row);
                 }
                 }
+
+                // Kandydaci wykopani, ale niecertyfikowani przed końcem runu: nie są
+                // próbami, więc raportowani osobno, żeby praca i liczniki się zgadzały.
+                if (interleave && interleaver.parked() > 0) {
+                    interleave_unfinished.fetch_add(static_cast<uint64_t>(interleaver.parked()), std::memory_order_relaxed);
+                    log_info(
+                        "runner.interleave",
+                        "worker=" + std::to_string(worker_idx) +
+                        " unfinished=" + std::to_string(interleaver.parked()));
+                }
+
+                if (checkpoint_enabled) {
+                    publish_checkpoint();
+                }
+
+                if (adaptive_budget) {
+                    worker_budgets[static_cast<size_t>(worker_idx)] = budget_ctl.incumbent();
+                    worker_budget_epochs[static_cast<size_t>(worker_idx)] = budget_ctl.epochs();
+                    log_info(
+                        "runner.budget",
+                        "worker=" + std::to_string(worker_idx) +
+                        " epochs=" + std::to_string(budget_ctl.epochs()) +
+                        " adopted=" + std::to_string(budget_ctl.adopted()) +
+                        " budget_scale=" + std::to_string(budget_ctl.incumbent().budget_scale) +
+                        " pattern_tries_scale=" + std::to_string(budget_ctl.incumbent().pattern_tries_scale) +
+                        " mcts_iterations_scale=" + std::to_string(budget_ctl.incumbent().mcts_iterations_scale) +
+                        " accepted_per_cpu_s=" + std::to_string(budget_ctl.incumbent().rate));
+                }
             } catch (const std::exception& ex) {
                 if (cancel_flag != nullptr) {
                     cancel_flag->store(true, std::memory_order_relaxed);
@@ -754,19 +1150,37 @@ inline GenerateRunResult run_generic_sudoku(
                     " attempt=" + std::to_string(local_attempts) +
                     " what=unknown");
             }
+            // Rdzeń tego workera jest odtąd wolny dla równoległego liczenia unikalności.
+            core_engines::idle_generator_workers().fetch_add(1, std::memory_order_relaxed);
+
+            {
+                const auto& abort_counters = mcts_digger::tls_dig_abort_classifier().counters();
+                early_abort_checkpoints.fetch_add(abort_counters.checkpoints, std::memory_order_relaxed);
+                early_abort_aborted.fetch_add(abort_counters.aborted, std::memory_order_relaxed);
+                early_abort_audits.fetch_add(abort_counters.audits, std::memory_order_relaxed);
+                early_abort_audit_false_negatives.fetch_add(abort_counters.audit_false_negatives, std::memory_order_relaxed);
+            }
 
             if (monitor != nullptr) {
                 WorkerRow row{};
-                row.worker = "worker_" + std::to_string(worker_idx);
                 row.seed = current_attempt_seed;
                 row.applied = local_attempts;
-                row.status = "done";
+                row.status = WorkerStatus::Done;
                 row.required_strategy_analyzed = local_required_analyzed;
                 row.required_strategy_use = local_required_use;
                 row.required_strategy_hit = local_required_hit;
                 monitor->set_worker_row(static_cast<size_t>(worker_idx), row);
             }
 
+            if constexpr (debug_alloc::kEnabled) {
+                log_info(
+                    "runner.worker.alloc",
+                    "worker=" + std::to_string(worker_idx) +
+                    " steady_attempts=" + std::to_string(local_attempts > kAllocWarmupAttempts ? local_attempts - kAllocWarmupAttempts : 0) +
+                    " attempts_with_alloc=" + std::to_string(local_alloc_attempts) +
+                    " allocations=" + std::to_string(local_alloc_total));
+            }
+
             log_info(
                 "runner.worker",
                 "worker=" + std::to_string(worker_idx) +
@@ -800,6 +1214,58 @@ inline GenerateRunResult run_generic_sudoku(
     }
 
     log_info("runner", "all workers joined");
+    core_engines::idle_generator_workers().store(0, std::memory_order_relaxed);
+
+    // Tryb potokowy: kandydaci wykopani, ale niecertyfikowani przed końcem runu
+    // (jak interleave_unfinished) - liczeni przed końcowym checkpointem.
+    if (pipeline != nullptr) {
+        const uint64_t unfinished = pipeline->drain_unfinished();
+        pipeline_unfinished.fetch_add(unfinished, std::memory_order_relaxed);
+        if (unfinished > 0) {
+            log_info("runner.pipeline", "unfinished=" + std::to_string(unfinished));
+        }
+    }
+
+    // Run doszedł do celu = nie ma czego wznawiać, checkpoint jest usuwany. Run
+    // przerwany wcześniej (anulowanie, limit czasu lub prób) zostawia końcowy.
+    if (checkpoint_enabled) {
+        if (accepted.load(std::memory_order_relaxed) >= run_cfg.target_puzzles) {
+            std::error_code ec;
+            std::filesystem::remove(checkpoint_path, ec);
+            std::filesystem::remove(checkpoint_path.string() + ".tmp", ec);
+            log_info("runner.checkpoint", "target reached, checkpoint removed path=" + checkpoint_path.string());
+        } else {
+            write_checkpoint();
+            log_info("runner.checkpoint", "final checkpoint path=" + checkpoint_path.string());
+        }
+    }
+
+    // Profil dla następnego runu: ustawienia workera z najlepszym zmierzonym tempem.
+    if (adaptive_budget && !budget_profile_path.empty()) {
+        int best_worker = -1;
+        for (int i = 0; i < worker_count; ++i) {
+            const size_t k = static_cast<size_t>(i);
+            if (worker_budget_epochs[k] < 2 || worker_budgets[k].rate <= 0.0) continue;
+            if (best_worker < 0 || worker_budgets[k].rate > worker_budgets[static_cast<size_t>(best_worker)].rate) {
+                best_worker = i;
+            }
+        }
+        if (best_worker >= 0) {
+            const bool saved = generator::save_budget_profile(
+                budget_profile_path, budget_key, worker_budgets[static_cast<size_t>(best_worker)]);
+            log_info(
+                "runner.budget",
+                "profile key=" + budget_key + " worker=" + std::to_string(best_worker) +
+                " saved=" + std::string(saved ? "1" : "0") + " path=" + budget_profile_path);
+        }
+    }
+
+    if (pipeline != nullptr) {
+        log_info(
+            "runner.pipeline",
+            "final certify_workers=" + std::to_string(pipeline->certify_workers()) +
+            " rebalances=" + std::to_string(pipeline->rebalances()));
+    }
 
     result.accepted = accepted.load(std::memory_order_relaxed);
     result.written = written.load(std::memory_order_relaxed);
@@ -837,34 +1303,16 @@ inline GenerateRunResult run_generic_sudoku(
     result.pattern_exact_template_used = pattern_exact_template_used.load(std::memory_order_relaxed);
     result.pattern_family_fallback_used = pattern_family_fallback_used.load(std::memory_order_relaxed);
     result.required_strategy_exact_contract_met = required_strategy_exact_contract_met.load(std::memory_order_relaxed);
-
-    const double asymmetry_ratio = static_cast<double>(std::max(run_cfg.box_rows, run_cfg.box_cols)) /
-                                   static_cast<double>(std::max(1, std::min(run_cfg.box_rows, run_cfg.box_cols)));
-    result.asymmetry_efficiency_index = asymmetry_ratio;
-    result.backend_efficiency_score = (result.kernel_time_ms > 0.0)
-        ? static_cast<double>(result.accepted) / (result.kernel_time_ms / 1000.0)
-        : 0.0;
-
-    const auto elapsed = duration_cast<duration<double>>(steady_clock::now() - t0).count();
-    result.elapsed_s = elapsed;
-    result.accepted_per_sec = (elapsed > 0.0) ? static_cast<double>(result.accepted) / elapsed : 0.0;
-
-    const auto vip_target = post_processing::resolve_vip_grade_target_for_geometry(run_cfg);
-    result.vip_score = post_processing::compute_vip_score(result, run_cfg, asymmetry_ratio);
-    result.vip_grade = post_processing::vip_grade_from_score(result.vip_score);
-    result.vip_contract_ok = post_processing::vip_contract_passed(result.vip_score, vip_target);
-    result.vip_contract_fail_reason = result.vip_contract_ok ? "" : ("required=" + vip_target + ", actual=" + result.vip_grade);
-
-    const std::string sig_raw =
-        std::to_string(result.accepted) + ":" +
-        std::to_string(result.written) + ":" +
-        std::to_string(result.attempts) + ":" +
-        std::to_string(result.uniqueness_nodes) + ":" +
-        std::to_string(run_cfg.box_rows) + "x" + std::to_string(run_cfg.box_cols);
-    const size_t h1 = std::hash<std::string>{}(sig_raw);
-    const size_t h2 = std::hash<std::string>{}(sig_raw + ":v2");
-    result.premium_signature = std::to_string(static_cast<unsigned long long>(h1));
-    result.premium_signature_v2 = std::to_string(static_cast<unsigned long long>(h2));
+    result.early_abort_checkpoints = early_abort_checkpoints.load(std::memory_order_relaxed);
+    result.early_abort_aborted = early_abort_aborted.load(std::memory_order_relaxed);
+    result.early_abort_audits = early_abort_audits.load(std::memory_order_relaxed);
+    result.early_abort_audit_false_negatives = early_abort_audit_false_negatives.load(std::memory_order_relaxed);
+    result.interleave_dropped = interleave_dropped.load(std::memory_order_relaxed);
+    result.interleave_unfinished = interleave_unfinished.load(std::memory_order_relaxed);
+    result.pipeline_unfinished = pipeline_unfinished.load(std::memory_order_relaxed);
+
+    result.elapsed_s = duration_cast<duration<double>>(steady_clock::now() - t0).count();
+    finalize_run_result(result, run_cfg);
 
     if (monitor != nullptr) {
         monitor->set_attempts(result.attempts);
@@ -0,0 +1,295 @@
+// ============================================================================
+// SUDOKU HPC - GENERATOR PIPELINE
+// Moduł: shard_merge.h
+// Opis: Skalowanie na wiele procesów bez pamięci współdzielonej. Shard i z K
+//       dostaje część celu, własny (rozłączny) strumień seedów wyprowadzony
+//       splitmix64 z seeda runu oraz własny plik wyjściowy i plik statystyk.
+//       Merge czyta shardy w kolejności indeksów, usuwa duplikaty (treść albo
+//       forma kanoniczna względem relabelu cyfr) i sumuje GenerateRunResult -
+//       wynik zależy tylko od plików shardów, nie od kolejności ich ukończenia.
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include "../config/run_config.h"
+#include "runtime_runner.h"
+
+namespace sudoku_hpc {
+
+// "generated_sudoku.txt" -> "generated_sudoku.shard-2-of-8.txt" (indeks od 0).
+inline std::string shard_output_file(const std::string& base, int index, int count) {
+    const std::string tag = ".shard-" + std::to_string(index) + "-of-" + std::to_string(count);
+    const size_t dot = base.find_last_of('.');
+    return (dot == std::string::npos) ? (base + tag) : (base.substr(0, dot) + tag + base.substr(dot));
+}
+
+// Równy podział celu; pierwsze total % count shardów bierze o jedną sztukę więcej.
+inline uint64_t shard_target(uint64_t total, int index, int count) {
+    const uint64_t k = static_cast<uint64_t>(std::max(1, count));
+    const uint64_t i = static_cast<uint64_t>(std::clamp(index, 0, count - 1));
+    return total / k + ((i < total % k) ? 1ULL : 0ULL);
+}
+
+// Konfiguracja shardu: część celu (i limitu prób), rozłączny seed, własne pliki.
+// Seed 0 (losowy) zostaje - procesy i tak startują z różnych zegarów.
+inline void apply_seed_shard(GenerateRunConfig& cfg) {
+    if (cfg.shard_count <= 1) return;
+    const int index = std::clamp(cfg.shard_index, 0, cfg.shard_count - 1);
+    cfg.shard_index = index;
+    cfg.target_puzzles = shard_target(cfg.target_puzzles, index, cfg.shard_count);
+    if (cfg.max_attempts > 0) {
+        const uint64_t k = static_cast<uint64_t>(cfg.shard_count);
+        cfg.max_attempts = (cfg.max_attempts + k - 1) / k;
+    }
+    if (cfg.seed != 0) {
+        uint64_t state = cfg.seed ^ (0xA0761D6478BD642FULL * static_cast<uint64_t>(index + 1));
+        cfg.seed = splitmix64_next(state);
+    }
+    cfg.output_file = shard_output_file(cfg.output_file, index, cfg.shard_count);
+}
+
+inline std::filesystem::path run_stats_path(const GenerateRunConfig& cfg) {
+    return std::filesystem::path(cfg.output_folder) / (cfg.output_file + ".stats");
+}
+
+namespace shard_detail {
+
+using CountField = uint64_t GenerateRunResult::*;
+using TimeField = double GenerateRunResult::*;
+
+// Pola sumowane przez merge (accepted/written liczy merge sam, po deduplikacji).
+inline constexpr std::array<std::pair<const char*, CountField>, 33> kCountFields{{
+    {"attempts", &GenerateRunResult::attempts},
+    {"rejected", &GenerateRunResult::rejected},
+    {"reject_prefilter", &GenerateRunResult::reject_prefilter},
+    {"reject_logic", &GenerateRunResult::reject_logic},
+    {"reject_uniqueness", &GenerateRunResult::reject_uniqueness},
+    {"reject_strategy", &GenerateRunResult::reject_strategy},
+    {"reject_replay", &GenerateRunResult::reject_replay},
+    {"reject_distribution_bias", &GenerateRunResult::reject_distribution_bias},
+    {"reject_uniqueness_budget", &GenerateRunResult::reject_uniqueness_budget},
+    {"uniqueness_calls", &GenerateRunResult::uniqueness_calls},
+    {"uniqueness_nodes", &GenerateRunResult::uniqueness_nodes},
+    {"kernel_calls", &GenerateRunResult::kernel_calls},
+    {"logic_steps_total", &GenerateRunResult::logic_steps_total},
+    {"strategy_naked_use", &GenerateRunResult::strategy_naked_use},
+    {"strategy_naked_hit", &GenerateRunResult::strategy_naked_hit},
+    {"strategy_hidden_use", &GenerateRunResult::strategy_hidden_use},
+    {"strategy_hidden_hit", &GenerateRunResult::strategy_hidden_hit},
+    {"mcts_advanced_evals", &GenerateRunResult::mcts_advanced_evals},
+    {"certifier_required_strategy_analyzed", &GenerateRunResult::certifier_required_strategy_analyzed},
+    {"certifier_required_strategy_use", &GenerateRunResult::certifier_required_strategy_use},
+    {"certifier_required_strategy_hit", &GenerateRunResult::certifier_required_strategy_hit},
+    {"mcts_required_strategy_analyzed", &GenerateRunResult::mcts_required_strategy_analyzed},
+    {"mcts_required_strategy_use", &GenerateRunResult::mcts_required_strategy_use},
+    {"mcts_required_strategy_hit", &GenerateRunResult::mcts_required_strategy_hit},
+    {"pattern_exact_template_used", &GenerateRunResult::pattern_exact_template_used},
+    {"pattern_family_fallback_used", &GenerateRunResult::pattern_family_fallback_used},
+    {"required_strategy_exact_contract_met", &GenerateRunResult::required_strategy_exact_contract_met},
+    {"early_abort_checkpoints", &GenerateRunResult::early_abort_checkpoints},
+    {"early_abort_aborted", &GenerateRunResult::early_abort_aborted},
+    {"early_abort_audits", &GenerateRunResult::early_abort_audits},
+    {"interleave_dropped", &GenerateRunResult::interleave_dropped},
+    {"interleave_unfinished", &GenerateRunResult::interleave_unfinished},
+    {"pipeline_unfinished", &GenerateRunResult::pipeline_unfinished},
+}};
+
+inline constexpr std::array<std::pair<const char*, TimeField>, 2> kTimeFields{{
+    {"uniqueness_elapsed_ms", &GenerateRunResult::uniqueness_elapsed_ms},
+    {"kernel_time_ms", &GenerateRunResult::kernel_time_ms},
+}};
+
+} // namespace shard_detail
+
+// Statystyki shardu obok jego pliku wyjściowego: "klucz wartość" w liniach.
+inline bool save_run_stats(const std::filesystem::path& path, const GenerateRunResult& r) {
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out) return false;
+    out << std::setprecision(17);
+    out << "# sudoku_hpc run stats\n";
+    out << "accepted " << r.accepted << "\n";
+    out << "written " << r.written << "\n";
+    for (const auto& [name, field] : shard_detail::kCountFields) out << name << " " << r.*field << "\n";
+    out << "early_abort_audit_false_negatives " << r.early_abort_audit_false_negatives << "\n";
+    for (const auto& [name, field] : shard_detail::kTimeFields) out << name << " " << r.*field << "\n";
+    out << "elapsed_s " << r.elapsed_s << "\n";
+    out << "effective_min_clues " << r.effective_min_clues << "\n";
+    out << "effective_max_clues " << r.effective_max_clues << "\n";
+    out << "measurement_profile " << r.measurement_profile << "\n";
+    out << "cpu_backend " << r.cpu_backend_selected << "\n";
+    return static_cast<bool>(out);
+}
+
+inline bool load_run_stats(const std::filesystem::path& path, GenerateRunResult& out_result) {
+    std::ifstream in(path);
+    if (!in) return false;
+    GenerateRunResult r{};
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream iss(line);
+        std::string key;
+        iss >> key;
+        if (key == "accepted") { iss >> r.accepted; continue; }
+        if (key == "written") { iss >> r.written; continue; }
+        if (key == "early_abort_audit_false_negatives") { iss >> r.early_abort_audit_false_negatives; continue; }
+        if (key == "elapsed_s") { iss >> r.elapsed_s; continue; }
+        if (key == "effective_min_clues") { iss >> r.effective_min_clues; continue; }
+        if (key == "effective_max_clues") { iss >> r.effective_max_clues; continue; }
+        if (key == "measurement_profile") { iss >> r.measurement_profile; continue; }
+        if (key == "cpu_backend") { iss >> r.cpu_backend_selected; continue; }
+        for (const auto& [name, field] : shard_detail::kCountFields) {
+            if (key == name) { iss >> r.*field; break; }
+        }
+        for (const auto& [name, field] : shard_detail::kTimeFields) {
+            if (key == name) { iss >> r.*field; break; }
+        }
+    }
+    out_result = r;
+    return true;
+}
+
+// Klucz deduplikacji linii wyjścia (seed,br,bc,komórki): bajt na komórkę -
+// cyfra | 0x80 dla wskazówki. relabel = cyfry numerowane w kolejności pierwszego
+// wystąpienia, więc puzzle różniące się tylko permutacją cyfr dają ten sam klucz.
+// Pusty wynik = linia uszkodzona.
+inline std::string puzzle_dedup_key(std::string_view line, bool relabel) {
+    std::string key;
+    std::array<uint8_t, 65> relabel_map{};
+    uint8_t next_label = 0;
+    size_t pos = line.find(',');
+    if (pos == std::string_view::npos) return {};
+    int field = 0;
+    while (pos != std::string_view::npos) {
+        const size_t start = pos + 1;
+        pos = line.find(',', start);
+        std::string_view tok = line.substr(start, (pos == std::string_view::npos) ? std::string_view::npos : pos - start);
+        if (!tok.empty() && tok.back() == '\r') tok.remove_suffix(1);
+        bool given = false;
+        if (!tok.empty() && tok.front() == 't') {
+            given = true;
+            tok.remove_prefix(1);
+        }
+        unsigned value = 0;
+        const auto res = std::from_chars(tok.data(), tok.data() + tok.size(), value);
+        if (res.ec != std::errc{} || res.ptr != tok.data() + tok.size() || value > 64) return {};
+        if (field >= 2 && relabel && value != 0) {
+            uint8_t& label = relabel_map[value];
+            if (label == 0) label = ++next_label;
+            value = label;
+        }
+        key.push_back(static_cast<char>(value | (given ? 0x80U : 0U)));
+        ++field;
+    }
+    return (field > 2) ? key : std::string();
+}
+
+struct ShardMergeReport {
+    GenerateRunResult result;
+    int shards_found = 0;
+    int shards_missing = 0;
+    uint64_t lines_read = 0;
+    uint64_t duplicates = 0;
+    uint64_t malformed = 0;
+};
+
+// cfg = konfiguracja runu bez shardu (folder i plik wyjściowy scalonego wyniku).
+inline bool merge_seed_shards(
+    const GenerateRunConfig& cfg,
+    int shard_count,
+    bool relabel,
+    ShardMergeReport& report,
+    std::string* err = nullptr) {
+    report = {};
+    const std::filesystem::path out_path = std::filesystem::path(cfg.output_folder) / cfg.output_file;
+    std::ofstream out(out_path, std::ios::out | std::ios::trunc);
+    if (!out) {
+        if (err != nullptr) *err = "cannot open merged output: " + out_path.string();
+        return false;
+    }
+
+    GenerateRunResult& total = report.result;
+    std::unordered_set<std::string> seen;
+    std::string line;
+    for (int i = 0; i < shard_count; ++i) {
+        const std::string shard_file = shard_output_file(cfg.output_file, i, shard_count);
+        const std::filesystem::path shard_path = std::filesystem::path(cfg.output_folder) / shard_file;
+        std::ifstream in(shard_path);
+        if (!in) {
+            ++report.shards_missing;
+            log_warn("shard.merge", "missing shard output: " + shard_path.string());
+            continue;
+        }
+        ++report.shards_found;
+        while (std::getline(in, line)) {
+            if (line.empty()) continue;
+            ++report.lines_read;
+            std::string key = puzzle_dedup_key(line, relabel);
+            if (key.empty()) {
+                ++report.malformed;
+                continue;
+            }
+            if (!seen.insert(std::move(key)).second) {
+                ++report.duplicates;
+                continue;
+            }
+            out << line << '\n';
+        }
+
+        GenerateRunResult s{};
+        if (!load_run_stats(shard_path.string() + ".stats", s)) {
+            log_warn("shard.merge", "missing shard stats: " + shard_path.string() + ".stats");
+            continue;
+        }
+        for (const auto& [name, field] : shard_detail::kCountFields) total.*field += s.*field;
+        for (const auto& [name, field] : shard_detail::kTimeFields) total.*field += s.*field;
+        total.early_abort_audit_false_negatives += s.early_abort_audit_false_negatives;
+        // Shardy biegną równolegle: czas scalonego runu to najdłuższy shard.
+        total.elapsed_s = std::max(total.elapsed_s, s.elapsed_s);
+        if (total.effective_max_clues == 0) {
+            total.effective_min_clues = s.effective_min_clues;
+            total.effective_max_clues = s.effective_max_clues;
+            total.measurement_profile = s.measurement_profile;
+            total.cpu_backend_selected = s.cpu_backend_selected;
+        }
+    }
+
+    total.accepted = static_cast<uint64_t>(seen.size());
+    total.written = total.accepted;
+    total.uniqueness_avg_ms = (total.uniqueness_calls > 0)
+        ? (total.uniqueness_elapsed_ms / static_cast<double>(total.uniqueness_calls))
+        : 0.0;
+    finalize_run_result(total, cfg);
+
+    log_info(
+        "shard.merge",
+        "shards_found=" + std::to_string(report.shards_found) +
+        " shards_missing=" + std::to_string(report.shards_missing) +
+        " lines=" + std::to_string(report.lines_read) +
+        " unique=" + std::to_string(total.accepted) +
+        " duplicates=" + std::to_string(report.duplicates) +
+        " malformed=" + std::to_string(report.malformed) +
+        " dedup=" + std::string(relabel ? "relabel" : "exact"));
+    out.flush();
+    if (!out) {
+        if (err != nullptr) *err = "write failed: " + out_path.string();
+        return false;
+    }
+    return true;
+}
+
+} // namespace sudoku_hpc
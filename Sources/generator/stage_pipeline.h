@@ -0,0 +1,284 @@
+// ============================================================================
+// SUDOKU HPC - GENERATOR PIPELINE
+// Moduł: stage_pipeline.h
+// Opis: Tryb potokowy runu: workery podzielone na grupę kopiącą (ETAP 1-2:
+//       siatka rozwiązania + kopanie) i certyfikującą (ETAP 3-7), połączone
+//       ograniczonymi kolejkami MPMC indeksów do puli zadań alokowanej raz.
+//       Każda grupa trzyma w cache kod i dane swojego etapu. Podział grup
+//       przestawiany w locie wg głębokości kolejki gotowych kandydatów: pełna =
+//       certyfikacja nie nadąża, pusta = kopanie nie nadąża. Certyfikator bez
+//       pracy robi pełną próbę sam, kopiący przy pełnej kolejce certyfikuje,
+//       więc żadna grupa nie stoi. Etykiety klasyfikatora wczesnego przerwania
+//       i sprzężenie szablonu wzorca wracają do workera, który kopał (jego stan
+//       uczony podejmuje decyzje przy następnym kopaniu).
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../config/run_config.h"
+#include "concurrency/mpmc_ring.h"
+#include "generator_facade.h"
+#include "mcts_digger/dig_abort_classifier.h"
+
+namespace sudoku_hpc::generator {
+
+class StagePipeline {
+public:
+    struct Outcome {
+        bool ok = false;
+        bool timed_out = false;
+        // Seed próby z chwili kopania (log / monitor).
+        uint64_t seed = 0;
+    };
+
+    // depth = liczba wykopanych kandydatów w locie (pula zadań i kolejka gotowych).
+    StagePipeline(int workers, int depth, int cells)
+        : workers_(std::max(1, workers)),
+          depth_(std::max(1, depth)),
+          items_(static_cast<size_t>(depth_)),
+          free_(static_cast<size_t>(depth_)),
+          ready_(static_cast<size_t>(depth_)) {
+        for (int i = 0; i < depth_; ++i) {
+            Item& item = items_[static_cast<size_t>(i)];
+            item.candidate.puzzle.reserve(static_cast<size_t>(cells));
+            item.candidate.solution.reserve(static_cast<size_t>(cells));
+            free_.try_push(static_cast<uint32_t>(i));
+        }
+        labels_.reserve(static_cast<size_t>(workers_));
+        for (int w = 0; w < workers_; ++w) {
+            labels_.push_back(std::make_unique<concurrency::BoundedMpmcRing<Label>>(static_cast<size_t>(depth_)));
+        }
+        // Start: połowa na certyfikację; jeden worker = zawsze pełne próby szeregowo.
+        certifiers_.store(std::max(1, workers_ / 2), std::memory_order_relaxed);
+    }
+
+    // Certyfikatorami są workery o najwyższych indeksach (worker 0 zawsze kopie,
+    // o ile workerów jest więcej niż jeden).
+    bool is_certifier(int worker_idx) const {
+        return worker_idx >= workers_ - certifiers_.load(std::memory_order_relaxed);
+    }
+
+    int certify_workers() const {
+        return certifiers_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t rebalances() const {
+        return rebalances_.load(std::memory_order_relaxed);
+    }
+
+    // Po zakończeniu workerów: kandydaci wciąż w kolejce gotowych nie są próbami.
+    // Wracają do puli, a ich próbki klasyfikatora i sprzężenie wzorca przepadają
+    // bez etykiety (wynik nieznany). Zwraca liczbę porzuconych kandydatów.
+    uint64_t drain_unfinished() {
+        uint64_t drained = 0;
+        uint32_t idx = 0;
+        while (ready_.try_pop(idx)) {
+            Item& item = items_[idx];
+            item.pending = {};
+            item.state.pattern_feedback = {};
+            free_.try_push(idx);
+            ++drained;
+        }
+        return drained;
+    }
+
+    // Jedna próba workera. Kopiący odkłada udanych kandydatów do kolejki i kopie
+    // dalej; wynikiem jest odrzucenie przy kopaniu albo certyfikacja. Kolejne
+    // kopanie w tym wywołaniu bierze seed z reseed(); should_stop() przerywa
+    // pętlę wynikiem jak przy pauzie (false z RejectReason::None).
+    template <typename ReseedFn, typename StopFn>
+    Outcome next(
+        int worker_idx,
+        const GenerateRunConfig& cfg,
+        const GenericTopology& topo,
+        std::mt19937_64& rng,
+        uint64_t attempt_seed,
+        ReseedFn&& reseed,
+        StopFn&& should_stop,
+        GenericPuzzleCandidate& candidate,
+        RejectReason& reason,
+        RequiredStrategyAttemptInfo& strategy_info,
+        const core_engines::GenericSolvedKernel& solved,
+        const core_engines::GenericQuickPrefilter& prefilter,
+        const logic::GenericLogicCertify& logic,
+        const core_engines::GenericUniquenessCounter& uniq,
+        const std::atomic<bool>* external_cancel_ptr,
+        const std::atomic<bool>* external_pause_ptr,
+        AttemptPerfStats& perf) {
+
+        Outcome out{};
+        mcts_digger::DigAbortClassifier& clf = mcts_digger::tls_dig_abort_classifier();
+        bool first_dig = true;
+
+        while (true) {
+            reason = RejectReason::None;
+            drain_labels(worker_idx, clf);
+            if (should_stop()) return out;
+
+            uint32_t idx = 0;
+            if (is_certifier(worker_idx)) {
+                if (ready_.try_pop(idx)) {
+                    return certify(idx, worker_idx, cfg, topo, candidate, reason, strategy_info, prefilter, logic, uniq, clf, perf);
+                }
+                // Kopanie nie nadąża: pełna próba na miejscu zamiast czekania.
+                if (!first_dig) attempt_seed = reseed();
+                out.seed = attempt_seed;
+                out.ok = generate_one_generic(
+                    cfg, topo, rng, candidate, reason, strategy_info, solved, prefilter, logic, uniq,
+                    nullptr, &out.timed_out, external_cancel_ptr, external_pause_ptr,
+                    nullptr, nullptr, nullptr, &perf);
+                return out;
+            }
+
+            if (!free_.try_pop(idx)) {
+                // Pula pełna: certyfikacja nie nadąża, kopiący pomaga.
+                if (ready_.try_pop(idx)) {
+                    return certify(idx, worker_idx, cfg, topo, candidate, reason, strategy_info, prefilter, logic, uniq, clf, perf);
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (!first_dig) attempt_seed = reseed();
+            first_dig = false;
+            Item& item = items_[idx];
+            bool dig_timed_out = false;
+            const bool dug = generate_dig_stage_generic(
+                cfg, topo, rng, item.candidate, reason, item.strategy_info, solved, logic, uniq, item.state,
+                nullptr, &dig_timed_out, external_cancel_ptr, external_pause_ptr, &item.perf);
+            if (!dug) {
+                std::swap(item.candidate, candidate);
+                strategy_info = item.strategy_info;
+                perf = item.perf;
+                free_.try_push(idx);
+                out.seed = attempt_seed;
+                out.timed_out = dig_timed_out;
+                return out;
+            }
+
+            item.pending = clf.take_pending();
+            item.producer = worker_idx;
+            item.seed = attempt_seed;
+            item.timed_out = dig_timed_out;
+            item.queued_at = std::chrono::steady_clock::now();
+            ready_.try_push(idx);
+            note_queue_op();
+        }
+    }
+
+private:
+    struct Item {
+        int producer = 0;
+        bool timed_out = false;
+        uint64_t seed = 0;
+        std::chrono::steady_clock::time_point queued_at{};
+        GenericPuzzleCandidate candidate;
+        RequiredStrategyAttemptInfo strategy_info{};
+        AttemptPerfStats perf{};
+        GenericAttemptStageState state{};
+        mcts_digger::DigAbortClassifier::PendingSample pending{};
+    };
+
+    // Wynik certyfikacji odsyłany do wątku, który kopał: etykieta klasyfikatora
+    // i sprzężenie szablonu wzorca (oba to stan thread_local kopiącego).
+    struct Label {
+        mcts_digger::DigAbortClassifier::PendingSample sample{};
+        bool accepted = false;
+        PatternTemplateFeedback pattern{};
+    };
+
+    static constexpr uint64_t kRebalanceEvery = 32;
+
+    Outcome certify(
+        uint32_t idx,
+        int worker_idx,
+        const GenerateRunConfig& cfg,
+        const GenericTopology& topo,
+        GenericPuzzleCandidate& candidate,
+        RejectReason& reason,
+        RequiredStrategyAttemptInfo& strategy_info,
+        const core_engines::GenericQuickPrefilter& prefilter,
+        const logic::GenericLogicCertify& logic,
+        const core_engines::GenericUniquenessCounter& uniq,
+        mcts_digger::DigAbortClassifier& clf,
+        AttemptPerfStats& perf) {
+
+        Item& item = items_[idx];
+        Outcome out{};
+        std::swap(item.candidate, candidate);
+        strategy_info = item.strategy_info;
+        perf = item.perf;
+        out.seed = item.seed;
+        out.timed_out = item.timed_out;
+        // Czas w kolejce nie zjada budżetu czasu próby.
+        item.state.shift_deadline(std::chrono::steady_clock::now() - item.queued_at);
+        out.ok = generate_certify_stage_generic(
+            cfg, topo, candidate, reason, strategy_info, prefilter, logic, uniq, item.state,
+            &out.timed_out, nullptr, nullptr, nullptr, &perf);
+
+        // Własny kandydat: etykietę rozliczy runner (resolve na tym wątku).
+        if (item.producer == worker_idx) {
+            clf.restore_pending(item.pending);
+            apply_pattern_feedback(item.state.pattern_feedback);
+        } else if (item.pending.active || item.state.pattern_feedback.due) {
+            labels_[static_cast<size_t>(item.producer)]->try_push(
+                Label{item.pending, out.ok, item.state.pattern_feedback});
+        }
+        free_.try_push(idx);
+        note_queue_op();
+        return out;
+    }
+
+    void drain_labels(int worker_idx, mcts_digger::DigAbortClassifier& clf) {
+        Label label{};
+        while (labels_[static_cast<size_t>(worker_idx)]->try_pop(label)) {
+            clf.restore_pending(label.sample);
+            clf.resolve(label.accepted);
+            apply_pattern_feedback(label.pattern);
+        }
+    }
+
+    // Co kRebalanceEvery operacji na kolejce jeden worker przesuwa granicę grup
+    // o jeden: kolejka zapchana (>= 3/4) = więcej certyfikatorów, pusta (<= 1/8)
+    // = więcej kopiących. Każda grupa zachowuje co najmniej jednego workera.
+    void note_queue_op() {
+        if (workers_ < 2) return;
+        if ((queue_ops_.fetch_add(1, std::memory_order_relaxed) + 1) % kRebalanceEvery != 0) return;
+        const size_t depth = ready_.size_approx();
+        const size_t cap = static_cast<size_t>(depth_);
+        int c = certifiers_.load(std::memory_order_relaxed);
+        if (depth * 4 >= cap * 3 && c < workers_ - 1) {
+            ++c;
+        } else if (depth * 8 <= cap && c > 1) {
+            --c;
+        } else {
+            return;
+        }
+        certifiers_.store(c, std::memory_order_relaxed);
+        rebalances_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const int workers_;
+    const int depth_;
+    std::vector<Item> items_;
+    concurrency::BoundedMpmcRing<uint32_t> free_;
+    concurrency::BoundedMpmcRing<uint32_t> ready_;
+    std::vector<std::unique_ptr<concurrency::BoundedMpmcRing<Label>>> labels_;
+
+    alignas(64) std::atomic<int> certifiers_{1};
+    alignas(64) std::atomic<uint64_t> queue_ops_{0};
+    std::atomic<uint64_t> rebalances_{0};
+};
+
+} // namespace sudoku_hpc::generator
@@ -33,14 +33,26 @@ inline constexpr size_t impl_tier_index(StrategyImplTier tier) {
     return static_cast<size_t>(tier);
 }
 
+// Runtime tier selection for hybrid slots (exact implementation + proxy fallback).
+enum class StrategyTierMode : uint8_t {
+    Hybrid = 0,        // exact first, then proxy fallback (legacy behaviour)
+    ExactOnly = 1,
+    ProxyOnly = 2,
+};
+
 inline constexpr size_t kStrategySlotCount = 61;
 inline constexpr size_t kMaxStepTrace = 4096;
 
+struct StrategyTierPolicy {
+    std::array<StrategyTierMode, kStrategySlotCount> mode{};
+};
 struct StrategyStats {
     uint64_t use_count = 0;
     uint64_t hit_count = 0;
     uint64_t placements = 0;
     uint64_t elapsed_ns = 0;
+    uint64_t budget_aborts = 0; // invocations cut short by the work cap / attempt budget
+    uint64_t timed_uses = 0;    // invocations inside timing-sampled rounds (elapsed_ns covers only these)
 };
 
 struct StepTrace {
@@ -124,6 +136,13 @@ struct GenericLogicCertifyResult {
     bool hidden_single_scanned = false;
 
     int steps = 0;
+    // Heavy-slot invocations (P7/P8) aborted on the work budget; a NoProgress
+    // verdict with a non-zero count is inconclusive rather than a hard stall.
+    uint32_t budget_aborted_slots = 0;
+    // Timing sample rate used for strategy_stats[].elapsed_ns: 1 = every round,
+    // N > 1 = 1-in-N rounds, scaled per slot by use_count / timed_uses (estimate),
+    // 0 = timing disabled.
+    uint32_t timing_sample_every = 1;
     // Telemetry-only payload populated only on explicit capture for replay/debug.
     std::vector<uint16_t> solved_grid;
 
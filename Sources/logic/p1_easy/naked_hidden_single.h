@@ -58,6 +58,7 @@ inline ApplyResult apply_hidden_single(CandidateState& st, StrategyStats& s, Gen
     // Szukamy w każdym rzędzie, kolumnie i bloku, czy jakakolwiek cyfra 
     // występuje tylko w jednej dostępnej komórce dla danego domku
     for (size_t h = 0; h + 1 < st.topo->house_offsets.size(); ++h) {
+        if (!st.house_dirty(static_cast<int>(h))) continue;
         const int p0 = st.topo->house_offsets[h];
         const int p1 = st.topo->house_offsets[h + 1];
         
@@ -37,6 +37,7 @@ inline ApplyResult apply_pointing_and_boxline(
             const int c0 = bcg * st.topo->box_cols;
             
             for (int d = 1; d <= n; ++d) {
+                if (!st.digit_dirty(d)) continue;
                 const uint64_t bit = (1ULL << (d - 1));
                 int fr = -1, fc = -1, cnt = 0;
                 bool same_row = true, same_col = true;
@@ -112,6 +113,7 @@ inline ApplyResult apply_pointing_and_boxline(
     // Skan rzędów
     for (int r0 = 0; r0 < n; ++r0) {
         for (int d = 1; d <= n; ++d) {
+            if (!st.digit_dirty(d)) continue;
             const uint64_t bit = (1ULL << (d - 1));
             int first_box = -1, cnt = 0; 
             bool same_box = true;
@@ -153,6 +155,7 @@ inline ApplyResult apply_pointing_and_boxline(
     // Skan kolumn
     for (int c0 = 0; c0 < n; ++c0) {
         for (int d = 1; d <= n; ++d) {
+            if (!st.digit_dirty(d)) continue;
             const uint64_t bit = (1ULL << (d - 1));
             int first_box = -1, cnt = 0; 
             bool same_box = true;
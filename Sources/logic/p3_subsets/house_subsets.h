@@ -41,6 +41,7 @@ inline ApplyResult apply_house_subset(
 
     const size_t house_count = st.topo->house_offsets.size() - 1;
     for (size_t h = 0; h < house_count; ++h) {
+        if (!st.house_dirty(static_cast<int>(h))) continue;
         const int p0 = st.topo->house_offsets[h];
         const int p1 = st.topo->house_offsets[h + 1];
         
@@ -34,6 +34,7 @@ inline ApplyResult apply_empty_rectangle(CandidateState& st, StrategyStats& s, G
     auto& sp = shared::exact_pattern_scratchpad();
 
     for (int d = 1; d <= n; ++d) {
+        if (!st.digit_dirty(d)) continue;
         const uint64_t bit = (1ULL << (d - 1));
         
         std::fill_n(sp.fish_row_masks, n, 0ULL);
@@ -27,6 +27,7 @@ inline ApplyResult apply_x_wing(CandidateState& st, StrategyStats& s, GenericLog
     auto& sp = shared::exact_pattern_scratchpad();
 
     for (int d = 1; d <= n; ++d) {
+        if (!st.digit_dirty(d)) continue;
         const uint64_t bit = (1ULL << (d - 1));
         std::fill_n(sp.fish_row_masks, n, 0ULL);
         std::fill_n(sp.fish_col_masks, n, 0ULL);
@@ -112,6 +113,7 @@ inline ApplyResult apply_swordfish(CandidateState& st, StrategyStats& s, Generic
     auto& sp = shared::exact_pattern_scratchpad();
     
     for (int d = 1; d <= n; ++d) {
+        if (!st.digit_dirty(d)) continue;
         const uint64_t bit = (1ULL << (d - 1));
         std::fill_n(sp.fish_row_masks, n, 0ULL);
         std::fill_n(sp.fish_col_masks, n, 0ULL);
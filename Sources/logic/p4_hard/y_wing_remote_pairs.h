@@ -15,8 +15,16 @@ inline ApplyResult apply_y_wing(CandidateState& st, StrategyStats& s, GenericLog
     ++s.use_count;
     bool progress = false;
 
-    for (int pivot = 0; pivot < st.topo->nn; ++pivot) {
-        if (st.board->values[pivot] != 0) continue;
+    st.ensure_indices();
+    if (st.bivalue_count() < 3) {
+        s.elapsed_ns += st.now_ns() - t0;
+        return ApplyResult::NoProgress;
+    }
+    auto& sp = shared::exact_pattern_scratchpad();
+    const int pivot_count = st.collect_bivalue_cells(sp.wing_cells);
+
+    for (int pi = 0; pi < pivot_count; ++pi) {
+        const int pivot = sp.wing_cells[pi];
         const uint64_t mp = st.cands[pivot];
         if (std::popcount(mp) != 2) continue;
 
@@ -24,9 +32,8 @@ inline ApplyResult apply_y_wing(CandidateState& st, StrategyStats& s, GenericLog
         const int p1 = st.topo->peer_offsets[pivot + 1];
         for (int i = p0; i < p1; ++i) {
             const int a = st.topo->peers_flat[i];
-            if (st.board->values[a] != 0) continue;
+            if (!st.is_bivalue(a)) continue;
             const uint64_t ma = st.cands[a];
-            if (std::popcount(ma) != 2) continue;
 
             const uint64_t shared_a = ma & mp;
             if (std::popcount(shared_a) != 1) continue;
@@ -35,9 +42,8 @@ inline ApplyResult apply_y_wing(CandidateState& st, StrategyStats& s, GenericLog
 
             for (int j = i + 1; j < p1; ++j) {
                 const int b = st.topo->peers_flat[j];
-                if (st.board->values[b] != 0) continue;
+                if (!st.is_bivalue(b)) continue;
                 const uint64_t mb = st.cands[b];
-                if (std::popcount(mb) != 2) continue;
 
                 const uint64_t shared_b = mb & mp;
                 if (std::popcount(shared_b) != 1 || shared_b == shared_a) continue;
@@ -88,11 +94,18 @@ inline ApplyResult apply_remote_pairs(CandidateState& st, StrategyStats& s, Gene
     int* seen_parity1 = sp.bfs_depth;
     uint64_t* pair_masks = reinterpret_cast<uint64_t*>(sp.adj_flat);
 
+    st.ensure_indices();
+    if (st.bivalue_count() < 4) {
+        s.elapsed_ns += st.now_ns() - t0;
+        return ApplyResult::NoProgress;
+    }
+
+    // Tylko kubełki par z co najmniej 4 komórkami mogą utworzyć łańcuch Remote Pairs.
     int pair_mask_count = 0;
-    for (int idx = 0; idx < nn; ++idx) {
-        if (st.board->values[idx] != 0) continue;
-        const uint64_t m = st.cands[idx];
-        if (std::popcount(m) == 2 && pair_mask_count < nn) {
+    const int bivalue_count = st.collect_bivalue_cells(sp.wing_cells);
+    for (int i = 0; i < bivalue_count; ++i) {
+        const uint64_t m = st.cands[sp.wing_cells[i]];
+        if (st.pair_bucket_size(m) >= 4) {
             pair_masks[pair_mask_count++] = m;
         }
     }
@@ -106,13 +119,21 @@ inline ApplyResult apply_remote_pairs(CandidateState& st, StrategyStats& s, Gene
 
     for (int p_idx = 0; p_idx < pair_mask_count; ++p_idx) {
         const uint64_t pair_mask = pair_masks[p_idx];
-        std::fill_n(component, nn, -1);
-        std::fill_n(parity, nn, -1);
-        std::fill_n(node_degree, nn, 0);
+        int bucket_count = 0;
+        for (int idx = st.pair_bucket_first(pair_mask); idx >= 0; idx = st.pair_bucket_next(idx)) {
+            sp.wing_cells[bucket_count++] = idx;
+        }
+        if (bucket_count < 4) continue;
+        for (int bi = 0; bi < bucket_count; ++bi) {
+            const int idx = sp.wing_cells[bi];
+            component[idx] = -1;
+            parity[idx] = -1;
+            node_degree[idx] = 0;
+        }
         int comp_id = 0;
 
-        for (int idx = 0; idx < nn; ++idx) {
-            if (st.board->values[idx] != 0 || st.cands[idx] != pair_mask) continue;
+        for (int bi = 0; bi < bucket_count; ++bi) {
+            const int idx = sp.wing_cells[bi];
             const int p0 = st.topo->peer_offsets[idx];
             const int p1 = st.topo->peer_offsets[idx + 1];
             for (int p = p0; p < p1; ++p) {
@@ -123,7 +144,8 @@ inline ApplyResult apply_remote_pairs(CandidateState& st, StrategyStats& s, Gene
             }
         }
 
-        for (int start = 0; start < nn; ++start) {
+        for (int bi = 0; bi < bucket_count; ++bi) {
+            const int start = sp.wing_cells[bi];
             if (st.board->values[start] != 0 || st.cands[start] != pair_mask) continue;
             if (component[start] != -1) continue;
 
@@ -30,12 +30,19 @@ inline ApplyResult apply_bug_plus_one(CandidateState& st, StrategyStats& s, Gene
         return ApplyResult::NoProgress;
     }
     
+    // Indeks bivalue: BUG+1 wymaga, by dokładnie jedna pusta komórka nie była bivalue.
+    st.ensure_indices();
+    if (st.board->empty_cells - st.bivalue_count() != 1) {
+        s.elapsed_ns += st.now_ns() - t0;
+        return ApplyResult::NoProgress;
+    }
+
     int bug_idx = -1;
     int tri_count = 0;
     
     // Skan wszystkich pustych komórek, by sprawdzić warunek BUG (wszystko bivalue + 1 trivalue)
     for (int idx = 0; idx < st.topo->nn; ++idx) {
-        if (st.board->values[idx] != 0) continue;
+        if (st.board->values[idx] != 0 || st.is_bivalue(idx)) continue;
         
         const int cnt = std::popcount(st.cands[idx]);
         if (cnt < 2 || cnt > 3) {
@@ -62,9 +69,10 @@ inline ApplyResult apply_bug_plus_one(CandidateState& st, StrategyStats& s, Gene
     }
 
     // Znaleziono siatkę w stanie BUG+1. Analizujemy węzeł (Pivot), w którym są 3 cyfry.
+    const int n = st.topo->n;
     const int bug_row = st.topo->cell_row[bug_idx];
-    const int bug_col = st.topo->cell_col[bug_idx];
-    const int bug_box = st.topo->cell_box[bug_idx];
+    const int bug_col = n + st.topo->cell_col[bug_idx];
+    const int bug_box = 2 * n + st.topo->cell_box[bug_idx];
     const uint64_t m = st.cands[bug_idx];
     
     // Weryfikujemy każdą z trzech cyfr tego węzła. Tylko jedna z nich pozwala
@@ -75,25 +83,10 @@ inline ApplyResult apply_bug_plus_one(CandidateState& st, StrategyStats& s, Gene
         w = config::bit_clear_lsb_u64(w);
         
         const int d = static_cast<int>(bit) + 1;
-        int cnt_row = 0;
-        int cnt_col = 0;
-        int cnt_box = 0;
-
-        for (int c = 0; c < st.topo->n; ++c) {
-            const int idx = bug_row * st.topo->n + c;
-            if (st.board->values[idx] != 0) continue;
-            if ((st.cands[idx] & (1ULL << bit)) != 0ULL) ++cnt_row;
-        }
-        for (int rr = 0; rr < st.topo->n; ++rr) {
-            const int idx = rr * st.topo->n + bug_col;
-            if (st.board->values[idx] != 0) continue;
-            if ((st.cands[idx] & (1ULL << bit)) != 0ULL) ++cnt_col;
-        }
-        for (int idx = 0; idx < st.topo->nn; ++idx) {
-            if (st.topo->cell_box[idx] != bug_box) continue;
-            if (st.board->values[idx] != 0) continue;
-            if ((st.cands[idx] & (1ULL << bit)) != 0ULL) ++cnt_box;
-        }
+        // Liczniki pozycji cyfry w domkach utrzymywane przez CandidateState
+        const int cnt_row = st.house_digit_count(bug_row, d);
+        const int cnt_col = st.house_digit_count(bug_col, d);
+        const int cnt_box = st.house_digit_count(bug_box, d);
         
         // Ratunkiem dla BUG jest ta cyfra, która zaburza parzystość wystąpień we 
         // wszystkich trzech domkach (rzędzie, kolumnie i bloku)
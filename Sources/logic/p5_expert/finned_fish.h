@@ -42,6 +42,7 @@ inline ApplyResult apply_finned_x_wing_sashimi(
     auto& sp = shared::exact_pattern_scratchpad();
 
     for (int d = 1; d <= n; ++d) {
+        if (!st.digit_dirty(d)) continue;
         const uint64_t bit = (1ULL << (d - 1));
         
         // Reset bitboardów dla rzędów i kolumn
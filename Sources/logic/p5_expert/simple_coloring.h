@@ -32,6 +32,7 @@ inline ApplyResult apply_simple_coloring(CandidateState& st, StrategyStats& s, G
     int box_color1[64]{};
 
     for (int d = 1; d <= n; ++d) {
+        if (!st.digit_dirty(d)) continue;
         const uint64_t bit = (1ULL << (d - 1));
         if (!shared::build_grouped_link_graph_for_digit(st, d, sp)) continue;
         if (sp.dyn_strong_edge_count == 0) continue;
@@ -97,58 +97,69 @@ inline ApplyResult apply_w_wing(CandidateState& st, StrategyStats& s, GenericLog
     
     auto& sp = shared::exact_pattern_scratchpad();
 
-    // 1. Zbudowanie bufora silnych powiązań (Strong Links) per cyfra d.
-    // Używamy zintegrowanych tablic 2D (zero alloc) z shared/exact_pattern_scratchpad.
+    // 1. Zebranie komórek bivalue z indeksu CandidateState. W-Wing potrzebuje
+    // co najmniej dwóch komórek w jednym kubełku pary.
+    st.ensure_indices();
+    sp.als_cell_count = 0;
+    const int bivalue_count = st.collect_bivalue_cells(sp.wing_cells);
+    for (int i = 0; i < bivalue_count; ++i) {
+        const int idx = sp.wing_cells[i];
+        if (st.pair_bucket_size(st.cands[idx]) >= 2) {
+            sp.als_cells[sp.als_cell_count++] = idx;
+        }
+    }
+    if (sp.als_cell_count < 2) {
+        s.elapsed_ns += st.now_ns() - t0;
+        return ApplyResult::NoProgress;
+    }
+
+    // 2. Zbudowanie bufora silnych powiązań (Strong Links) per cyfra d.
+    // Flagi bilocation wskazują domki z dokładnie dwiema pozycjami cyfry.
     for (int d = 1; d <= n; ++d) {
         sp.strong_count[d] = 0;
-        const uint64_t bit = (1ULL << (d - 1));
-        
-        for (size_t h = 0; h + 1 < st.topo->house_offsets.size(); ++h) {
-            const int p0 = st.topo->house_offsets[h];
-            const int p1 = st.topo->house_offsets[h + 1];
-            int a = -1, b = -1, cnt = 0;
-            
-            for (int p = p0; p < p1; ++p) {
-                const int idx = st.topo->houses_flat[p];
-                if (st.board->values[idx] != 0) continue;
-                if ((st.cands[idx] & bit) == 0ULL) continue;
-                
-                if (cnt == 0) a = idx;
-                else if (cnt == 1) b = idx;
-                
-                ++cnt;
-                if (cnt > 2) break;
-            }
-            // Jeśli występuje tylko 2 razy - silne powiązanie (Strong Link)
-            if (cnt == 2 && a >= 0 && b >= 0) {
-                int at = sp.strong_count[d];
+    }
+    int first_pos[ExactPatternScratchpad::MAX_N]{};
+    for (size_t h = 0; h + 1 < st.topo->house_offsets.size(); ++h) {
+        const uint64_t bl = st.bilocation_digits(static_cast<int>(h));
+        if (bl == 0ULL) continue;
+        for (uint64_t w = bl; w != 0ULL; w = config::bit_clear_lsb_u64(w)) {
+            first_pos[config::bit_ctz_u64(w)] = -1;
+        }
+
+        const int p0 = st.topo->house_offsets[h];
+        const int p1 = st.topo->house_offsets[h + 1];
+        for (int p = p0; p < p1; ++p) {
+            const int idx = st.topo->houses_flat[p];
+            if (st.board->values[idx] != 0) continue;
+            for (uint64_t w = st.cands[idx] & bl; w != 0ULL; w = config::bit_clear_lsb_u64(w)) {
+                const int d0 = config::bit_ctz_u64(w);
+                if (first_pos[d0] < 0) {
+                    first_pos[d0] = idx;
+                    continue;
+                }
+                // Druga pozycja cyfry w domku - silne powiązanie (Strong Link)
+                const int d = d0 + 1;
+                const int at = sp.strong_count[d];
                 if (at < ExactPatternScratchpad::MAX_STRONG_LINKS_PER_DIGIT) {
-                    sp.strong_a[d][at] = a;
-                    sp.strong_b[d][at] = b;
+                    sp.strong_a[d][at] = first_pos[d0];
+                    sp.strong_b[d][at] = idx;
                     ++sp.strong_count[d];
                 }
             }
         }
     }
 
-    // 2. Zebranie komórek bivalue w płaską listę, aby nie robić N^2 skanów
-    sp.als_cell_count = 0; 
-    for (int idx = 0; idx < st.topo->nn; ++idx) {
-        if (st.board->values[idx] != 0) continue;
-        if (std::popcount(st.cands[idx]) == 2) {
-            sp.als_cells[sp.als_cell_count++] = idx;
-        }
-    }
-
     const int bn = sp.als_cell_count;
     for (int i = 0; i < bn; ++i) {
         const int a = sp.als_cells[i];
         const uint64_t ma = st.cands[a];
+        if (std::popcount(ma) != 2) continue;
         
-        for (int j = i + 1; j < bn; ++j) {
-            const int b = sp.als_cells[j];
+        // W-Wing dotyczy komórek o identycznych maskach - przeglądamy tylko kubełek pary.
+        for (int b = st.pair_bucket_first(ma); b >= 0; b = st.pair_bucket_next(b)) {
+            if (b <= a) continue;
             
-            // W-Wing dotyczy komórek o identycznych maskach, które się NIE widzą
+            // ...które się NIE widzą
             if (st.is_peer(a, b)) continue;
             const uint64_t mb = st.cands[b];
             
@@ -32,16 +32,16 @@ namespace sudoku_hpc::logic::p6_diabolical {
 // z wariantĂłw UR/BUG (Composite).
 // ============================================================================
 inline ApplyResult apply_borescoper_qiu_deadly_pattern(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
     
     // Heurystyka wczesnego wyjĹ›cia - brak blokĂłw (brak geometrii UR) lub plansza jest zbyt pusta
     if (st.topo->box_rows <= 1 || st.topo->box_cols <= 1) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
     if (st.board->empty_cells > (st.topo->nn - st.topo->n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
@@ -51,13 +51,13 @@ inline ApplyResult apply_borescoper_qiu_deadly_pattern(CandidateState& st, Strat
     // Unique Rectangles (Type 2-6) - z tÄ… rĂłĹĽnicÄ…, ĹĽe sÄ… mocniej rozrzucone.
     ApplyResult ar = apply_ur_extended(st, tmp, r);
     if (ar == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+        s.elapsed_ns += st.now_ns() - t0; 
         return ar; 
     }
     if (ar == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_borescoper_qiu_deadly_pattern = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
@@ -65,41 +65,41 @@ inline ApplyResult apply_borescoper_qiu_deadly_pattern(CandidateState& st, Strat
     // pokrywa czÄ™Ĺ›Ä‡ Qiu's Deadly Pattern.
     ar = apply_hidden_ur(st, tmp, r);
     if (ar == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+        s.elapsed_ns += st.now_ns() - t0; 
         return ar; 
     }
     if (ar == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_borescoper_qiu_deadly_pattern = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
     // Krok 3: Analiza BUG (Bivalue Universal Grave)
     ar = apply_bug_type2(st, tmp, r);
-    if (ar == ApplyResult::Contradiction) { s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; return ar; }
+    if (ar == ApplyResult::Contradiction) { s.elapsed_ns += st.now_ns() - t0; return ar; }
     if (ar == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_borescoper_qiu_deadly_pattern = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
     ar = apply_bug_type3(st, tmp, r);
-    if (ar == ApplyResult::Contradiction) { s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; return ar; }
+    if (ar == ApplyResult::Contradiction) { s.elapsed_ns += st.now_ns() - t0; return ar; }
     if (ar == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_borescoper_qiu_deadly_pattern = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
     ar = apply_bug_type4(st, tmp, r);
-    if (ar == ApplyResult::Contradiction) { s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; return ar; }
+    if (ar == ApplyResult::Contradiction) { s.elapsed_ns += st.now_ns() - t0; return ar; }
     if (ar == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_borescoper_qiu_deadly_pattern = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
@@ -146,7 +146,7 @@ inline ApplyResult apply_borescoper_qiu_deadly_pattern(CandidateState& st, Strat
                         // Wyeliminowanie 'pary' by nie zamknÄ…Ä‡ pÄ™tli
                         const ApplyResult er = st.eliminate(t, pair);
                         if (er == ApplyResult::Contradiction) { 
-                            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+                            s.elapsed_ns += st.now_ns() - t0; 
                             return er; 
                         }
                         if (er == ApplyResult::Progress) {
@@ -161,11 +161,11 @@ inline ApplyResult apply_borescoper_qiu_deadly_pattern(CandidateState& st, Strat
     if (progress) {
         ++s.hit_count;
         r.used_borescoper_qiu_deadly_pattern = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -54,18 +54,11 @@ inline ApplyResult apply_xy_chain(CandidateState& st, StrategyStats& s, GenericL
     const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
-    const int nn = st.topo->nn;
     const int max_depth = std::clamp(6 + st.topo->n / 2, 8, 16);
 
     auto& sp = shared::exact_pattern_scratchpad();
-    int bivalue_count = 0;
-
-    for (int idx = 0; idx < nn; ++idx) {
-        if (st.board->values[idx] != 0) continue;
-        if (std::popcount(st.cands[idx]) == 2) {
-            sp.als_cells[bivalue_count++] = idx;
-        }
-    }
+    st.ensure_indices();
+    const int bivalue_count = st.collect_bivalue_cells(sp.als_cells);
 
     if (bivalue_count < 3) {
         s.elapsed_ns += st.now_ns() - t0;
@@ -115,10 +108,9 @@ inline ApplyResult apply_xy_chain(CandidateState& st, StrategyStats& s, GenericL
                 const int p1 = st.topo->peer_offsets[cur_cell + 1];
                 for (int p = p0; p < p1; ++p) {
                     const int nxt = st.topo->peers_flat[p];
-                    if (st.board->values[nxt] != 0) continue;
+                    if (!st.is_bivalue(nxt)) continue;
 
                     const uint64_t nxt_mask = st.cands[nxt];
-                    if (std::popcount(nxt_mask) != 2) continue;
                     if ((nxt_mask & exit_bit) == 0ULL) continue;
                     if (path_contains_cell(ni, nxt)) continue;
 
@@ -239,6 +239,15 @@ inline ApplyResult apply_bivalue_oddagon(CandidateState& st, StrategyStats& s, G
     int cell_to_node[kMaxNN]{};
     int pivot_neighbors[kMaxNN]{};
 
+    st.ensure_indices();
+    if (st.bivalue_count() < 3) {
+        s.elapsed_ns += st.now_ns() - t0;
+        return ApplyResult::NoProgress;
+    }
+    for (int i = 0; i < nn; ++i) {
+        cell_to_node[i] = -1;
+    }
+
     for (int pivot = 0; pivot < nn; ++pivot) {
         if (st.board->values[pivot] != 0) continue;
         const uint64_t pm = st.cands[pivot];
@@ -253,19 +262,14 @@ inline ApplyResult apply_bivalue_oddagon(CandidateState& st, StrategyStats& s, G
                 const uint64_t b2 = w2 & (~w2 + 1ULL);
                 w2 &= (w2 - 1ULL);
                 const uint64_t pair = b1 | b2;
+                if (st.pair_bucket_size(pair) < 3) continue;
 
-                for (int i = 0; i < nn; ++i) {
-                    cell_to_node[i] = -1;
-                }
-
+                // Komórki o masce dokładnie {b1, b2} prosto z kubełka pary.
                 int strict_count = 0;
-                for (int idx = 0; idx < nn; ++idx) {
-                    if (st.board->values[idx] != 0) continue;
-                    if (st.cands[idx] != pair) continue;
+                for (int idx = st.pair_bucket_first(pair); idx >= 0; idx = st.pair_bucket_next(idx)) {
                     cell_to_node[idx] = strict_count;
                     strict_cells[strict_count++] = idx;
                 }
-                if (strict_count < 3) continue;
 
                 int neigh_cnt = 0;
                 const int p0 = st.topo->peer_offsets[pivot];
@@ -276,8 +280,6 @@ inline ApplyResult apply_bivalue_oddagon(CandidateState& st, StrategyStats& s, G
                     if (v < 0) continue;
                     pivot_neighbors[neigh_cnt++] = v;
                 }
-                if (neigh_cnt < 2) continue;
-
                 bool elim_pair_from_pivot = false;
                 for (int a = 0; a < neigh_cnt && !elim_pair_from_pivot; ++a) {
                     for (int b = a + 1; b < neigh_cnt && !elim_pair_from_pivot; ++b) {
@@ -292,6 +294,9 @@ inline ApplyResult apply_bivalue_oddagon(CandidateState& st, StrategyStats& s, G
                         }
                     }
                 }
+                for (int i = 0; i < strict_count; ++i) {
+                    cell_to_node[strict_cells[i]] = -1;
+                }
 
                 if (elim_pair_from_pivot) {
                     const ApplyResult er = st.eliminate(pivot, pair);
@@ -10,21 +10,16 @@
 #pragma once
 
 #include <algorithm>
-#include <chrono>
 #include <cstdint>
 
 #include "../../core/candidate_state.h"
 #include "../logic_result.h"
 #include "../shared/exact_pattern_scratchpad.h"
 #include "../shared/link_graph_builder.h"
+#include "../shared/work_budget.h"
 
 namespace sudoku_hpc::logic::p7_nightmare {
 
-inline uint64_t get_current_time_ns() {
-    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count());
-}
-
 inline bool aic_is_strong_neighbor(const shared::ExactPatternScratchpad& sp, int u, int v) {
     const int p0 = sp.dyn_strong_offsets[u];
     const int p1 = sp.dyn_strong_offsets[u + 1];
@@ -104,6 +99,7 @@ inline ApplyResult alternating_chain_core(
         for (int start = 0; start < sp.dyn_node_count; ++start) {
             const int start_cell = sp.dyn_node_to_cell[start];
             if (st.board->values[start_cell] != 0) continue;
+            if (!shared::work_charge(st)) return ApplyResult::NoProgress;
 
             for (int first_type = 1; first_type >= 0; --first_type) {
                 if (first_type == 0 && !allow_weak_start) continue;
@@ -195,12 +191,12 @@ inline ApplyResult bounded_implication_core(
     bool allow_weak_start,
     bool& used_flag) {
     (void)r;
-    const uint64_t t0 = get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int depth_cap = std::clamp(max_iters, 6, 28);
     const ApplyResult ar = alternating_chain_core(st, depth_cap, allow_weak_start, used_flag);
-    s.elapsed_ns += get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ar;
 }
 
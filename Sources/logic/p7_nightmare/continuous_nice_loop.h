@@ -55,7 +55,7 @@ inline int cnl_collect_neighbors(
 }
 
 inline ApplyResult apply_continuous_nice_loop(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int n = st.topo->n;
@@ -119,13 +119,13 @@ inline ApplyResult apply_continuous_nice_loop(CandidateState& st, StrategyStats&
                             if (next_type == first_type && dep >= 2) {
                                 if (first_type == 1) {
                                     if (!st.place(start_cell, d)) {
-                                        s.elapsed_ns += get_current_time_ns() - t0;
+                                        s.elapsed_ns += st.now_ns() - t0;
                                         return ApplyResult::Contradiction;
                                     }
                                 } else {
                                     const ApplyResult er = st.eliminate(start_cell, bit);
                                     if (er == ApplyResult::Contradiction) {
-                                        s.elapsed_ns += get_current_time_ns() - t0;
+                                        s.elapsed_ns += st.now_ns() - t0;
                                         return er;
                                     }
                                     if (er == ApplyResult::NoProgress) {
@@ -147,14 +147,14 @@ inline ApplyResult apply_continuous_nice_loop(CandidateState& st, StrategyStats&
                             ApplyResult er = ApplyResult::NoProgress;
                             if (next_type == 1) {
                                 if (!st.place(infer_cell, d)) {
-                                    s.elapsed_ns += get_current_time_ns() - t0;
+                                    s.elapsed_ns += st.now_ns() - t0;
                                     return ApplyResult::Contradiction;
                                 }
                                 er = ApplyResult::Progress;
                             } else {
                                 er = st.eliminate(infer_cell, bit);
                                 if (er == ApplyResult::Contradiction) {
-                                    s.elapsed_ns += get_current_time_ns() - t0;
+                                    s.elapsed_ns += st.now_ns() - t0;
                                     return er;
                                 }
                             }
@@ -179,11 +179,11 @@ inline ApplyResult apply_continuous_nice_loop(CandidateState& st, StrategyStats&
     if (any_progress) {
         ++s.hit_count;
         r.used_continuous_nice_loop = true;
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
-    s.elapsed_ns += get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -15,6 +15,7 @@
 #include "../../config/bit_utils.h"
 #include "../logic_result.h"
 #include "../shared/als_builder.h"
+#include "../shared/work_budget.h"
 
 namespace sudoku_hpc::logic::p7_nightmare {
 
@@ -169,6 +170,7 @@ inline ApplyResult death_blossom_mixed_petal_pass(
             if (cb == 0) continue;
 
             for (int a = 0; a < ca; ++a) {
+                if (!shared::work_charge(st)) return ApplyResult::NoProgress;
                 const DeathBlossomPetalRef petal_a = petal_refs[ia][a];
                 const uint64_t mask_a = death_blossom_petal_digit_mask(st, sp, petal_a);
                 for (int b = 0; b < cb; ++b) {
@@ -214,6 +216,7 @@ inline ApplyResult death_blossom_mixed_petal_pass(
                         const DeathBlossomPetalRef petal_b = petal_refs[ib][b];
                         if (death_blossom_petals_overlap(sp, petal_a, petal_b, words)) continue;
                         const uint64_t mask_b = death_blossom_petal_digit_mask(st, sp, petal_b);
+                        if (!shared::work_charge(st)) return ApplyResult::NoProgress;
 
                         for (int c = 0; c < cc; ++c) {
                             const DeathBlossomPetalRef petal_c = petal_refs[ic][c];
@@ -282,6 +285,7 @@ inline ApplyResult apply_death_blossom(CandidateState& st, StrategyStats& s, Gen
         const uint64_t pivot_mask = st.cands[pivot];
         const int pivot_pc = std::popcount(pivot_mask);
         if (pivot_pc < 3 || pivot_pc > 7) continue;
+        if (!shared::work_charge(st)) break;
 
         for (int i = 0; i < n; ++i) {
             petal_cnt[i] = 0;
@@ -415,7 +419,7 @@ inline ApplyResult apply_death_blossom(CandidateState& st, StrategyStats& s, Gen
         }
     }
 
-    if (!progress) {
+    if (!progress && !st.work_exhausted) {
         auto& sp = shared::exact_pattern_scratchpad();
         const int als_max_size = (n <= 16) ? 5 : ((n <= 25) ? 6 : 5);
         const int als_min_size = (n <= 25) ? 1 : 2;
@@ -429,6 +433,7 @@ inline ApplyResult apply_death_blossom(CandidateState& st, StrategyStats& s, Gen
             const uint64_t pivot_mask = st.cands[pivot];
             const int pivot_pc = std::popcount(pivot_mask);
             if (pivot_pc < 3 || pivot_pc > 7) continue;
+            if (!shared::work_charge(st)) break;
 
             int pivot_digit_cnt = 0;
             uint64_t w = pivot_mask;
@@ -474,6 +479,7 @@ inline ApplyResult apply_death_blossom(CandidateState& st, StrategyStats& s, Gen
                         if ((als_a.digit_mask & da) == 0ULL) continue;
                         const int pa_cnt = death_blossom_collect_als_holders(st, als_a, da, pa);
                         if (!death_blossom_all_holders_see_pivot(st, pivot, pa, pa_cnt)) continue;
+                        if (!shared::work_charge(st)) break;
 
                         for (int b = a + 1; b < limit; ++b) {
                             const shared::ALS& als_b = sp.als_list[b];
@@ -540,6 +546,7 @@ inline ApplyResult apply_death_blossom(CandidateState& st, StrategyStats& s, Gen
                                 if ((als_b.digit_mask & db) == 0ULL) continue;
                                 const int pb_cnt = death_blossom_collect_als_holders(st, als_b, db, pb);
                                 if (!death_blossom_all_holders_see_pivot(st, pivot, pb, pb_cnt)) continue;
+                                if (!shared::work_charge(st)) break;
 
                                 for (int c = b + 1; c < limit; ++c) {
                                     const shared::ALS& als_c = sp.als_list[c];
@@ -30,7 +30,7 @@ inline bool gx_is_strong_neighbor(const shared::ExactPatternScratchpad& sp, int
 }
 
 inline ApplyResult apply_grouped_x_cycle(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int n = st.topo->n;
@@ -109,7 +109,7 @@ inline ApplyResult apply_grouped_x_cycle(CandidateState& st, StrategyStats& s, G
                     const int cell = sp.dyn_node_to_cell[u];
                     const ApplyResult er = st.eliminate(cell, bit);
                     if (er == ApplyResult::Contradiction) {
-                        s.elapsed_ns += get_current_time_ns() - t0;
+                        s.elapsed_ns += st.now_ns() - t0;
                         return er;
                     }
                     any_progress = any_progress || (er == ApplyResult::Progress);
@@ -139,7 +139,7 @@ inline ApplyResult apply_grouped_x_cycle(CandidateState& st, StrategyStats& s, G
                     const int cell = sp.dyn_node_to_cell[u];
                     const ApplyResult er = st.eliminate(cell, bit);
                     if (er == ApplyResult::Contradiction) {
-                        s.elapsed_ns += get_current_time_ns() - t0;
+                        s.elapsed_ns += st.now_ns() - t0;
                         return er;
                     }
                     any_progress = any_progress || (er == ApplyResult::Progress);
@@ -166,7 +166,7 @@ inline ApplyResult apply_grouped_x_cycle(CandidateState& st, StrategyStats& s, G
 
                 const ApplyResult er = st.eliminate(t_cell, bit);
                 if (er == ApplyResult::Contradiction) {
-                    s.elapsed_ns += get_current_time_ns() - t0;
+                    s.elapsed_ns += st.now_ns() - t0;
                     return er;
                 }
                 any_progress = any_progress || (er == ApplyResult::Progress);
@@ -177,11 +177,11 @@ inline ApplyResult apply_grouped_x_cycle(CandidateState& st, StrategyStats& s, G
     if (any_progress) {
         ++s.hit_count;
         r.used_grouped_x_cycle = true;
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
-    s.elapsed_ns += get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
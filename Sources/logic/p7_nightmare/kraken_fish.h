@@ -464,25 +464,25 @@ inline ApplyResult apply_kraken_fish_direct(CandidateState& st) {
 }
 
 inline ApplyResult apply_kraken_fish(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     // Kraken patterns become useful in late game where fish body + tentacles
     // are constrained enough to produce deterministic eliminations.
     if (st.board->empty_cells > (st.topo->nn - st.topo->n)) {
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     ApplyResult ar = apply_kraken_fish_direct(st);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_kraken_fish = true;
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
@@ -490,13 +490,13 @@ inline ApplyResult apply_kraken_fish(CandidateState& st, StrategyStats& s, Gener
     StrategyStats tmp{};
     ar = p6_diabolical::apply_finned_swordfish_jellyfish(st, tmp, r);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_kraken_fish = true;
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
@@ -505,17 +505,17 @@ inline ApplyResult apply_kraken_fish(CandidateState& st, StrategyStats& s, Gener
     const int depth_cap = std::clamp(14 + (st.board->empty_cells / std::max(1, st.topo->n)), 16, 26);
     ar = alternating_chain_core(st, depth_cap, false, used);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress && used) {
         ++s.hit_count;
         r.used_kraken_fish = true;
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
-    s.elapsed_ns += get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -448,21 +448,21 @@ inline ApplyResult medusa_component_pass(
 }
 
 inline ApplyResult apply_medusa_3d(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int nn = st.topo->nn;
     const int n = st.topo->n;
     const int min_givens = std::max(4, n / 2);
     if (n > 64 || st.board->empty_cells > (nn - min_givens)) {
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     auto& sp = shared::exact_pattern_scratchpad();
     int bivalue_count = 0;
     if (!build_medusa_bivalue_graph(st, sp, bivalue_count)) {
-        s.elapsed_ns += get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
@@ -470,18 +470,18 @@ inline ApplyResult apply_medusa_3d(CandidateState& st, StrategyStats& s, Generic
         if (sp.medusa_color[node] != 0) continue;
         const ApplyResult ar = medusa_component_pass(st, sp, node);
         if (ar == ApplyResult::Contradiction) {
-            s.elapsed_ns += get_current_time_ns() - t0;
+            s.elapsed_ns += st.now_ns() - t0;
             return ar;
         }
         if (ar == ApplyResult::Progress) {
             ++s.hit_count;
             r.used_medusa_3d = true;
-            s.elapsed_ns += get_current_time_ns() - t0;
+            s.elapsed_ns += st.now_ns() - t0;
             return ar;
         }
     }
 
-    s.elapsed_ns += get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
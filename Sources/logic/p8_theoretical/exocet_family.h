@@ -1112,13 +1112,13 @@ inline ApplyResult exocet_structural_probe(
 }
 
 inline ApplyResult apply_exocet_exact(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int n = st.topo->n;
     const int nn = st.topo->nn;
     if (st.board->empty_cells > (nn - 4 * n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
@@ -1127,78 +1127,85 @@ inline ApplyResult apply_exocet_exact(CandidateState& st, StrategyStats& s, Gene
 
     const ApplyResult ar = exocet_structural_probe(st, pattern_cap, max_steps, false);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_exocet = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
 inline ApplyResult apply_exocet(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int n = st.topo->n;
     const int nn = st.topo->nn;
     if (st.board->empty_cells > (nn - 5 * n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     StrategyStats tmp{};
-    ApplyResult ar = apply_exocet_exact(st, tmp, r);
-    if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ar;
+    ApplyResult ar = ApplyResult::NoProgress;
+    if (st.tier_allows_exact()) {
+        ar = apply_exocet_exact(st, tmp, r);
+        if (ar == ApplyResult::Contradiction) {
+            s.elapsed_ns += st.now_ns() - t0;
+            return ar;
+        }
+        if (ar == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_exocet = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ar;
+        }
     }
-    if (ar == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_exocet = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ar;
+    if (!st.tier_allows_proxy()) {
+        s.elapsed_ns += st.now_ns() - t0;
+        return ApplyResult::NoProgress;
     }
 
     bool used = false;
     const int depth_cap = std::clamp(8 + st.board->empty_cells / std::max(1, n), 10, 16);
     ar = p7_nightmare::bounded_implication_core(st, tmp, r, depth_cap, used);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
     ar = p7_nightmare::apply_grouped_aic(st, tmp, r);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
 inline ApplyResult apply_senior_exocet(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int n = st.topo->n;
     const int nn = st.topo->nn;
     if (st.board->empty_cells > (nn - 6 * n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
@@ -1206,41 +1213,48 @@ inline ApplyResult apply_senior_exocet(CandidateState& st, StrategyStats& s, Gen
     const int pattern_cap = std::clamp(6 + n / 2, 8, 22);
     const int max_steps = std::clamp(10 + n / 3, 12, 20);
 
-    ApplyResult ar = exocet_structural_probe(st, pattern_cap, max_steps, true);
-    if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ar;
+    ApplyResult ar = ApplyResult::NoProgress;
+    if (st.tier_allows_exact()) {
+        ar = exocet_structural_probe(st, pattern_cap, max_steps, true);
+        if (ar == ApplyResult::Contradiction) {
+            s.elapsed_ns += st.now_ns() - t0;
+            return ar;
+        }
+        if (ar == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_senior_exocet = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ar;
+        }
     }
-    if (ar == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_senior_exocet = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ar;
+    if (!st.tier_allows_proxy()) {
+        s.elapsed_ns += st.now_ns() - t0;
+        return ApplyResult::NoProgress;
     }
 
     bool used = false;
     const int depth_cap = std::clamp(12 + st.board->empty_cells / std::max(1, n), 14, 24);
     ar = p7_nightmare::bounded_implication_core(st, tmp, r, depth_cap, used);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
     ar = apply_exocet(st, tmp, r);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
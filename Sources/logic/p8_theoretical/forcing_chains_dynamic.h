@@ -288,7 +288,7 @@ inline ApplyResult forcing_assertion_graph_pass(
     const int group_count = forcing_collect_assertion_groups(
         st, digit_cap, link_cap_per_digit, house_cap, house_max_places, groups, 128);
     forcing_build_assertion_adjacency(st, groups, group_count, offsets, degree, adj, 1024);
-    for (int i = 0; i < group_count; ++i) {
+    for (int i = 0; i < group_count && !st.work_exhausted; ++i) {
         const ApplyResult er = forcing_run_assertion_group(st, groups[i], max_steps, used_flag);
         if (er != ApplyResult::NoProgress) return er;
     }
@@ -307,7 +307,7 @@ inline ApplyResult forcing_strong_link_assertion_pass(
     uint64_t inter_cands[shared::ExactPatternScratchpad::MAX_NN]{};
     int tested_digits = 0;
 
-    for (int d = 1; d <= n; ++d) {
+    for (int d = 1; d <= n && !st.work_exhausted; ++d) {
         if (tested_digits >= digit_cap) return ApplyResult::NoProgress;
         if (!shared::build_grouped_link_graph_for_digit(st, d, sp)) continue;
         if (sp.dyn_strong_edge_count == 0) continue;
@@ -383,7 +383,7 @@ inline ApplyResult forcing_house_digit_assertion_pass(
     uint64_t inter_cands[shared::ExactPatternScratchpad::MAX_NN]{};
     int tested_houses = 0;
 
-    for (int h = 0; h < house_count; ++h) {
+    for (int h = 0; h < house_count && !st.work_exhausted; ++h) {
         if (tested_houses >= house_cap) return ApplyResult::NoProgress;
         const int p0 = st.topo->house_offsets[static_cast<size_t>(h)];
         const int p1 = st.topo->house_offsets[static_cast<size_t>(h + 1)];
@@ -461,7 +461,7 @@ inline ApplyResult forcing_dynamic_strong_link_pass(
     uint64_t nested_inter[shared::ExactPatternScratchpad::MAX_NN]{};
     int tested_digits = 0;
 
-    for (int d = 1; d <= n; ++d) {
+    for (int d = 1; d <= n && !st.work_exhausted; ++d) {
         if (tested_digits >= digit_cap) return ApplyResult::NoProgress;
         if (!shared::build_grouped_link_graph_for_digit(st, d, sp)) continue;
         if (sp.dyn_strong_edge_count == 0) continue;
@@ -573,6 +573,8 @@ inline ApplyResult forcing_dynamic_house_digit_pass(
     const int n = st.topo->n;
     const int nn = st.topo->nn;
     const int house_count = static_cast<int>(st.topo->house_offsets.size()) - 1;
+    // Surowe kopie `cands` (root/branch) omijają przyrostowe indeksy bivalue.
+    st.invalidate_indices();
     uint64_t inter_cands[shared::ExactPatternScratchpad::MAX_NN]{};
     uint64_t nested_inter[shared::ExactPatternScratchpad::MAX_NN]{};
     uint64_t root_cands[shared::ExactPatternScratchpad::MAX_NN]{};
@@ -587,7 +589,7 @@ inline ApplyResult forcing_dynamic_house_digit_pass(
     uint64_t branch_box_used[shared::ExactPatternScratchpad::MAX_N]{};
     int tested_houses = 0;
 
-    for (int h = 0; h < house_count; ++h) {
+    for (int h = 0; h < house_count && !st.work_exhausted; ++h) {
         if (tested_houses >= house_cap) return ApplyResult::NoProgress;
         const int p0 = st.topo->house_offsets[static_cast<size_t>(h)];
         const int p1 = st.topo->house_offsets[static_cast<size_t>(h + 1)];
@@ -742,7 +744,7 @@ inline ApplyResult forcing_dynamic_assertion_graph_pass(
     const int outer_count = forcing_collect_assertion_groups(
         st, digit_cap, link_cap_per_digit, house_cap, house_max_places, outer_groups, 128);
     forcing_build_assertion_adjacency(st, outer_groups, outer_count, offsets, degree, adj, 1024);
-    for (int gi = 0; gi < outer_count; ++gi) {
+    for (int gi = 0; gi < outer_count && !st.work_exhausted; ++gi) {
         const ForcingAssertionGroup& outer = outer_groups[gi];
         shared::snapshot_state(st, sp);
         for (int i = 0; i < nn; ++i) inter_cands[i] = ~0ULL;
@@ -915,7 +917,7 @@ inline ApplyResult forcing_convergence_pass(
     uint64_t inter_cands[shared::ExactPatternScratchpad::MAX_NN]{};
 
     for (int pass_pc = 2; pass_pc <= (allow_trivalue ? 3 : 2); ++pass_pc) {
-        for (int pivot = 0; pivot < nn; ++pivot) {
+        for (int pivot = 0; pivot < nn && !st.work_exhausted; ++pivot) {
             if (tested_pivots >= pivot_budget) return ApplyResult::NoProgress;
             if (st.board->values[pivot] != 0) continue;
             const uint64_t mask = st.cands[pivot];
@@ -996,7 +998,7 @@ inline ApplyResult apply_dynamic_forcing_convergence(
     uint64_t inter_cands[shared::ExactPatternScratchpad::MAX_NN]{};
     int tested_pivots = 0;
 
-    for (int pivot = 0; pivot < nn; ++pivot) {
+    for (int pivot = 0; pivot < nn && !st.work_exhausted; ++pivot) {
         if (tested_pivots >= pivot_budget) return ApplyResult::NoProgress;
         if (st.board->values[pivot] != 0) continue;
         const uint64_t mask = st.cands[pivot];
@@ -1113,7 +1115,7 @@ inline ApplyResult apply_dynamic_forcing_assumption(CandidateState& st, bool& us
     int tested_pivots = 0;
 
     for (int pass_pc = 2; pass_pc <= 3; ++pass_pc) {
-        for (int pivot = 0; pivot < nn; ++pivot) {
+        for (int pivot = 0; pivot < nn && !st.work_exhausted; ++pivot) {
             if (tested_pivots >= pivot_budget) return ApplyResult::NoProgress;
             if (st.board->values[pivot] != 0) continue;
             const uint64_t mask = st.cands[pivot];
@@ -1152,12 +1154,12 @@ inline ApplyResult apply_dynamic_forcing_assumption(CandidateState& st, bool& us
 // GĹĂ“WNY INTERFEJS Forcing Chains
 // ============================================================================
 inline ApplyResult apply_forcing_chains(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
     
     // Heurystyka odcinajÄ…ca (Tylko w pĂłĹşnych fazach ma to sens)
     if (st.board->empty_cells > (st.topo->nn - st.topo->n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
@@ -1172,26 +1174,26 @@ inline ApplyResult apply_forcing_chains(CandidateState& st, StrategyStats& s, Ge
     const ApplyResult ar_assert = forcing_assertion_graph_pass(
         st, assertion_digit_cap, assertion_link_cap, house_cap, house_places, convergence_steps, used_dynamic);
     if (ar_assert == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar_assert;
     }
     if (ar_assert == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_forcing_chains = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
     const int pivot_budget = std::clamp(6 + (st.topo->n / 2), 8, 24);
     const ApplyResult ar_conv = forcing_convergence_pass(st, pivot_budget, convergence_steps, false, used_dynamic);
     if (ar_conv == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar_conv;
     }
     if (ar_conv == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_forcing_chains = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
@@ -1199,13 +1201,13 @@ inline ApplyResult apply_forcing_chains(CandidateState& st, StrategyStats& s, Ge
     const ApplyResult ar_assumption = apply_dynamic_forcing_assumption(st, used_dynamic);
     
     if (ar_assumption == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+        s.elapsed_ns += st.now_ns() - t0; 
         return ar_assumption; 
     }
     if (ar_assumption == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_forcing_chains = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
@@ -1214,15 +1216,15 @@ inline ApplyResult apply_forcing_chains(CandidateState& st, StrategyStats& s, Ge
     
     const ApplyResult dyn = p7_nightmare::bounded_implication_core(st, tmp, r, depth_cap, used_dynamic);
     if (dyn == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+        s.elapsed_ns += st.now_ns() - t0; 
         return dyn; 
     }
     if (dyn == ApplyResult::Progress) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return dyn;
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -1231,7 +1233,7 @@ inline ApplyResult apply_forcing_chains(CandidateState& st, StrategyStats& s, Ge
 // Ewolucja zagnieĹĽdĹĽenia - wywoĹ‚anie jeszcze wiÄ™kszej iloĹ›ci wirtualnych BFS'Ăłw.
 // ============================================================================
 inline ApplyResult apply_dynamic_forcing_chains(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
     
     bool used_dynamic = false;
@@ -1245,25 +1247,25 @@ inline ApplyResult apply_dynamic_forcing_chains(CandidateState& st, StrategyStat
     const ApplyResult direct_assert = forcing_dynamic_assertion_graph_pass(
         st, dynamic_digit_cap, outer_link_cap, house_cap, outer_places, std::max(2, house_cap / 2), branch_steps, used_dynamic);
     if (direct_assert == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return direct_assert;
     }
     if (direct_assert == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_dynamic_forcing_chains = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
     const ApplyResult direct = apply_dynamic_forcing_convergence(st, used_dynamic);
     if (direct == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return direct;
     }
     if (direct == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_dynamic_forcing_chains = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
@@ -1271,15 +1273,15 @@ inline ApplyResult apply_dynamic_forcing_chains(CandidateState& st, StrategyStat
     const ApplyResult dyn_exact = apply_forcing_chains(st, tmp, r);
     
     if (dyn_exact == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+        s.elapsed_ns += st.now_ns() - t0; 
         return dyn_exact; 
     }
     if (dyn_exact == ApplyResult::Progress) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return dyn_exact;
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -772,59 +772,66 @@ inline ApplyResult apply_msls_direct(CandidateState& st) {
 }
 
 inline ApplyResult apply_msls(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int n = st.topo->n;
     const int nn = st.topo->nn;
     if (st.board->empty_cells > (nn - 5 * n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     StrategyStats tmp{};
 
-    ApplyResult ar = apply_msls_direct(st);
-    if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ar;
+    ApplyResult ar = ApplyResult::NoProgress;
+    if (st.tier_allows_exact()) {
+        ar = apply_msls_direct(st);
+        if (ar == ApplyResult::Contradiction) {
+            s.elapsed_ns += st.now_ns() - t0;
+            return ar;
+        }
+        if (ar == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_msls = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ar;
+        }
     }
-    if (ar == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_msls = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ar;
+    if (!st.tier_allows_proxy()) {
+        s.elapsed_ns += st.now_ns() - t0;
+        return ApplyResult::NoProgress;
     }
 
     const int depth_cap = std::clamp(8 + (st.board->empty_cells / std::max(1, n)), 10, 16);
     bool used_dynamic = false;
     ar = p7_nightmare::bounded_implication_core(st, tmp, r, depth_cap, used_dynamic);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
     ar = p7_nightmare::apply_grouped_x_cycle(st, tmp, r);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
     ar = p7_nightmare::apply_als_chain(st, tmp, r);
     if (ar == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
     if (ar == ApplyResult::Progress) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
@@ -832,16 +839,16 @@ inline ApplyResult apply_msls(CandidateState& st, StrategyStats& s, GenericLogic
     if (st.board->empty_cells <= (nn - 7 * n)) {
         ar = p7_nightmare::apply_kraken_fish(st, tmp, r);
         if (ar == ApplyResult::Contradiction) {
-            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+            s.elapsed_ns += st.now_ns() - t0;
             return ar;
         }
         if (ar == ApplyResult::Progress) {
-            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+            s.elapsed_ns += st.now_ns() - t0;
             return ar;
         }
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -152,17 +152,19 @@ inline ApplyResult apply_pom_global_digit_hexa_family_exact(
     CandidateState& st,
     StrategyStats& s,
     GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int nn = st.topo->nn;
     const int n = st.topo->n;
     if (!pom_hexa_global_family_allowed(st)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     const int house_count = static_cast<int>(st.topo->house_offsets.size()) - 1;
+    // Surowe kopie `cands` (root/branch) omijają przyrostowe indeksy bivalue.
+    st.invalidate_indices();
     const int house_budget = 6;
     const int branch_steps = std::clamp(6 + n / 4, 8, 12);
     const int probe_steps = std::clamp(6 + n / 3, 8, 12);
@@ -202,7 +204,7 @@ inline ApplyResult apply_pom_global_digit_hexa_family_exact(
     uint64_t level5_box_used[shared::ExactPatternScratchpad::MAX_N]{};
     auto& sp = shared::exact_pattern_scratchpad();
 
-    for (int d = 1; d <= n; ++d) {
+    for (int d = 1; d <= n && !st.work_exhausted; ++d) {
         const uint64_t bit = (1ULL << (d - 1));
         int hc = 0;
         for (int h = 0; h < house_count && hc < ExactPatternScratchpad::MAX_HOUSES; ++h) {
@@ -226,12 +228,12 @@ inline ApplyResult apply_pom_global_digit_hexa_family_exact(
         pom_sort_house_candidates(houses, counts, hc);
         const int limit = std::min(hc, house_budget);
 
-        for (int h1i = 0; h1i < limit; ++h1i) {
-            for (int h2i = h1i + 1; h2i < limit; ++h2i) {
-                for (int h3i = h2i + 1; h3i < limit; ++h3i) {
-                    for (int h4i = h3i + 1; h4i < limit; ++h4i) {
-                        for (int h5i = h4i + 1; h5i < limit; ++h5i) {
-                            for (int h6i = h5i + 1; h6i < limit; ++h6i) {
+        for (int h1i = 0; h1i < limit && !st.work_exhausted; ++h1i) {
+            for (int h2i = h1i + 1; h2i < limit && !st.work_exhausted; ++h2i) {
+                for (int h3i = h2i + 1; h3i < limit && !st.work_exhausted; ++h3i) {
+                    for (int h4i = h3i + 1; h4i < limit && !st.work_exhausted; ++h4i) {
+                        for (int h5i = h4i + 1; h5i < limit && !st.work_exhausted; ++h5i) {
+                            for (int h6i = h5i + 1; h6i < limit && !st.work_exhausted; ++h6i) {
                                 const int hs[6] = {houses[h1i], houses[h2i], houses[h3i], houses[h4i], houses[h5i], houses[h6i]};
                                 int* cell_sets[6] = {cells1, cells2, cells3, cells4, cells5, cells6};
                                 int counts_local[6] = {};
@@ -416,13 +418,13 @@ inline ApplyResult apply_pom_global_digit_hexa_family_exact(
 
                                 const ApplyResult house_er = pom_apply_house_overlay_elims(st, inter_cands);
                                 if (house_er == ApplyResult::Contradiction) {
-                                    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                    s.elapsed_ns += st.now_ns() - t0;
                                     return house_er;
                                 }
                                 if (house_er == ApplyResult::Progress) {
                                     ++s.hit_count;
                                     r.used_pattern_overlay_method = true;
-                                    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                    s.elapsed_ns += st.now_ns() - t0;
                                     return ApplyResult::Progress;
                                 }
 
@@ -441,13 +443,13 @@ inline ApplyResult apply_pom_global_digit_hexa_family_exact(
                                         if (!pom_probe_candidate_contradiction(st, idx, dd, probe_steps, sp)) continue;
                                         const ApplyResult er = st.eliminate(idx, rm_bit);
                                         if (er == ApplyResult::Contradiction) {
-                                            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                            s.elapsed_ns += st.now_ns() - t0;
                                             return er;
                                         }
                                         if (er == ApplyResult::Progress) {
                                             ++s.hit_count;
                                             r.used_pattern_overlay_method = true;
-                                            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                            s.elapsed_ns += st.now_ns() - t0;
                                             return ApplyResult::Progress;
                                         }
                                     }
@@ -460,7 +462,7 @@ inline ApplyResult apply_pom_global_digit_hexa_family_exact(
         }
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -468,17 +470,18 @@ inline ApplyResult apply_pom_global_digit_penta_family_exact(
     CandidateState& st,
     StrategyStats& s,
     GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int nn = st.topo->nn;
     const int n = st.topo->n;
     if (!pom_penta_global_family_allowed(st)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     const int house_count = static_cast<int>(st.topo->house_offsets.size()) - 1;
+    st.invalidate_indices();
     const int house_budget = std::clamp(4 + n / 8, 5, 6);
     const int branch_steps = std::clamp(6 + n / 4, 8, 14);
     const int probe_steps = std::clamp(6 + n / 3, 8, 14);
@@ -513,7 +516,7 @@ inline ApplyResult apply_pom_global_digit_penta_family_exact(
     uint64_t level4_box_used[shared::ExactPatternScratchpad::MAX_N]{};
     auto& sp = shared::exact_pattern_scratchpad();
 
-    for (int d = 1; d <= n; ++d) {
+    for (int d = 1; d <= n && !st.work_exhausted; ++d) {
         const uint64_t bit = (1ULL << (d - 1));
         int hc = 0;
         for (int h = 0; h < house_count && hc < ExactPatternScratchpad::MAX_HOUSES; ++h) {
@@ -537,11 +540,11 @@ inline ApplyResult apply_pom_global_digit_penta_family_exact(
         pom_sort_house_candidates(houses, counts, hc);
         const int limit = std::min(hc, house_budget);
 
-        for (int h1i = 0; h1i < limit; ++h1i) {
-            for (int h2i = h1i + 1; h2i < limit; ++h2i) {
-                for (int h3i = h2i + 1; h3i < limit; ++h3i) {
-                    for (int h4i = h3i + 1; h4i < limit; ++h4i) {
-                        for (int h5i = h4i + 1; h5i < limit; ++h5i) {
+        for (int h1i = 0; h1i < limit && !st.work_exhausted; ++h1i) {
+            for (int h2i = h1i + 1; h2i < limit && !st.work_exhausted; ++h2i) {
+                for (int h3i = h2i + 1; h3i < limit && !st.work_exhausted; ++h3i) {
+                    for (int h4i = h3i + 1; h4i < limit && !st.work_exhausted; ++h4i) {
+                        for (int h5i = h4i + 1; h5i < limit && !st.work_exhausted; ++h5i) {
                             const int h1 = houses[h1i];
                             const int h2 = houses[h2i];
                             const int h3 = houses[h3i];
@@ -715,13 +718,13 @@ inline ApplyResult apply_pom_global_digit_penta_family_exact(
 
                             const ApplyResult house_er = pom_apply_house_overlay_elims(st, inter_cands);
                             if (house_er == ApplyResult::Contradiction) {
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return house_er;
                             }
                             if (house_er == ApplyResult::Progress) {
                                 ++s.hit_count;
                                 r.used_pattern_overlay_method = true;
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return ApplyResult::Progress;
                             }
 
@@ -740,13 +743,13 @@ inline ApplyResult apply_pom_global_digit_penta_family_exact(
                                     if (!pom_probe_candidate_contradiction(st, idx, dd, probe_steps, sp)) continue;
                                     const ApplyResult er = st.eliminate(idx, rm_bit);
                                     if (er == ApplyResult::Contradiction) {
-                                        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                        s.elapsed_ns += st.now_ns() - t0;
                                         return er;
                                     }
                                     if (er == ApplyResult::Progress) {
                                         ++s.hit_count;
                                         r.used_pattern_overlay_method = true;
-                                        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                        s.elapsed_ns += st.now_ns() - t0;
                                         return ApplyResult::Progress;
                                     }
                                 }
@@ -758,7 +761,7 @@ inline ApplyResult apply_pom_global_digit_penta_family_exact(
         }
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -766,17 +769,18 @@ inline ApplyResult apply_pom_global_digit_quad_family_exact(
     CandidateState& st,
     StrategyStats& s,
     GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int nn = st.topo->nn;
     const int n = st.topo->n;
     if (!pom_quad_global_family_allowed(st)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     const int house_count = static_cast<int>(st.topo->house_offsets.size()) - 1;
+    st.invalidate_indices();
     const int house_budget = std::clamp(4 + n / 8, 5, 6);
     const int branch_steps = std::clamp(6 + n / 4, 8, 14);
     const int probe_steps = std::clamp(6 + n / 3, 8, 14);
@@ -806,7 +810,7 @@ inline ApplyResult apply_pom_global_digit_quad_family_exact(
     uint64_t level3_box_used[shared::ExactPatternScratchpad::MAX_N]{};
     auto& sp = shared::exact_pattern_scratchpad();
 
-    for (int d = 1; d <= n; ++d) {
+    for (int d = 1; d <= n && !st.work_exhausted; ++d) {
         const uint64_t bit = (1ULL << (d - 1));
         int hc = 0;
         for (int h = 0; h < house_count && hc < ExactPatternScratchpad::MAX_HOUSES; ++h) {
@@ -830,10 +834,10 @@ inline ApplyResult apply_pom_global_digit_quad_family_exact(
         pom_sort_house_candidates(houses, counts, hc);
         const int limit = std::min(hc, house_budget);
 
-        for (int h1i = 0; h1i < limit; ++h1i) {
-            for (int h2i = h1i + 1; h2i < limit; ++h2i) {
-                for (int h3i = h2i + 1; h3i < limit; ++h3i) {
-                    for (int h4i = h3i + 1; h4i < limit; ++h4i) {
+        for (int h1i = 0; h1i < limit && !st.work_exhausted; ++h1i) {
+            for (int h2i = h1i + 1; h2i < limit && !st.work_exhausted; ++h2i) {
+                for (int h3i = h2i + 1; h3i < limit && !st.work_exhausted; ++h3i) {
+                    for (int h4i = h3i + 1; h4i < limit && !st.work_exhausted; ++h4i) {
                         const int h1 = houses[h1i];
                         const int h2 = houses[h2i];
                         const int h3 = houses[h3i];
@@ -975,13 +979,13 @@ inline ApplyResult apply_pom_global_digit_quad_family_exact(
 
                         const ApplyResult house_er = pom_apply_house_overlay_elims(st, inter_cands);
                         if (house_er == ApplyResult::Contradiction) {
-                            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                            s.elapsed_ns += st.now_ns() - t0;
                             return house_er;
                         }
                         if (house_er == ApplyResult::Progress) {
                             ++s.hit_count;
                             r.used_pattern_overlay_method = true;
-                            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                            s.elapsed_ns += st.now_ns() - t0;
                             return ApplyResult::Progress;
                         }
 
@@ -1000,13 +1004,13 @@ inline ApplyResult apply_pom_global_digit_quad_family_exact(
                                 if (!pom_probe_candidate_contradiction(st, idx, dd, probe_steps, sp)) continue;
                                 const ApplyResult er = st.eliminate(idx, rm_bit);
                                 if (er == ApplyResult::Contradiction) {
-                                    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                    s.elapsed_ns += st.now_ns() - t0;
                                     return er;
                                 }
                                 if (er == ApplyResult::Progress) {
                                     ++s.hit_count;
                                     r.used_pattern_overlay_method = true;
-                                    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                    s.elapsed_ns += st.now_ns() - t0;
                                     return ApplyResult::Progress;
                                 }
                             }
@@ -1017,7 +1021,7 @@ inline ApplyResult apply_pom_global_digit_quad_family_exact(
         }
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -1025,17 +1029,18 @@ inline ApplyResult apply_pom_global_digit_family_exact(
     CandidateState& st,
     StrategyStats& s,
     GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int nn = st.topo->nn;
     const int n = st.topo->n;
     if (!pom_global_family_allowed(st)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     const int house_count = static_cast<int>(st.topo->house_offsets.size()) - 1;
+    st.invalidate_indices();
     const int house_budget = std::clamp(4 + n / 8, 5, 7);
     const int branch_steps = std::clamp(6 + n / 4, 8, 14);
     const int probe_steps = std::clamp(6 + n / 3, 8, 14);
@@ -1060,7 +1065,7 @@ inline ApplyResult apply_pom_global_digit_family_exact(
     uint64_t level2_box_used[shared::ExactPatternScratchpad::MAX_N]{};
     auto& sp = shared::exact_pattern_scratchpad();
 
-    for (int d = 1; d <= n; ++d) {
+    for (int d = 1; d <= n && !st.work_exhausted; ++d) {
         const uint64_t bit = (1ULL << (d - 1));
         int hc = 0;
         for (int h = 0; h < house_count && hc < ExactPatternScratchpad::MAX_HOUSES; ++h) {
@@ -1084,9 +1089,9 @@ inline ApplyResult apply_pom_global_digit_family_exact(
         pom_sort_house_candidates(houses, counts, hc);
         const int limit = std::min(hc, house_budget);
 
-        for (int h1i = 0; h1i < limit; ++h1i) {
-            for (int h2i = h1i + 1; h2i < limit; ++h2i) {
-                for (int h3i = h2i + 1; h3i < limit; ++h3i) {
+        for (int h1i = 0; h1i < limit && !st.work_exhausted; ++h1i) {
+            for (int h2i = h1i + 1; h2i < limit && !st.work_exhausted; ++h2i) {
+                for (int h3i = h2i + 1; h3i < limit && !st.work_exhausted; ++h3i) {
                     const int h1 = houses[h1i];
                     const int h2 = houses[h2i];
                     const int h3 = houses[h3i];
@@ -1195,13 +1200,13 @@ inline ApplyResult apply_pom_global_digit_family_exact(
 
                     const ApplyResult house_er = pom_apply_house_overlay_elims(st, inter_cands);
                     if (house_er == ApplyResult::Contradiction) {
-                        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                        s.elapsed_ns += st.now_ns() - t0;
                         return house_er;
                     }
                     if (house_er == ApplyResult::Progress) {
                         ++s.hit_count;
                         r.used_pattern_overlay_method = true;
-                        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                        s.elapsed_ns += st.now_ns() - t0;
                         return ApplyResult::Progress;
                     }
 
@@ -1220,13 +1225,13 @@ inline ApplyResult apply_pom_global_digit_family_exact(
                             if (!pom_probe_candidate_contradiction(st, idx, dd, probe_steps, sp)) continue;
                             const ApplyResult er = st.eliminate(idx, rm_bit);
                             if (er == ApplyResult::Contradiction) {
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return er;
                             }
                             if (er == ApplyResult::Progress) {
                                 ++s.hit_count;
                                 r.used_pattern_overlay_method = true;
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return ApplyResult::Progress;
                             }
                         }
@@ -1236,7 +1241,7 @@ inline ApplyResult apply_pom_global_digit_family_exact(
         }
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -1244,17 +1249,18 @@ inline ApplyResult apply_pom_digit_pair_family_exact(
     CandidateState& st,
     StrategyStats& s,
     GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     const int nn = st.topo->nn;
     const int n = st.topo->n;
     if (st.board->empty_cells > (nn - 6 * n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     const int house_count = static_cast<int>(st.topo->house_offsets.size()) - 1;
+    st.invalidate_indices();
     const int house_budget = std::clamp(3 + n / 8, 4, 8);
     const int branch_steps = std::clamp(6 + n / 4, 8, 14);
     const int probe_steps = std::clamp(6 + n / 3, 8, 14);
@@ -1275,7 +1281,7 @@ inline ApplyResult apply_pom_digit_pair_family_exact(
     uint64_t branch_box_used[shared::ExactPatternScratchpad::MAX_N]{};
     auto& sp = shared::exact_pattern_scratchpad();
 
-    for (int d = 1; d <= n; ++d) {
+    for (int d = 1; d <= n && !st.work_exhausted; ++d) {
         const uint64_t bit = (1ULL << (d - 1));
         int hc = 0;
         for (int h = 0; h < house_count && hc < ExactPatternScratchpad::MAX_HOUSES; ++h) {
@@ -1299,8 +1305,8 @@ inline ApplyResult apply_pom_digit_pair_family_exact(
         pom_sort_house_candidates(houses, counts, hc);
         const int limit = std::min(hc, house_budget);
 
-        for (int hi = 0; hi < limit; ++hi) {
-            for (int hj = hi + 1; hj < limit; ++hj) {
+        for (int hi = 0; hi < limit && !st.work_exhausted; ++hi) {
+            for (int hj = hi + 1; hj < limit && !st.work_exhausted; ++hj) {
                 const int h1 = houses[hi];
                 const int h2 = houses[hj];
                 int c1 = 0;
@@ -1379,13 +1385,13 @@ inline ApplyResult apply_pom_digit_pair_family_exact(
 
                 const ApplyResult house_er = pom_apply_house_overlay_elims(st, inter_cands);
                 if (house_er == ApplyResult::Contradiction) {
-                    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                    s.elapsed_ns += st.now_ns() - t0;
                     return house_er;
                 }
                 if (house_er == ApplyResult::Progress) {
                     ++s.hit_count;
                     r.used_pattern_overlay_method = true;
-                    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                    s.elapsed_ns += st.now_ns() - t0;
                     return ApplyResult::Progress;
                 }
 
@@ -1404,13 +1410,13 @@ inline ApplyResult apply_pom_digit_pair_family_exact(
                         if (!pom_probe_candidate_contradiction(st, idx, dd, probe_steps, sp)) continue;
                         const ApplyResult er = st.eliminate(idx, rm_bit);
                         if (er == ApplyResult::Contradiction) {
-                            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                            s.elapsed_ns += st.now_ns() - t0;
                             return er;
                         }
                         if (er == ApplyResult::Progress) {
                             ++s.hit_count;
                             r.used_pattern_overlay_method = true;
-                            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                            s.elapsed_ns += st.now_ns() - t0;
                             return ApplyResult::Progress;
                         }
                     }
@@ -1419,7 +1425,7 @@ inline ApplyResult apply_pom_digit_pair_family_exact(
         }
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -1427,14 +1433,14 @@ inline ApplyResult apply_pom_digit_family_exact(
     CandidateState& st,
     StrategyStats& s,
     GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
 
     auto& sp = shared::exact_pattern_scratchpad();
     const int nn = st.topo->nn;
     const int n = st.topo->n;
     if (st.board->empty_cells > (nn - 6 * n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
@@ -1447,7 +1453,7 @@ inline ApplyResult apply_pom_digit_family_exact(
     int counts[ExactPatternScratchpad::MAX_HOUSES]{};
     int house_cells[64]{};
 
-    for (int d = 1; d <= n; ++d) {
+    for (int d = 1; d <= n && !st.work_exhausted; ++d) {
         const uint64_t bit = (1ULL << (d - 1));
         int hc = 0;
         for (int h = 0; h < house_count && hc < ExactPatternScratchpad::MAX_HOUSES; ++h) {
@@ -1471,7 +1477,7 @@ inline ApplyResult apply_pom_digit_family_exact(
         pom_sort_house_candidates(houses, counts, hc);
 
         const int limit = std::min(hc, house_budget);
-        for (int hi = 0; hi < limit; ++hi) {
+        for (int hi = 0; hi < limit && !st.work_exhausted; ++hi) {
             const int h = houses[hi];
             const int p0 = st.topo->house_offsets[static_cast<size_t>(h)];
             const int p1 = st.topo->house_offsets[static_cast<size_t>(h + 1)];
@@ -1517,13 +1523,13 @@ inline ApplyResult apply_pom_digit_family_exact(
                     if ((contradiction_mask & (1ULL << ci)) == 0ULL) continue;
                     const ApplyResult er = st.eliminate(house_cells[ci], bit);
                     if (er == ApplyResult::Contradiction) {
-                        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                        s.elapsed_ns += st.now_ns() - t0;
                         return er;
                     }
                     if (er == ApplyResult::Progress) {
                         ++s.hit_count;
                         r.used_pattern_overlay_method = true;
-                        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                        s.elapsed_ns += st.now_ns() - t0;
                         return ApplyResult::Progress;
                     }
                 }
@@ -1532,13 +1538,13 @@ inline ApplyResult apply_pom_digit_family_exact(
             if (valid_hyp >= 2) {
                 const ApplyResult house_er = pom_apply_house_overlay_elims(st, inter_cands);
                 if (house_er == ApplyResult::Contradiction) {
-                    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                    s.elapsed_ns += st.now_ns() - t0;
                     return house_er;
                 }
                 if (house_er == ApplyResult::Progress) {
                     ++s.hit_count;
                     r.used_pattern_overlay_method = true;
-                    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                    s.elapsed_ns += st.now_ns() - t0;
                     return ApplyResult::Progress;
                 }
 
@@ -1557,13 +1563,13 @@ inline ApplyResult apply_pom_digit_family_exact(
                         if (!pom_probe_candidate_contradiction(st, idx, dd, probe_steps, sp)) continue;
                         const ApplyResult er = st.eliminate(idx, rm_bit);
                         if (er == ApplyResult::Contradiction) {
-                            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                            s.elapsed_ns += st.now_ns() - t0;
                             return er;
                         }
                         if (er == ApplyResult::Progress) {
                             ++s.hit_count;
                             r.used_pattern_overlay_method = true;
-                            s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                            s.elapsed_ns += st.now_ns() - t0;
                             return ApplyResult::Progress;
                         }
                     }
@@ -1572,7 +1578,7 @@ inline ApplyResult apply_pom_digit_family_exact(
         }
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -1581,14 +1587,14 @@ inline ApplyResult apply_pom_digit_family_exact(
 // Operuje na pĹ‚ytkim drzewie DFS dla wybranej, najbardziej ograniczonej komĂłrki.
 // ============================================================================
 inline ApplyResult apply_pom_exact(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
     
     auto& sp = shared::exact_pattern_scratchpad();
     const int nn = st.topo->nn;
     const int n = st.topo->n;
     if (st.board->empty_cells > (nn - 6 * n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
@@ -1605,13 +1611,13 @@ inline ApplyResult apply_pom_exact(CandidateState& st, StrategyStats& s, Generic
         if (pivot_cnt >= pivot_budget) break;
     }
     if (pivot_cnt == 0) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     const int hyp_steps = std::clamp(6 + n / 4, 8, 12);
     const int probe_steps = std::clamp(6 + n / 3, 8, 14);
-    for (int pi = 0; pi < pivot_cnt; ++pi) {
+    for (int pi = 0; pi < pivot_cnt && !st.work_exhausted; ++pi) {
         const int pivot = pivots[pi];
         const uint64_t pm = st.cands[pivot];
         if (pm == 0ULL) continue;
@@ -1659,13 +1665,13 @@ inline ApplyResult apply_pom_exact(CandidateState& st, StrategyStats& s, Generic
         if (contradiction_mask != 0ULL) {
             const ApplyResult er = st.eliminate(pivot, contradiction_mask);
             if (er == ApplyResult::Contradiction) {
-                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                s.elapsed_ns += st.now_ns() - t0;
                 return er;
             }
             if (er == ApplyResult::Progress) {
                 ++s.hit_count;
                 r.used_pattern_overlay_method = true;
-                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                s.elapsed_ns += st.now_ns() - t0;
                 return ApplyResult::Progress;
             }
         }
@@ -1675,13 +1681,13 @@ inline ApplyResult apply_pom_exact(CandidateState& st, StrategyStats& s, Generic
         if (valid_hyp >= 2) {
             const ApplyResult house_er = pom_apply_house_overlay_elims(st, inter_cands);
             if (house_er == ApplyResult::Contradiction) {
-                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                s.elapsed_ns += st.now_ns() - t0;
                 return house_er;
             }
             if (house_er == ApplyResult::Progress) {
                 ++s.hit_count;
                 r.used_pattern_overlay_method = true;
-                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                s.elapsed_ns += st.now_ns() - t0;
                 return ApplyResult::Progress;
             }
 
@@ -1700,13 +1706,13 @@ inline ApplyResult apply_pom_exact(CandidateState& st, StrategyStats& s, Generic
                     if (!pom_probe_candidate_contradiction(st, idx, d, probe_steps, sp)) continue;
                     const ApplyResult er = st.eliminate(idx, bit);
                     if (er == ApplyResult::Contradiction) {
-                        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                        s.elapsed_ns += st.now_ns() - t0;
                         return er;
                     }
                     if (er == ApplyResult::Progress) {
                         ++s.hit_count;
                         r.used_pattern_overlay_method = true;
-                        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                        s.elapsed_ns += st.now_ns() - t0;
                         return ApplyResult::Progress;
                     }
                 }
@@ -1714,7 +1720,7 @@ inline ApplyResult apply_pom_exact(CandidateState& st, StrategyStats& s, Generic
         }
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -1722,130 +1728,137 @@ inline ApplyResult apply_pom_exact(CandidateState& st, StrategyStats& s, Generic
 // GĹ‚Ăłwny kontroler Ĺ‚Ä…czÄ…cy nakĹ‚adanie masek z kompozycjÄ… MSLS i Ryb (P8)
 // ============================================================================
 inline ApplyResult apply_pattern_overlay_method(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
     
     const int n = st.topo->n;
     const int nn = st.topo->nn;
     if (st.board->empty_cells > (nn - 7 * n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
 
     StrategyStats tmp{};
+    const bool run_exact = st.tier_allows_exact();
     
-    // Krok 1: Global digit overlay family.
-    const ApplyResult hexa_global_family_exact = apply_pom_global_digit_hexa_family_exact(st, tmp, r);
-    if (hexa_global_family_exact == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return hexa_global_family_exact;
-    }
-    if (hexa_global_family_exact == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_pattern_overlay_method = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ApplyResult::Progress;
-    }
+    if (run_exact) {
+        // Krok 1: Global digit overlay family.
+        const ApplyResult hexa_global_family_exact = apply_pom_global_digit_hexa_family_exact(st, tmp, r);
+        if (hexa_global_family_exact == ApplyResult::Contradiction) {
+            s.elapsed_ns += st.now_ns() - t0;
+            return hexa_global_family_exact;
+        }
+        if (hexa_global_family_exact == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_pattern_overlay_method = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ApplyResult::Progress;
+        }
 
-    const ApplyResult penta_global_family_exact = apply_pom_global_digit_penta_family_exact(st, tmp, r);
-    if (penta_global_family_exact == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return penta_global_family_exact;
-    }
-    if (penta_global_family_exact == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_pattern_overlay_method = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ApplyResult::Progress;
-    }
+        const ApplyResult penta_global_family_exact = apply_pom_global_digit_penta_family_exact(st, tmp, r);
+        if (penta_global_family_exact == ApplyResult::Contradiction) {
+            s.elapsed_ns += st.now_ns() - t0;
+            return penta_global_family_exact;
+        }
+        if (penta_global_family_exact == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_pattern_overlay_method = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ApplyResult::Progress;
+        }
 
-    const ApplyResult quad_global_family_exact = apply_pom_global_digit_quad_family_exact(st, tmp, r);
-    if (quad_global_family_exact == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return quad_global_family_exact;
-    }
-    if (quad_global_family_exact == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_pattern_overlay_method = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ApplyResult::Progress;
-    }
+        const ApplyResult quad_global_family_exact = apply_pom_global_digit_quad_family_exact(st, tmp, r);
+        if (quad_global_family_exact == ApplyResult::Contradiction) {
+            s.elapsed_ns += st.now_ns() - t0;
+            return quad_global_family_exact;
+        }
+        if (quad_global_family_exact == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_pattern_overlay_method = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ApplyResult::Progress;
+        }
 
-    const ApplyResult global_family_exact = apply_pom_global_digit_family_exact(st, tmp, r);
-    if (global_family_exact == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return global_family_exact;
-    }
-    if (global_family_exact == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_pattern_overlay_method = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ApplyResult::Progress;
-    }
+        const ApplyResult global_family_exact = apply_pom_global_digit_family_exact(st, tmp, r);
+        if (global_family_exact == ApplyResult::Contradiction) {
+            s.elapsed_ns += st.now_ns() - t0;
+            return global_family_exact;
+        }
+        if (global_family_exact == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_pattern_overlay_method = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ApplyResult::Progress;
+        }
 
-    const ApplyResult pair_family_exact = apply_pom_digit_pair_family_exact(st, tmp, r);
-    if (pair_family_exact == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return pair_family_exact;
-    }
-    if (pair_family_exact == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_pattern_overlay_method = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ApplyResult::Progress;
-    }
+        const ApplyResult pair_family_exact = apply_pom_digit_pair_family_exact(st, tmp, r);
+        if (pair_family_exact == ApplyResult::Contradiction) {
+            s.elapsed_ns += st.now_ns() - t0;
+            return pair_family_exact;
+        }
+        if (pair_family_exact == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_pattern_overlay_method = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ApplyResult::Progress;
+        }
 
-    const ApplyResult family_exact = apply_pom_digit_family_exact(st, tmp, r);
-    if (family_exact == ApplyResult::Contradiction) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return family_exact;
-    }
-    if (family_exact == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_pattern_overlay_method = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ApplyResult::Progress;
-    }
+        const ApplyResult family_exact = apply_pom_digit_family_exact(st, tmp, r);
+        if (family_exact == ApplyResult::Contradiction) {
+            s.elapsed_ns += st.now_ns() - t0;
+            return family_exact;
+        }
+        if (family_exact == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_pattern_overlay_method = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ApplyResult::Progress;
+        }
 
-    // Krok 2: Aplikacja czystego POM (szybki overlay)
-    const ApplyResult exact = apply_pom_exact(st, tmp, r);
-    if (exact == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
-        return exact; 
+        // Krok 2: Aplikacja czystego POM (szybki overlay)
+        const ApplyResult exact = apply_pom_exact(st, tmp, r);
+        if (exact == ApplyResult::Contradiction) { 
+            s.elapsed_ns += st.now_ns() - t0; 
+            return exact; 
+        }
+        if (exact == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_pattern_overlay_method = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ApplyResult::Progress;
+        }
     }
-    if (exact == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_pattern_overlay_method = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ApplyResult::Progress;
+    if (!st.tier_allows_proxy()) {
+        s.elapsed_ns += st.now_ns() - t0;
+        return ApplyResult::NoProgress;
     }
-    
+
     // Krok 3: Adaptacyjne dynamiczne Ĺ›ledzenie zatorĂłw za pomocÄ… Ĺ‚aĹ„cuchĂłw (GĹ‚Ä™bokoĹ›Ä‡ P8)
     const int depth_cap = std::clamp(8 + (st.board->empty_cells / std::max(1, st.topo->n)), 10, 14);
     bool used_dynamic = false;
 
     ApplyResult dyn = p7_nightmare::bounded_implication_core(st, tmp, r, depth_cap, used_dynamic);
     if (dyn == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+        s.elapsed_ns += st.now_ns() - t0; 
         return dyn; 
     }
     if (dyn == ApplyResult::Progress && used_dynamic) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return dyn;
     }
 
     // Krok 4: Kaskada z P8 - MSLS generuje wielkie nakĹ‚adki matryc
     ApplyResult ar = apply_msls(st, tmp, r);
     if (ar == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+        s.elapsed_ns += st.now_ns() - t0; 
         return ar; 
     }
     if (ar == ApplyResult::Progress) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ar;
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -48,13 +48,13 @@ inline bool sk_loop_probe_contradiction(
 // co pozwala na skrzyĹĽowanÄ… eliminacjÄ™ cyfr wyjĹ›ciowych z reszty rzÄ™du/kolumny.
 // ============================================================================
 inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
     
     const int n = st.topo->n;
     const int nn = st.topo->nn;
     if (st.board->empty_cells > (nn - 6 * n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
     const int pattern_cap = std::clamp(2 + n / 3, 4, 10);
@@ -69,7 +69,7 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
             for (int c1 = 0; c1 < n; ++c1) {
                 for (int c2 = c1 + 1; c2 < n; ++c2) {
                     if (patterns >= pattern_cap) {
-                        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                        s.elapsed_ns += st.now_ns() - t0;
                         return ApplyResult::NoProgress;
                     }
                     const int a = r1 * n + c1;
@@ -137,7 +137,7 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
                             
                             const ApplyResult er = st.eliminate(t, x);
                             if (er == ApplyResult::Contradiction) { 
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+                                s.elapsed_ns += st.now_ns() - t0; 
                                 return er; 
                             }
                             progress = progress || (er == ApplyResult::Progress);
@@ -158,7 +158,7 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
                             if (!sk_loop_probe_contradiction(st, corners[ci], digit, probe_steps, sp)) continue;
                             const ApplyResult er = st.eliminate(corners[ci], bit);
                             if (er == ApplyResult::Contradiction) {
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return er;
                             }
                             progress = progress || (er == ApplyResult::Progress);
@@ -177,7 +177,7 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
                             if (idx == a || idx == b || st.board->values[idx] != 0) continue;
                             const ApplyResult er = st.eliminate(idx, x);
                             if (er == ApplyResult::Contradiction) {
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return er;
                             }
                             progress = progress || (er == ApplyResult::Progress);
@@ -194,7 +194,7 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
                             if (idx == c || idx == d || st.board->values[idx] != 0) continue;
                             const ApplyResult er = st.eliminate(idx, x);
                             if (er == ApplyResult::Contradiction) {
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return er;
                             }
                             progress = progress || (er == ApplyResult::Progress);
@@ -211,7 +211,7 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
                             if (idx == a || idx == c || st.board->values[idx] != 0) continue;
                             const ApplyResult er = st.eliminate(idx, x);
                             if (er == ApplyResult::Contradiction) {
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return er;
                             }
                             progress = progress || (er == ApplyResult::Progress);
@@ -228,7 +228,7 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
                             if (idx == b || idx == d || st.board->values[idx] != 0) continue;
                             const ApplyResult er = st.eliminate(idx, x);
                             if (er == ApplyResult::Contradiction) {
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return er;
                             }
                             progress = progress || (er == ApplyResult::Progress);
@@ -247,7 +247,7 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
                             if (!st.is_peer(t, a) || !st.is_peer(t, d)) continue;
                             const ApplyResult er = st.eliminate(t, x);
                             if (er == ApplyResult::Contradiction) {
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return er;
                             }
                             progress = progress || (er == ApplyResult::Progress);
@@ -264,7 +264,7 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
                             if (!st.is_peer(t, b) || !st.is_peer(t, c)) continue;
                             const ApplyResult er = st.eliminate(t, x);
                             if (er == ApplyResult::Contradiction) {
-                                s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+                                s.elapsed_ns += st.now_ns() - t0;
                                 return er;
                             }
                             progress = progress || (er == ApplyResult::Progress);
@@ -278,11 +278,11 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
     if (progress) {
         ++s.hit_count;
         r.used_sk_loop = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
     
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
@@ -291,28 +291,34 @@ inline ApplyResult apply_sk_loop_exact(CandidateState& st, StrategyStats& s, Gen
 // Integruje Exact z mocÄ… gĹ‚Ä™bokiego zastÄ™pstwa silnikiem P7
 // ============================================================================
 inline ApplyResult apply_sk_loop(CandidateState& st, StrategyStats& s, GenericLogicCertifyResult& r) {
-    const uint64_t t0 = p7_nightmare::get_current_time_ns();
+    const uint64_t t0 = st.now_ns();
     ++s.use_count;
     const int n = st.topo->n;
     const int nn = st.topo->nn;
     if (st.board->empty_cells > (nn - 5 * n)) {
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::NoProgress;
     }
     
     StrategyStats tmp{};
     
     // 1. Twarda struktura Exact (szybka)
-    const ApplyResult exact = apply_sk_loop_exact(st, tmp, r);
-    if (exact == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
-        return exact; 
+    if (st.tier_allows_exact()) {
+        const ApplyResult exact = apply_sk_loop_exact(st, tmp, r);
+        if (exact == ApplyResult::Contradiction) {
+            s.elapsed_ns += st.now_ns() - t0;
+            return exact;
+        }
+        if (exact == ApplyResult::Progress) {
+            ++s.hit_count;
+            r.used_sk_loop = true;
+            s.elapsed_ns += st.now_ns() - t0;
+            return ApplyResult::Progress;
+        }
     }
-    if (exact == ApplyResult::Progress) {
-        ++s.hit_count;
-        r.used_sk_loop = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
-        return ApplyResult::Progress;
+    if (!st.tier_allows_proxy()) {
+        s.elapsed_ns += st.now_ns() - t0;
+        return ApplyResult::NoProgress;
     }
 
     // Adaptacyjne gĹ‚Ä™bokie skanowanie (P8) - Skokowa propagacja dla siatek
@@ -322,43 +328,43 @@ inline ApplyResult apply_sk_loop(CandidateState& st, StrategyStats& s, GenericLo
     // 2. Szukanie zdeformowanych cykli przez Bounded Implication (Nishio Forcing)
     ApplyResult dyn = p7_nightmare::bounded_implication_core(st, s, r, depth_cap, used_dynamic);
     if (dyn == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+        s.elapsed_ns += st.now_ns() - t0; 
         return dyn; 
     }
     if (dyn == ApplyResult::Progress && used_dynamic) {
         ++s.hit_count;
         r.used_sk_loop = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
     // 3. Fallback w poszukiwaniu klasycznej pÄ™tli Nice Loop
     ApplyResult ar = p7_nightmare::apply_continuous_nice_loop(st, tmp, r);
     if (ar == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+        s.elapsed_ns += st.now_ns() - t0; 
         return ar; 
     }
     if (ar == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_sk_loop = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
     // 4. Fallback X-Cycle dla uĹ‚oĹĽonych siatek
     ar = p7_nightmare::apply_grouped_x_cycle(st, tmp, r);
     if (ar == ApplyResult::Contradiction) { 
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0; 
+        s.elapsed_ns += st.now_ns() - t0; 
         return ar; 
     }
     if (ar == ApplyResult::Progress) {
         ++s.hit_count;
         r.used_sk_loop = true;
-        s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+        s.elapsed_ns += st.now_ns() - t0;
         return ApplyResult::Progress;
     }
 
-    s.elapsed_ns += p7_nightmare::get_current_time_ns() - t0;
+    s.elapsed_ns += st.now_ns() - t0;
     return ApplyResult::NoProgress;
 }
 
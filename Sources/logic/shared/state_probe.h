@@ -5,6 +5,7 @@
 #include <algorithm>
 
 #include "exact_pattern_scratchpad.h"
+#include "work_budget.h"
 #include "../../core/candidate_state.h"
 #include "../../config/bit_utils.h"
 
@@ -30,11 +31,14 @@ inline void restore_state(CandidateState& st, ExactPatternScratchpad& sp) {
     std::copy_n(sp.dyn_col_used_backup, n, st.board->col_used.data());
     std::copy_n(sp.dyn_box_used_backup, n, st.board->box_used.data());
     st.board->empty_cells = sp.dyn_empty_backup;
+    st.invalidate_indices();
 }
 
 inline bool propagate_singles(CandidateState& st, int max_steps) {
     const int nn = st.topo->nn;
     for (int step = 0; step < max_steps; ++step) {
+        // Wyczerpany budzet = propagacja obcieta (stan czesciowy, bez falszywej sprzecznosci).
+        if (!work_charge(st)) break;
         bool changed = false;
         for (int idx = 0; idx < nn; ++idx) {
             if (st.board->values[idx] != 0) continue;
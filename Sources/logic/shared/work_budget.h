@@ -0,0 +1,71 @@
+// ============================================================================
+// SUDOKU HPC - LOGIC ENGINE SHARED
+// Moduł: work_budget.h
+// Opis: Licznik pracy ciężkich strategii P7/P8. Pętle wewnętrzne zgłaszają
+//       jednostki pracy (ok. jeden przebieg O(nn)); co kWorkPollInterval
+//       jednostek sprawdzany jest limit slotu i budżet próby (deadline/cancel).
+// ============================================================================
+//Author copyright Marcin Matysek (Rewertyn)
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "../../core/candidate_state.h"
+#include "../../generator/core_engines/dlx_solver.h"
+
+namespace sudoku_hpc::logic::shared {
+
+inline constexpr uint64_t kWorkPollInterval = 64;
+inline constexpr uint64_t kWorkMeterIdle = std::numeric_limits<uint64_t>::max();
+
+inline bool work_poll(CandidateState& st) {
+    if (st.work_cap != 0 && st.work_units >= st.work_cap) {
+        st.work_exhausted = true;
+        return false;
+    }
+    if (st.work_budget != nullptr && !st.work_budget->step(0)) {
+        st.work_exhausted = true;
+        return false;
+    }
+    st.work_next_poll = st.work_units + kWorkPollInterval;
+    if (st.work_cap != 0) st.work_next_poll = std::min(st.work_next_poll, st.work_cap);
+    return true;
+}
+
+// false = slot ma przerwać pracę (wynik dotychczasowy pozostaje poprawny).
+inline bool work_charge(CandidateState& st, uint64_t units = 1) {
+    if (st.work_exhausted) return false;
+    st.work_units += units;
+    if (st.work_units < st.work_next_poll) return true;
+    return work_poll(st);
+}
+
+// Uzbraja licznik na czas jednego slotu. false = budżet próby już wyczerpany.
+inline bool work_begin(CandidateState& st) {
+    st.work_units = 0;
+    st.work_exhausted = false;
+    if (st.work_cap == 0 && st.work_budget == nullptr) {
+        st.work_next_poll = kWorkMeterIdle;
+        return true;
+    }
+    if (st.work_budget != nullptr && st.work_budget->aborted()) {
+        st.work_exhausted = true;
+        return false;
+    }
+    st.work_next_poll = (st.work_cap != 0) ? std::min(kWorkPollInterval, st.work_cap) : kWorkPollInterval;
+    return true;
+}
+
+// Rozbraja licznik; zwraca true, jeśli slot został przerwany na budżecie.
+inline bool work_end(CandidateState& st) {
+    const bool exhausted = st.work_exhausted;
+    st.work_exhausted = false;
+    st.work_next_poll = kWorkMeterIdle;
+    return exhausted;
+}
+
+} // namespace sudoku_hpc::logic::shared
@@ -15,6 +15,8 @@
 #include <array>
 #include <cstdint>
 #include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "../config/run_config.h"
@@ -63,6 +65,7 @@
 #include "p8_theoretical/sk_loop.h"
 #include "p8_theoretical/pattern_overlay.h"
 #include "p8_theoretical/forcing_chains_dynamic.h"
+#include "shared/work_budget.h"
 
 namespace sudoku_hpc::logic {
 
@@ -680,7 +683,157 @@ struct GenericLogicCertify {
         return false;
     }
 
+    // Sloty P8 z tierem exact + proxy fallback, sterowane przez StrategyTierPolicy.
+    static bool is_tiered_slot(size_t slot) {
+        return slot == SlotMSLS || slot == SlotExocet || slot == SlotSeniorExocet ||
+               slot == SlotSKLoop || slot == SlotPatternOverlayMethod;
+    }
+
+    static const char* tier_mode_label(StrategyTierMode mode) {
+        switch (mode) {
+            case StrategyTierMode::Hybrid: return "hybrid";
+            case StrategyTierMode::ExactOnly: return "exact";
+            case StrategyTierMode::ProxyOnly: return "proxy";
+        }
+        return "hybrid";
+    }
+
+    static bool parse_tier_mode(std::string_view raw, StrategyTierMode& out) {
+        const std::string key = normalize_token(raw);
+        if (key == "hybrid") { out = StrategyTierMode::Hybrid; return true; }
+        if (key == "exact" || key == "exactonly") { out = StrategyTierMode::ExactOnly; return true; }
+        if (key == "proxy" || key == "proxyonly") { out = StrategyTierMode::ProxyOnly; return true; }
+        return false;
+    }
+
+    // Format: "<tryb>[,<strategia>=<tryb>...]", np. "hybrid,exocet=exact,skloop=proxy".
+    // Tryb bez nazwy ustawia wszystkie sloty; kolejne wpisy nadpisują pojedyncze sloty.
+    static bool parse_tier_policy(std::string_view spec, StrategyTierPolicy& out) {
+        StrategyTierPolicy policy{};
+        size_t pos = 0;
+        while (pos < spec.size()) {
+            size_t comma = spec.find(',', pos);
+            if (comma == std::string_view::npos) comma = spec.size();
+            const std::string_view item = spec.substr(pos, comma - pos);
+            pos = comma + 1;
+            if (item.empty()) continue;
+
+            StrategyTierMode mode = StrategyTierMode::Hybrid;
+            const size_t eq = item.find('=');
+            if (eq == std::string_view::npos) {
+                if (!parse_tier_mode(item, mode)) return false;
+                policy.mode.fill(mode);
+                continue;
+            }
+            RequiredStrategy rs = RequiredStrategy::None;
+            size_t slot = 0;
+            if (!parse_required_strategy(item.substr(0, eq), rs) || !slot_from_required_strategy(rs, slot)) return false;
+            if (!is_tiered_slot(slot)) return false;
+            if (!parse_tier_mode(item.substr(eq + 1), mode)) return false;
+            policy.mode[slot] = mode;
+        }
+        out = policy;
+        return true;
+    }
+
+    void set_tier_policy(const StrategyTierPolicy& policy) {
+        tier_policy_ = policy;
+    }
+
+    const StrategyTierPolicy& tier_policy() const {
+        return tier_policy_;
+    }
+
+    // Limit jednostek pracy na jedno wywolanie slotu P7/P8 (0 = bez limitu).
+    void set_strategy_work_cap(uint64_t cap) {
+        strategy_work_cap_ = cap;
+    }
+
+    uint64_t strategy_work_cap() const {
+        return strategy_work_cap_;
+    }
+
+    // Probkowanie czasu strategii: 1 = kazda runda, N = co N-ta runda, 0 = wylaczone.
+    void set_strategy_timing_sample(uint32_t every) {
+        timing_sample_every_ = every;
+    }
+
+    uint32_t strategy_timing_sample() const {
+        return timing_sample_every_;
+    }
+
 private:
+    StrategyTierPolicy tier_policy_{};
+    uint64_t strategy_work_cap_ = 0;
+    uint32_t timing_sample_every_ = 1;
+
+    // Uzycia strategii w probkowanej rundzie: przed runda odejmujemy licznik uzyc,
+    // po rundzie dodajemy - roznica trafia do timed_uses bez bufora migawki.
+    static inline void begin_timed_round(GenericLogicCertifyResult& result) {
+        for (StrategyStats& stats : result.strategy_stats) stats.timed_uses -= stats.use_count;
+    }
+
+    static inline void end_timed_round(GenericLogicCertifyResult& result) {
+        for (StrategyStats& stats : result.strategy_stats) stats.timed_uses += stats.use_count;
+    }
+
+    // Czasy z probkowanych rund skalowane do estymaty calosci (liczniki sa dokladne).
+    // Skala per strategia = wszystkie uzycia / uzycia zmierzone, nie stale N: runda 0
+    // jest zawsze probkowana, a strategie odpalaja sie w rundach nierownomiernie.
+    // Strategia bez zmierzonego uzycia zostaje bez skalowania.
+    static inline void finish_sampled_timing(GenericLogicCertifyResult& result) {
+        if (result.timing_sample_every <= 1) return;
+        for (StrategyStats& stats : result.strategy_stats) {
+            if (stats.timed_uses == 0 || stats.use_count <= stats.timed_uses) continue;
+            stats.elapsed_ns = static_cast<uint64_t>(
+                static_cast<double>(stats.elapsed_ns) *
+                (static_cast<double>(stats.use_count) / static_cast<double>(stats.timed_uses)));
+        }
+    }
+
+    // Strategie czysto lokalne (cyfra/domek) pomijaja regiony, ktore nie zmienily sie
+    // od ich ostatniego NoProgress. Epoka "czystosci" jest widoczna tylko w trakcie slotu.
+    template <typename Fn>
+    static inline ApplyResult apply_dirty_scoped(CandidateState& st, size_t slot, Fn&& fn) {
+        if (!st.ensure_indices()) return fn();
+        uint32_t& clean = st.index->slot_clean_epoch[slot];
+        const uint32_t start = st.change_epoch();
+        st.scan_clean_epoch = clean;
+        const ApplyResult ar = fn();
+        st.scan_clean_epoch = 0;
+        if (ar == ApplyResult::NoProgress && st.index_valid) clean = start;
+        return ar;
+    }
+
+    // Sloty P7/P8 licza prace (shared/work_budget.h): przerwanie na limicie slotu
+    // lub budzecie proby konczy slot z dotychczasowym (poprawnym) wynikiem.
+    template <typename Fn>
+    static inline ApplyResult apply_metered(CandidateState& st, GenericLogicCertifyResult& result, size_t slot, Fn&& fn) {
+        if (!shared::work_begin(st)) {
+            shared::work_end(st);
+            return ApplyResult::NoProgress;
+        }
+        const ApplyResult ar = fn();
+        if (shared::work_end(st)) {
+            ++result.strategy_stats[slot].budget_aborts;
+            ++result.budget_aborted_slots;
+        }
+        return ar;
+    }
+
+    template <typename Fn>
+    static inline ApplyResult apply_tiered(
+        CandidateState& st,
+        GenericLogicCertifyResult& result,
+        const StrategyTierPolicy& tiers,
+        size_t slot,
+        Fn&& fn) {
+        st.tier_mode = tiers.mode[slot];
+        const ApplyResult ar = apply_metered(st, result, slot, fn);
+        st.tier_mode = StrategyTierMode::Hybrid;
+        return ar;
+    }
+
     static inline void note_strategy_slot(GenericLogicCertifyResult& result, size_t slot, ApplyResult ar) {
         if (ar == ApplyResult::NoProgress) {
             return;
@@ -696,14 +849,29 @@ private:
     }
 
     // GĹĂ“WNA PÄTLA CERTYFIKATORA LOGICZNEGO
-    static ApplyResult apply_round_up_to_level(CandidateState& st, GenericLogicCertifyResult& result, int max_level) {
+    // Maski kandydatow (wartosc wpisana = pojedynczy bit) jako zasiew licznika DLX.
+    static void capture_candidate_masks(const CandidateState& st, std::vector<uint64_t>& out) {
+        const int nn = st.topo->nn;
+        out.resize(static_cast<size_t>(nn));
+        for (int idx = 0; idx < nn; ++idx) {
+            const int v = static_cast<int>(st.board->values[static_cast<size_t>(idx)]);
+            out[static_cast<size_t>(idx)] = (v > 0) ? (1ULL << (v - 1)) : st.cands[idx];
+        }
+    }
+
+    static ApplyResult apply_round_up_to_level(
+        CandidateState& st,
+        GenericLogicCertifyResult& result,
+        int max_level,
+        const StrategyTierPolicy& tiers,
+        std::vector<uint64_t>* seed_masks = nullptr) {
         
         // ====================================================================
         // POZIOM 1: EASY
         // ====================================================================
         ApplyResult ar = p1_easy::apply_naked_single(st, result.strategy_stats[SlotNakedSingle], result);
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotNakedSingle, ar); return ar; }
-        ar = p1_easy::apply_hidden_single(st, result.strategy_stats[SlotHiddenSingle], result);
+        ar = apply_dirty_scoped(st, SlotHiddenSingle, [&] { return p1_easy::apply_hidden_single(st, result.strategy_stats[SlotHiddenSingle], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotHiddenSingle, ar); return ar; }
         
         if (max_level <= 1) return ApplyResult::NoProgress;
@@ -711,38 +879,43 @@ private:
         // ====================================================================
         // POZIOM 2: MEDIUM
         // ====================================================================
-        ar = p2_intersections::apply_pointing_and_boxline(st, result.strategy_stats[SlotPointingPairs], result.strategy_stats[SlotBoxLineReduction], result);
+        ar = apply_dirty_scoped(st, SlotPointingPairs, [&] { return p2_intersections::apply_pointing_and_boxline(st, result.strategy_stats[SlotPointingPairs], result.strategy_stats[SlotBoxLineReduction], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotPointingPairs, ar); return ar; }
         
         // Zgodnie z oficjalnÄ… klasyfikacjÄ…: Podzbiory 2, 3 elementowe wchodzÄ… tu jako medium
-        ar = p3_subsets::apply_house_subset(st, result.strategy_stats[SlotNakedPair], result, 2, false);
+        ar = apply_dirty_scoped(st, SlotNakedPair, [&] { return p3_subsets::apply_house_subset(st, result.strategy_stats[SlotNakedPair], result, 2, false); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotNakedPair, ar); return ar; }
-        ar = p3_subsets::apply_house_subset(st, result.strategy_stats[SlotHiddenPair], result, 2, true);
+        ar = apply_dirty_scoped(st, SlotHiddenPair, [&] { return p3_subsets::apply_house_subset(st, result.strategy_stats[SlotHiddenPair], result, 2, true); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotHiddenPair, ar); return ar; }
-        ar = p3_subsets::apply_house_subset(st, result.strategy_stats[SlotNakedTriple], result, 3, false);
+        ar = apply_dirty_scoped(st, SlotNakedTriple, [&] { return p3_subsets::apply_house_subset(st, result.strategy_stats[SlotNakedTriple], result, 3, false); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotNakedTriple, ar); return ar; }
-        ar = p3_subsets::apply_house_subset(st, result.strategy_stats[SlotHiddenTriple], result, 3, true);
+        ar = apply_dirty_scoped(st, SlotHiddenTriple, [&] { return p3_subsets::apply_house_subset(st, result.strategy_stats[SlotHiddenTriple], result, 3, true); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotHiddenTriple, ar); return ar; }
 
         if (max_level <= 2) return ApplyResult::NoProgress;
 
+        // Punkt staly P1/P2 to ostatni stan, ktorego eliminacje sa poprawne takze dla
+        // lamiglowek niejednoznacznych; wyzsze sloty (UR/BUG, sondy forcing) moga
+        // odciac jedno z rozwiazan, wiec zasiew DLX bierzemy tylko stad (pierwszy raz).
+        if (seed_masks != nullptr && seed_masks->empty()) capture_candidate_masks(st, *seed_masks);
+
         // ====================================================================
         // POZIOM 3/4: HARD / EXPERT (Wg wytycznych poĹ‚Ä…czone jako P3/P4 w silniku)
         // ====================================================================
-        ar = p3_subsets::apply_house_subset(st, result.strategy_stats[SlotNakedQuad], result, 4, false);
+        ar = apply_dirty_scoped(st, SlotNakedQuad, [&] { return p3_subsets::apply_house_subset(st, result.strategy_stats[SlotNakedQuad], result, 4, false); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotNakedQuad, ar); return ar; }
-        ar = p3_subsets::apply_house_subset(st, result.strategy_stats[SlotHiddenQuad], result, 4, true);
+        ar = apply_dirty_scoped(st, SlotHiddenQuad, [&] { return p3_subsets::apply_house_subset(st, result.strategy_stats[SlotHiddenQuad], result, 4, true); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotHiddenQuad, ar); return ar; }
         
-        ar = p4_hard::apply_x_wing(st, result.strategy_stats[SlotXWing], result);
+        ar = apply_dirty_scoped(st, SlotXWing, [&] { return p4_hard::apply_x_wing(st, result.strategy_stats[SlotXWing], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotXWing, ar); return ar; }
         ar = p4_hard::apply_y_wing(st, result.strategy_stats[SlotYWing], result);
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotYWing, ar); return ar; }
-        ar = p4_hard::apply_skyscraper(st, result.strategy_stats[SlotSkyscraper], result);
+        ar = apply_dirty_scoped(st, SlotSkyscraper, [&] { return p4_hard::apply_skyscraper(st, result.strategy_stats[SlotSkyscraper], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotSkyscraper, ar); return ar; }
-        ar = p4_hard::apply_two_string_kite(st, result.strategy_stats[SlotTwoStringKite], result);
+        ar = apply_dirty_scoped(st, SlotTwoStringKite, [&] { return p4_hard::apply_two_string_kite(st, result.strategy_stats[SlotTwoStringKite], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotTwoStringKite, ar); return ar; }
-        ar = p4_hard::apply_empty_rectangle(st, result.strategy_stats[SlotEmptyRectangle], result);
+        ar = apply_dirty_scoped(st, SlotEmptyRectangle, [&] { return p4_hard::apply_empty_rectangle(st, result.strategy_stats[SlotEmptyRectangle], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotEmptyRectangle, ar); return ar; }
         ar = p4_hard::apply_remote_pairs(st, result.strategy_stats[SlotRemotePairs], result);
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotRemotePairs, ar); return ar; }
@@ -752,11 +925,11 @@ private:
         // ====================================================================
         // POZIOM 5: DIABOLICAL / EXPERT (ZĹ‚oĹĽone Ryby, W-Wing, Coloring)
         // ====================================================================
-        ar = p4_hard::apply_swordfish(st, result.strategy_stats[SlotSwordfish], result);
+        ar = apply_dirty_scoped(st, SlotSwordfish, [&] { return p4_hard::apply_swordfish(st, result.strategy_stats[SlotSwordfish], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotSwordfish, ar); return ar; }
-        ar = p5_expert::apply_finned_x_wing_sashimi(st, result.strategy_stats[SlotFinnedXWingSashimi], result);
+        ar = apply_dirty_scoped(st, SlotFinnedXWingSashimi, [&] { return p5_expert::apply_finned_x_wing_sashimi(st, result.strategy_stats[SlotFinnedXWingSashimi], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotFinnedXWingSashimi, ar); return ar; }
-        ar = p5_expert::apply_simple_coloring(st, result.strategy_stats[SlotSimpleColoring], result);
+        ar = apply_dirty_scoped(st, SlotSimpleColoring, [&] { return p5_expert::apply_simple_coloring(st, result.strategy_stats[SlotSimpleColoring], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotSimpleColoring, ar); return ar; }
         ar = p5_expert::apply_bug_plus_one(st, result.strategy_stats[SlotBUGPlusOne], result);
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotBUGPlusOne, ar); return ar; }
@@ -773,7 +946,7 @@ private:
         // POZIOM 6: NIGHTMARE / DIABOLICAL (Specyficzne Ryby, ALS, Deadly Patterns, Łańcuchy)
         // Reguła architektoniczna: Named structures przed generycznymi chainami.
         // ====================================================================
-        ar = p6_diabolical::apply_jellyfish(st, result.strategy_stats[SlotJellyfish], result);
+        ar = apply_dirty_scoped(st, SlotJellyfish, [&] { return p6_diabolical::apply_jellyfish(st, result.strategy_stats[SlotJellyfish], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotJellyfish, ar); return ar; }
 
         ar = p6_diabolical::apply_finned_swordfish_jellyfish(st, result.strategy_stats[SlotFinnedSwordfishJellyfish], result);
@@ -814,39 +987,39 @@ private:
         // POZIOM 7: NIGHTMARE / THEORETICAL (Grupy ALS, Mutanty, APE)
         // Reguła architektoniczna: named structures i ryby przed AIC / grouped AIC.
         // ====================================================================
-        ar = p7_nightmare::apply_sue_de_coq(st, result.strategy_stats[SlotSueDeCoq], result);
+        ar = apply_metered(st, result, SlotSueDeCoq, [&] { return p7_nightmare::apply_sue_de_coq(st, result.strategy_stats[SlotSueDeCoq], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotSueDeCoq, ar); return ar; }
-        ar = p7_nightmare::apply_squirmbag(st, result.strategy_stats[SlotSquirmbag], result);
+        ar = apply_metered(st, result, SlotSquirmbag, [&] { return p7_nightmare::apply_squirmbag(st, result.strategy_stats[SlotSquirmbag], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotSquirmbag, ar); return ar; }
-        ar = p7_nightmare::apply_franken_fish(st, result.strategy_stats[SlotFrankenFish], result);
+        ar = apply_metered(st, result, SlotFrankenFish, [&] { return p7_nightmare::apply_franken_fish(st, result.strategy_stats[SlotFrankenFish], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotFrankenFish, ar); return ar; }
-        ar = p7_nightmare::apply_mutant_fish(st, result.strategy_stats[SlotMutantFish], result);
+        ar = apply_metered(st, result, SlotMutantFish, [&] { return p7_nightmare::apply_mutant_fish(st, result.strategy_stats[SlotMutantFish], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotMutantFish, ar); return ar; }
-        ar = p7_nightmare::apply_kraken_fish(st, result.strategy_stats[SlotKrakenFish], result);
+        ar = apply_metered(st, result, SlotKrakenFish, [&] { return p7_nightmare::apply_kraken_fish(st, result.strategy_stats[SlotKrakenFish], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotKrakenFish, ar); return ar; }
-        ar = p7_nightmare::apply_als_xy_wing(st, result.strategy_stats[SlotALSXYWing], result);
+        ar = apply_metered(st, result, SlotALSXYWing, [&] { return p7_nightmare::apply_als_xy_wing(st, result.strategy_stats[SlotALSXYWing], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotALSXYWing, ar); return ar; }
-        ar = p7_nightmare::apply_als_chain(st, result.strategy_stats[SlotALSChain], result);
+        ar = apply_metered(st, result, SlotALSChain, [&] { return p7_nightmare::apply_als_chain(st, result.strategy_stats[SlotALSChain], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotALSChain, ar); return ar; }
-        ar = p7_nightmare::apply_death_blossom(st, result.strategy_stats[SlotDeathBlossom], result);
+        ar = apply_metered(st, result, SlotDeathBlossom, [&] { return p7_nightmare::apply_death_blossom(st, result.strategy_stats[SlotDeathBlossom], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotDeathBlossom, ar); return ar; }
-        ar = p7_nightmare::apply_aligned_pair_exclusion(st, result.strategy_stats[SlotAlignedPairExclusion], result);
+        ar = apply_metered(st, result, SlotAlignedPairExclusion, [&] { return p7_nightmare::apply_aligned_pair_exclusion(st, result.strategy_stats[SlotAlignedPairExclusion], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotAlignedPairExclusion, ar); return ar; }
-        ar = p7_nightmare::apply_aligned_triple_exclusion(st, result.strategy_stats[SlotAlignedTripleExclusion], result);
+        ar = apply_metered(st, result, SlotAlignedTripleExclusion, [&] { return p7_nightmare::apply_aligned_triple_exclusion(st, result.strategy_stats[SlotAlignedTripleExclusion], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotAlignedTripleExclusion, ar); return ar; }
 
-        ar = p7_nightmare::apply_medusa_3d(st, result.strategy_stats[SlotMedusa3D], result);
+        ar = apply_metered(st, result, SlotMedusa3D, [&] { return p7_nightmare::apply_medusa_3d(st, result.strategy_stats[SlotMedusa3D], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotMedusa3D, ar); return ar; }
-        ar = p7_nightmare::apply_continuous_nice_loop(st, result.strategy_stats[SlotContinuousNiceLoop], result);
+        ar = apply_metered(st, result, SlotContinuousNiceLoop, [&] { return p7_nightmare::apply_continuous_nice_loop(st, result.strategy_stats[SlotContinuousNiceLoop], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotContinuousNiceLoop, ar); return ar; }
-        ar = p7_nightmare::apply_grouped_x_cycle(st, result.strategy_stats[SlotGroupedXCycle], result);
+        ar = apply_metered(st, result, SlotGroupedXCycle, [&] { return p7_nightmare::apply_grouped_x_cycle(st, result.strategy_stats[SlotGroupedXCycle], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotGroupedXCycle, ar); return ar; }
 
-        ar = p7_nightmare::apply_aic(st, result.strategy_stats[SlotAIC], result);
+        ar = apply_metered(st, result, SlotAIC, [&] { return p7_nightmare::apply_aic(st, result.strategy_stats[SlotAIC], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotAIC, ar); return ar; }
-        ar = p7_nightmare::apply_grouped_aic(st, result.strategy_stats[SlotGroupedAIC], result);
+        ar = apply_metered(st, result, SlotGroupedAIC, [&] { return p7_nightmare::apply_grouped_aic(st, result.strategy_stats[SlotGroupedAIC], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotGroupedAIC, ar); return ar; }
-        ar = p7_nightmare::apply_als_aic(st, result.strategy_stats[SlotALSAIC], result);
+        ar = apply_metered(st, result, SlotALSAIC, [&] { return p7_nightmare::apply_als_aic(st, result.strategy_stats[SlotALSAIC], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotALSAIC, ar); return ar; }
         
         if (max_level <= 7) return ApplyResult::NoProgress;
@@ -856,20 +1029,20 @@ private:
         // ====================================================================
         
         // PODPIÄCIA BRAKUJÄ„CYCH "SIEROT" P8
-        ar = p8_theoretical::apply_msls(st, result.strategy_stats[SlotMSLS], result);
+        ar = apply_tiered(st, result, tiers, SlotMSLS, [&] { return p8_theoretical::apply_msls(st, result.strategy_stats[SlotMSLS], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotMSLS, ar); return ar; }
-        ar = p8_theoretical::apply_exocet(st, result.strategy_stats[SlotExocet], result);
+        ar = apply_tiered(st, result, tiers, SlotExocet, [&] { return p8_theoretical::apply_exocet(st, result.strategy_stats[SlotExocet], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotExocet, ar); return ar; }
-        ar = p8_theoretical::apply_senior_exocet(st, result.strategy_stats[SlotSeniorExocet], result);
+        ar = apply_tiered(st, result, tiers, SlotSeniorExocet, [&] { return p8_theoretical::apply_senior_exocet(st, result.strategy_stats[SlotSeniorExocet], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotSeniorExocet, ar); return ar; }
-        ar = p8_theoretical::apply_sk_loop(st, result.strategy_stats[SlotSKLoop], result);
+        ar = apply_tiered(st, result, tiers, SlotSKLoop, [&] { return p8_theoretical::apply_sk_loop(st, result.strategy_stats[SlotSKLoop], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotSKLoop, ar); return ar; }
-        ar = p8_theoretical::apply_pattern_overlay_method(st, result.strategy_stats[SlotPatternOverlayMethod], result);
+        ar = apply_tiered(st, result, tiers, SlotPatternOverlayMethod, [&] { return p8_theoretical::apply_pattern_overlay_method(st, result.strategy_stats[SlotPatternOverlayMethod], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotPatternOverlayMethod, ar); return ar; }
         
-        ar = p8_theoretical::apply_forcing_chains(st, result.strategy_stats[SlotForcingChains], result);
+        ar = apply_metered(st, result, SlotForcingChains, [&] { return p8_theoretical::apply_forcing_chains(st, result.strategy_stats[SlotForcingChains], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotForcingChains, ar); return ar; }
-        ar = p8_theoretical::apply_dynamic_forcing_chains(st, result.strategy_stats[SlotDynamicForcingChains], result);
+        ar = apply_metered(st, result, SlotDynamicForcingChains, [&] { return p8_theoretical::apply_dynamic_forcing_chains(st, result.strategy_stats[SlotDynamicForcingChains], result); });
         if (ar != ApplyResult::NoProgress) { note_strategy_slot(result, SlotDynamicForcingChains, ar); return ar; }
 
         return ApplyResult::NoProgress;
@@ -880,16 +1053,23 @@ public:
         std::span<const uint16_t> puzzle,
         const GenericTopology& topo,
         core_engines::SearchAbortControl* budget = nullptr,
-        bool capture_solution_grid = false) const {
-        return certify_up_to_level(puzzle, topo, 8, budget, capture_solution_grid);
+        bool capture_solution_grid = false,
+        std::vector<uint64_t>* out_seed_masks = nullptr) const {
+        return certify_up_to_level(puzzle, topo, 8, budget, capture_solution_grid, out_seed_masks);
     }
 
     GenericLogicCertifyResult certify(
         const std::vector<uint16_t>& puzzle,
         const GenericTopology& topo,
         core_engines::SearchAbortControl* budget = nullptr,
-        bool capture_solution_grid = false) const {
-        return certify(std::span<const uint16_t>(puzzle.data(), puzzle.size()), topo, budget, capture_solution_grid);
+        bool capture_solution_grid = false,
+        std::vector<uint64_t>* out_seed_masks = nullptr) const {
+        return certify(
+            std::span<const uint16_t>(puzzle.data(), puzzle.size()),
+            topo,
+            budget,
+            capture_solution_grid,
+            out_seed_masks);
     }
 
     GenericLogicCertifyResult certify_up_to_level(
@@ -897,9 +1077,11 @@ public:
         const GenericTopology& topo,
         int max_level,
         core_engines::SearchAbortControl* budget = nullptr,
-        bool capture_solution_grid = false) const {
+        bool capture_solution_grid = false,
+        std::vector<uint64_t>* out_seed_masks = nullptr) const {
         
         GenericLogicCertifyResult result{};
+        if (out_seed_masks != nullptr) out_seed_masks->clear();
         const bool has_budget = (budget != nullptr);
         const int level_limit = std::clamp(max_level, 1, 8);
 
@@ -913,7 +1095,11 @@ public:
         static thread_local uint64_t tls_cands[4096];
         
         CandidateState st{};
-        if (!st.init(board, topo, tls_cands)) return result;
+        if (!st.init(board, topo, tls_cands, &candidate_index_tls())) return result;
+        st.work_cap = strategy_work_cap_;
+        st.work_budget = budget;
+        result.timing_sample_every = timing_sample_every_;
+        uint32_t round = 0;
 
         // GĹ‚Ăłwna pÄ™tla dyspozytora. KaĹĽdy powrĂłt "Progress" sprawia, ĹĽe zaczynamy 
         // przeczesywaÄ‡ strategie od najszybszych i najprostszych (P1).
@@ -921,21 +1107,39 @@ public:
             if (has_budget && !budget->step()) {
                 result.timed_out = true;
                 result.solved = false;
+                finish_sampled_timing(result);
                 return result;
             }
             
-            const ApplyResult ar = apply_round_up_to_level(st, result, level_limit);
-            if (ar == ApplyResult::Contradiction) return result;
+            const bool sampled_round = timing_sample_every_ > 1 && (round % timing_sample_every_) == 0;
+            st.timing_enabled = (timing_sample_every_ == 1) || sampled_round;
+            ++round;
+            if (sampled_round) begin_timed_round(result);
+            const ApplyResult ar = apply_round_up_to_level(st, result, level_limit, tier_policy_, out_seed_masks);
+            if (sampled_round) end_timed_round(result);
+            if (ar == ApplyResult::Contradiction) {
+                finish_sampled_timing(result);
+                return result;
+            }
             if (ar == ApplyResult::Progress) continue;
+            // Slot P7/P8 przerwany budzetem proby: brak dedukcji nie jest werdyktem.
+            if (has_budget && budget->aborted()) {
+                result.timed_out = true;
+                finish_sampled_timing(result);
+                return result;
+            }
             
             // Ĺ»adna ze strategii na dozwolonym poziomie nie odnalazĹ‚a dedukcji (WÄ…skie gardĹ‚o nierozwiÄ…zane)
             break;
         }
 
+        finish_sampled_timing(result);
         result.solved = (board.empty_cells == 0);
         if (capture_solution_grid) {
             result.solved_grid = board.values;
         }
+        // Certyfikacja nie wyszla poza P1/P2 - stan koncowy jest w pelni poprawnym zasiewem.
+        if (out_seed_masks != nullptr && out_seed_masks->empty()) capture_candidate_masks(st, *out_seed_masks);
         
         // Zapis flag dla testĂłw mikro-profilujÄ…cych
         result.naked_single_scanned = result.strategy_stats[SlotNakedSingle].use_count > 0;
@@ -949,13 +1153,15 @@ public:
         const GenericTopology& topo,
         int max_level,
         core_engines::SearchAbortControl* budget = nullptr,
-        bool capture_solution_grid = false) const {
+        bool capture_solution_grid = false,
+        std::vector<uint64_t>* out_seed_masks = nullptr) const {
         return certify_up_to_level(
             std::span<const uint16_t>(puzzle.data(), puzzle.size()),
             topo,
             max_level,
             budget,
-            capture_solution_grid);
+            capture_solution_grid,
+            out_seed_masks);
     }
 };
 
@@ -7,13 +7,15 @@
 #include <chrono>
 #include <cstdint>
 #include <iomanip>
+#include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
+#include "generator/concurrency/seqlock.h"
 #include "utils/logging.h"
 
 namespace sudoku_hpc {
@@ -31,9 +33,29 @@ struct MonitorTotalsSnapshot {
     uint64_t reseeds = 0;
 };
 
+enum class WorkerStatus : uint8_t {
+    Idle,
+    Running,
+    Paused,
+    Done
+};
+
+inline const char* to_string(WorkerStatus s) {
+    switch (s) {
+        case WorkerStatus::Idle: return "idle";
+        case WorkerStatus::Running: return "running";
+        case WorkerStatus::Paused: return "paused";
+        case WorkerStatus::Done: return "done";
+    }
+    return "idle";
+}
+
+// Rekord POD publikowany przez worker do własnego slotu seqlock (bez stringów:
+// etykiety etapów/zadań i nazwy strategii to id z ConsoleStatsMonitor::intern_label).
 struct WorkerRow {
-    std::string worker = "worker_00";
     int clues = 0;
+    WorkerStatus status = WorkerStatus::Idle;
+    uint16_t label_id = 0;
     uint64_t seed = 0;
     uint64_t last_reseed_steady_ns = 0;
     uint64_t resets = 0;
@@ -41,7 +63,6 @@ struct WorkerRow {
     double reset_lag = 0.0;
     double lag_max = 0.0;
     double reset_in_s = 0.0;
-    std::string status = "idle";
     uint64_t dead_ends = 0;
     uint64_t max_depth = 0;
     double avg_node_ms = 0.0;
@@ -65,7 +86,7 @@ struct WorkerRow {
 };
 
 struct StrategyRow {
-    std::string strategy = "None";
+    uint16_t strategy_id = 0;
     int lvl = 0;
     uint64_t max_attempts = 0;
     uint64_t analyzed = 0;
@@ -78,53 +99,100 @@ struct StrategyRow {
 
 class ConsoleStatsMonitor {
 public:
-    ConsoleStatsMonitor() {
+    // Sloty workerów alokowane raz: pisarze nigdy nie trafiają na realokację.
+    static constexpr size_t kMaxWorkerSlots = 1024;
+
+    ConsoleStatsMonitor()
+        : worker_slots_(std::make_unique<concurrency::SeqlockSlot<WorkerRow>[]>(kMaxWorkerSlots)) {
         start_tp_ = std::chrono::steady_clock::now();
+        labels_.emplace_back();
     }
 
     ~ConsoleStatsMonitor() {
         stop_ui_thread();
     }
 
-    void set_target(uint64_t target) {
-        std::unique_lock<std::shared_mutex> lock(totals_mu_);
-        totals_.target = target;
-    }
+    void set_target(uint64_t target) { target_.store(target, std::memory_order_relaxed); }
 
     void set_active_workers(int n) {
-        {
-            std::unique_lock<std::shared_mutex> lock(totals_mu_);
-            totals_.active_workers = static_cast<uint64_t>(std::max(0, n));
-        }
-        std::lock_guard<std::mutex> lock(workers_mu_);
-        if (static_cast<int>(workers_.size()) < n) {
-            workers_.resize(static_cast<size_t>(n));
-        }
+        active_workers_.store(static_cast<uint64_t>(std::max(0, n)), std::memory_order_relaxed);
     }
 
-    void set_attempts(uint64_t v) { std::unique_lock<std::shared_mutex> lock(totals_mu_); totals_.attempts = v; }
+    // Liczniki globalne: pojedyncze zapisy relaxed, bez blokad po stronie workerów.
+    void set_attempts(uint64_t v) { attempts_.store(v, std::memory_order_relaxed); }
     void set_attempts_total(uint64_t v) { set_attempts(v); }
-    void set_analyzed_required_strategy(uint64_t v) { std::unique_lock<std::shared_mutex> lock(totals_mu_); totals_.analyzed_required_strategy = v; }
-    void set_required_strategy_hits(uint64_t v) { std::unique_lock<std::shared_mutex> lock(totals_mu_); totals_.required_strategy_hits = v; }
-    void set_written_required_strategy(uint64_t v) { std::unique_lock<std::shared_mutex> lock(totals_mu_); totals_.written_required_strategy = v; }
-    void set_accepted(uint64_t v) { std::unique_lock<std::shared_mutex> lock(totals_mu_); totals_.accepted = v; }
-    void set_written(uint64_t v) { std::unique_lock<std::shared_mutex> lock(totals_mu_); totals_.written = v; }
-    void set_rejected(uint64_t v) { std::unique_lock<std::shared_mutex> lock(totals_mu_); totals_.rejected = v; }
-    void set_totals_snapshot(const MonitorTotalsSnapshot& snapshot) { std::unique_lock<std::shared_mutex> lock(totals_mu_); totals_ = snapshot; }
-    void add_reseed(uint64_t inc = 1) { std::unique_lock<std::shared_mutex> lock(totals_mu_); totals_.reseeds += inc; }
+    void set_analyzed_required_strategy(uint64_t v) { analyzed_required_strategy_.store(v, std::memory_order_relaxed); }
+    void set_required_strategy_hits(uint64_t v) { required_strategy_hits_.store(v, std::memory_order_relaxed); }
+    void set_written_required_strategy(uint64_t v) { written_required_strategy_.store(v, std::memory_order_relaxed); }
+    void set_accepted(uint64_t v) { accepted_.store(v, std::memory_order_relaxed); }
+    void set_written(uint64_t v) { written_.store(v, std::memory_order_relaxed); }
+    void set_rejected(uint64_t v) { rejected_.store(v, std::memory_order_relaxed); }
+    void set_totals_snapshot(const MonitorTotalsSnapshot& snapshot) {
+        target_.store(snapshot.target, std::memory_order_relaxed);
+        accepted_.store(snapshot.accepted, std::memory_order_relaxed);
+        written_.store(snapshot.written, std::memory_order_relaxed);
+        attempts_.store(snapshot.attempts, std::memory_order_relaxed);
+        analyzed_required_strategy_.store(snapshot.analyzed_required_strategy, std::memory_order_relaxed);
+        required_strategy_hits_.store(snapshot.required_strategy_hits, std::memory_order_relaxed);
+        written_required_strategy_.store(snapshot.written_required_strategy, std::memory_order_relaxed);
+        rejected_.store(snapshot.rejected, std::memory_order_relaxed);
+        active_workers_.store(snapshot.active_workers, std::memory_order_relaxed);
+        reseeds_.store(snapshot.reseeds, std::memory_order_relaxed);
+    }
+    void add_reseed(uint64_t inc = 1) { reseeds_.fetch_add(inc, std::memory_order_relaxed); }
+
+    MonitorTotalsSnapshot totals() const {
+        MonitorTotalsSnapshot t{};
+        t.target = target_.load(std::memory_order_relaxed);
+        t.accepted = accepted_.load(std::memory_order_relaxed);
+        t.written = written_.load(std::memory_order_relaxed);
+        t.attempts = attempts_.load(std::memory_order_relaxed);
+        t.analyzed_required_strategy = analyzed_required_strategy_.load(std::memory_order_relaxed);
+        t.required_strategy_hits = required_strategy_hits_.load(std::memory_order_relaxed);
+        t.written_required_strategy = written_required_strategy_.load(std::memory_order_relaxed);
+        t.rejected = rejected_.load(std::memory_order_relaxed);
+        t.active_workers = active_workers_.load(std::memory_order_relaxed);
+        t.reseeds = reseeds_.load(std::memory_order_relaxed);
+        return t;
+    }
 
+    // Etykieta (nazwa zadania, etap, strategia) -> małe id; wywoływane poza pętlą prób.
+    // Id 0 = brak etykiety.
+    uint16_t intern_label(std::string_view label) {
+        std::lock_guard<std::mutex> lock(labels_mu_);
+        for (size_t i = 1; i < labels_.size(); ++i) {
+            if (labels_[i] == label) return static_cast<uint16_t>(i);
+        }
+        if (labels_.size() > UINT16_MAX) return 0;
+        labels_.emplace_back(label);
+        return static_cast<uint16_t>(labels_.size() - 1);
+    }
+
+    std::string label(uint16_t id) const {
+        std::lock_guard<std::mutex> lock(labels_mu_);
+        return (id < labels_.size()) ? labels_[id] : std::string();
+    }
+
+    // Jeden pisarz na slot (worker worker_idx); nie blokuje i nie alokuje.
     void set_worker_row(size_t worker_idx, const WorkerRow& row) {
-        std::lock_guard<std::mutex> lock(workers_mu_);
-        if (worker_idx >= workers_.size()) {
-            workers_.resize(worker_idx + 1);
+        if (worker_idx >= kMaxWorkerSlots) return;
+        worker_slots_[worker_idx].store(row);
+        size_t used = worker_slots_used_.load(std::memory_order_relaxed);
+        while (worker_idx >= used &&
+               !worker_slots_used_.compare_exchange_weak(used, worker_idx + 1, std::memory_order_relaxed)) {
         }
-        workers_[worker_idx] = row;
+    }
+
+    // Spójna kopia wiersza workera; false = worker jeszcze nic nie opublikował.
+    bool worker_row(size_t worker_idx, WorkerRow& out) const {
+        if (worker_idx >= kMaxWorkerSlots) return false;
+        return worker_slots_[worker_idx].load(out);
     }
 
     void update_strategy_row(const StrategyRow& row) {
         std::lock_guard<std::mutex> lock(strategies_mu_);
         for (auto& item : strategies_) {
-            if (item.strategy == row.strategy && item.lvl == row.lvl) {
+            if (item.strategy_id == row.strategy_id && item.lvl == row.lvl) {
                 item = row;
                 return;
             }
@@ -176,11 +244,7 @@ public:
 
     std::string snapshot_text() const {
         std::ostringstream out;
-        MonitorTotalsSnapshot t{};
-        {
-            std::shared_lock<std::shared_mutex> lock(totals_mu_);
-            t = totals_;
-        }
+        const MonitorTotalsSnapshot t = totals();
 
         const auto elapsed_s = std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::steady_clock::now() - start_tp_).count();
@@ -197,22 +261,22 @@ public:
             << " elapsed_s=" << elapsed_s
             << "\n";
 
-        {
-            std::lock_guard<std::mutex> lock(workers_mu_);
-            for (const auto& w : workers_) {
-                if (w.worker.empty()) continue;
-                out << "[" << w.worker << "] status=" << w.status
-                    << " clues=" << w.clues
-                    << " applied=" << w.applied
-                    << " reqA/U/H=" << w.required_strategy_analyzed
-                    << "/" << w.required_strategy_use
-                    << "/" << w.required_strategy_hit
-                    << " solved_ms=" << std::fixed << std::setprecision(3) << w.stage_solved_ms
-                    << " dig_ms=" << std::fixed << std::setprecision(3) << w.stage_dig_ms
-                    << " logic_ms=" << std::fixed << std::setprecision(3) << w.stage_logic_ms
-                    << " uniq_ms=" << std::fixed << std::setprecision(3) << w.stage_uniqueness_ms
-                    << "\n";
-            }
+        const size_t used = worker_slots_used_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < used; ++i) {
+            WorkerRow w{};
+            if (!worker_row(i, w)) continue;
+            out << "[worker_" << i << "] status=" << to_string(w.status);
+            if (w.label_id != 0) out << " (" << label(w.label_id) << ")";
+            out << " clues=" << w.clues
+                << " applied=" << w.applied
+                << " reqA/U/H=" << w.required_strategy_analyzed
+                << "/" << w.required_strategy_use
+                << "/" << w.required_strategy_hit
+                << " solved_ms=" << std::fixed << std::setprecision(3) << w.stage_solved_ms
+                << " dig_ms=" << std::fixed << std::setprecision(3) << w.stage_dig_ms
+                << " logic_ms=" << std::fixed << std::setprecision(3) << w.stage_logic_ms
+                << " uniq_ms=" << std::fixed << std::setprecision(3) << w.stage_uniqueness_ms
+                << "\n";
         }
 
         {
@@ -226,13 +290,25 @@ public:
     }
 
 private:
-    alignas(64) MonitorTotalsSnapshot totals_{};
-    mutable std::shared_mutex totals_mu_;
+    // Każdy licznik we własnej linii cache - pisarze różnych liczników się nie kłócą.
+    alignas(64) std::atomic<uint64_t> target_{0};
+    alignas(64) std::atomic<uint64_t> accepted_{0};
+    alignas(64) std::atomic<uint64_t> written_{0};
+    alignas(64) std::atomic<uint64_t> attempts_{0};
+    alignas(64) std::atomic<uint64_t> analyzed_required_strategy_{0};
+    alignas(64) std::atomic<uint64_t> required_strategy_hits_{0};
+    alignas(64) std::atomic<uint64_t> written_required_strategy_{0};
+    alignas(64) std::atomic<uint64_t> rejected_{0};
+    alignas(64) std::atomic<uint64_t> active_workers_{0};
+    alignas(64) std::atomic<uint64_t> reseeds_{0};
 
     std::chrono::steady_clock::time_point start_tp_;
 
-    mutable std::mutex workers_mu_;
-    std::vector<WorkerRow> workers_;
+    std::unique_ptr<concurrency::SeqlockSlot<WorkerRow>[]> worker_slots_;
+    alignas(64) std::atomic<size_t> worker_slots_used_{0};
+
+    mutable std::mutex labels_mu_;
+    std::vector<std::string> labels_;
 
     mutable std::mutex strategies_mu_;
     std::vector<StrategyRow> strategies_;
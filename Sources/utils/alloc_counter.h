@@ -0,0 +1,48 @@
+﻿//Author copyright Marcin Matysek (Rewertyn)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Debugowe liczenie alokacji sterty per wątek. Włączane flagą kompilacji
+// -DSUDOKU_COUNT_ALLOCATIONS; bez niej licznik zawsze zwraca 0 i nic nie jest
+// podmieniane. Program to jedna jednostka translacji, więc zastępcze operatory
+// new/delete mogą żyć w nagłówku.
+
+namespace sudoku_hpc::debug_alloc {
+
+#if defined(SUDOKU_COUNT_ALLOCATIONS)
+inline constexpr bool kEnabled = true;
+#else
+inline constexpr bool kEnabled = false;
+#endif
+
+inline thread_local uint64_t tls_allocations = 0;
+
+inline uint64_t thread_allocations() {
+    return tls_allocations;
+}
+
+} // namespace sudoku_hpc::debug_alloc
+
+#if defined(SUDOKU_COUNT_ALLOCATIONS)
+void* operator new(std::size_t size) {
+    ++sudoku_hpc::debug_alloc::tls_allocations;
+    if (void* p = std::malloc(size != 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    ++sudoku_hpc::debug_alloc::tls_allocations;
+    if (void* p = std::malloc(size != 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#endif
@@ -29,6 +29,8 @@
 #include "Sources/cli/arg_parser.h"
 #include "Sources/monitor.h"
 #include "Sources/generator/runtime_runner.h"
+#include "Sources/generator/job_scheduler.h"
+#include "Sources/generator/shard_merge.h"
 #include "Sources/maintenance/quality_benchmark.h"
 #include "Sources/gui.h"
 
@@ -209,6 +211,14 @@ inline void write_result_summary(std::ostream& out, const GenerateRunResult& res
     out << "Naked hit/use: " << result.strategy_naked_hit << "/" << result.strategy_naked_use << "\n";
     out << "Hidden hit/use: " << result.strategy_hidden_hit << "/" << result.strategy_hidden_use << "\n";
     out << "MCTS advanced evals: " << result.mcts_advanced_evals << "\n";
+    out << "Early abort aborted/checkpoints: " << result.early_abort_aborted << "/" << result.early_abort_checkpoints << "\n";
+    out << "Early abort audit false negatives: " << result.early_abort_audit_false_negatives << "/" << result.early_abort_audits << "\n";
+    if (cfg.inflight_attempts > 1) {
+        out << "Interleave dropped/unfinished: " << result.interleave_dropped << "/" << result.interleave_unfinished << "\n";
+    }
+    if (cfg.pipeline_depth > 0) {
+        out << "Pipeline unfinished: " << result.pipeline_unfinished << "\n";
+    }
     if (cfg.required_strategy != RequiredStrategy::None) {
         out << "Certifier required analyzed/use/hit: "
             << result.certifier_required_strategy_analyzed << "/"
@@ -385,7 +395,10 @@ inline void print_production_help(std::ostream& out) {
     out << "  --difficulty <1..9>             Difficulty level\n";
     out << "  --required-strategy <name>      Required strategy (normalized token)\n";
     out << "  --target <uint64>               Target puzzles to generate\n";
-    out << "  --threads <int>                 Worker threads (0=auto)\n";
+    out << "  --threads <int>                 Worker threads (0=auto: CPUs allowed for the process)\n";
+    out << "  --cpu-affinity <none|compact|scatter> Pin workers: fill NUMA nodes in turn / alternate nodes\n";
+    out << "  --inflight-attempts <int>       Dug candidates held per worker, best certified first (1=off)\n";
+    out << "  --pipeline-depth <int>          Pipeline mode: dig/certify worker groups, queue depth (0=off)\n";
     out << "  --seed <uint64>                 RNG seed (0=random)\n";
     out << "  --output-folder <path>          Output directory\n";
     out << "  --output-file <name>            Output batch file name\n";
@@ -396,7 +409,24 @@ inline void print_production_help(std::ostream& out) {
     out << "  --strict-canonical-strategies   Require canonical (non-proxy) required strategy hits\n";
     out << "  --no-proxy-advanced             Reject proxy-only advanced strategy confirmation\n";
     out << "  --allow-proxy-advanced          Allow proxy/hybrid advanced strategy confirmation\n";
+    out << "  --strategy-tier-policy <spec>   P8 tiers: hybrid|exact|proxy[,slot=mode...]\n";
+    out << "  --strategy-work-cap <uint64>    Work units per P7/P8 slot call (0=unlimited)\n";
+    out << "  --strategy-timing-sample <N>    Time 1 in N certify rounds (1=all, 0=off)\n";
+    out << "  --uniqueness-parallel-threads <N> Threads per uniqueness count, n>=49 (0=auto: idle workers' cores, 1=off)\n";
+    out << "  --uniqueness-audit-every <N>    Recount/replay 1 in N dig-proven candidates (0=off)\n";
+    out << "  --transform-grid-min-n <N>      Solved grids by transforms for n>=N, unpatterned (0=off)\n";
+    out << "  --early-abort-ratio <x>         Abort digs predicted below x * base accept rate (0=off, default)\n";
+    out << "  --early-abort-audit-every <N>   Let 1 in N abort decisions run on as an audit (0=off)\n";
+    out << "  --adaptive-budget               Tune node/time budgets, PF tries, MCTS iterations from CPU time (not reproducible)\n";
+    out << "  --budget-profile-file <name>    Load/save learned budget profiles in output folder (with --adaptive-budget)\n";
+    out << "  --checkpoint-interval-s <N>     Write <output-file>.ckpt every N seconds (0=off, default)\n";
+    out << "  --resume                        Continue the run from <output-file>.ckpt\n";
+    out << "  --shard-index <i> --shard-count <K> Run shard i of K: target/K, disjoint seeds, own files\n";
+    out << "  --merge-shards <K>              Merge K shard outputs + stats into --output-file\n";
+    out << "  --merge-dedup <exact|relabel>   Merge dedup key: exact grid or digit-relabel canonical\n";
     out << "  --max-pattern-depth <0..8>      Cap advanced pattern depth (0=auto)\n";
+    out << "  --jobs <manifest>               Job queue: one CLI line per target, shared worker pool\n";
+    out << "                                  (--job-name <id>, --job-priority <N> weight CPU share)\n";
     out << "  --fast-test                     Fast smoke mode (relaxed contracts, short budgets)\n";
     out << "  --max-total-time-s <uint64>     Global runtime timeout (0=none)\n";
     out << "  --run-quality-benchmark <file>  Write strategy audit report (.txt + .csv)\n";
@@ -471,6 +501,25 @@ int main(int argc, char** argv) {
             return 0;
         }
 
+        if (parse_result.merge_shards > 0) {
+            ShardMergeReport report;
+            std::string merge_err;
+            if (!merge_seed_shards(cfg, parse_result.merge_shards, parse_result.merge_dedup_relabel, report, &merge_err)) {
+                std::cerr << "Shard merge failed: " << merge_err << "\n";
+                return 1;
+            }
+            std::cout << "Shards merged: " << report.shards_found << "/" << parse_result.merge_shards << "\n";
+            std::cout << "Shard lines read: " << report.lines_read << "\n";
+            std::cout << "Duplicates dropped (" << (parse_result.merge_dedup_relabel ? "relabel" : "exact") << "): "
+                      << report.duplicates << "\n";
+            std::cout << "Malformed lines: " << report.malformed << "\n";
+            write_result_summary(std::cout, report.result, cfg);
+            return (report.shards_missing == 0) ? 0 : 1;
+        }
+
+        // Shard runu wieloprocesowego: część celu, własny seed i pliki (shard_merge.h).
+        apply_seed_shard(cfg);
+
         if (parse_result.run_quality_benchmark) {
             std::string csv_path;
             const bool ok = maintenance::write_quality_benchmark_report(
@@ -515,8 +564,45 @@ int main(int argc, char** argv) {
         ConsoleStatsMonitor monitor;
         monitor.start_ui_thread(5000);
 
-        log_info("main", "run_generic_sudoku begin");
         std::mutex console_mu;
+        if (!parse_result.jobs_manifest.empty()) {
+            std::vector<JobSpec> jobs;
+            std::string jobs_err;
+            if (!parse_job_manifest(parse_result.jobs_manifest, argc, argv, jobs, &jobs_err)) {
+                monitor.stop_ui_thread();
+                std::cerr << "Job queue error: " << jobs_err << "\n";
+                return 1;
+            }
+            log_info("main", "run_job_queue begin jobs=" + std::to_string(jobs.size()));
+            const auto job_results = run_job_queue(
+                jobs,
+                cfg.threads,
+                concurrency::affinity_policy_from_string(cfg.cpu_affinity),
+                &monitor,
+                &cancel_flag,
+                &pause_flag,
+                nullptr,
+                [&](const std::string& msg) {
+                    std::lock_guard<std::mutex> lock(console_mu);
+                    std::cout << msg << "\n";
+                    std::cout.flush();
+                });
+            log_info("main", "run_job_queue end");
+            monitor.stop_ui_thread();
+            bool all_valid = true;
+            for (const auto& jr : job_results) {
+                std::cout << "\n=== Job " << jr.name << " (priority " << jr.priority << ", "
+                          << jr.cfg.box_rows << "x" << jr.cfg.box_cols
+                          << " L" << jr.cfg.difficulty_level_required
+                          << ", output " << jr.cfg.output_file << ") ===";
+                write_result_summary(std::cout, jr.result, jr.cfg);
+                all_valid = all_valid && jr.valid;
+            }
+            log_info("main", "program end ok");
+            return all_valid ? 0 : 1;
+        }
+
+        log_info("main", "run_generic_sudoku begin");
         auto result = run_generic_sudoku(
             cfg,
             &monitor,
@@ -549,6 +635,10 @@ int main(int argc, char** argv) {
         }
 #endif
 
+        if (cfg.shard_count > 1 && !save_run_stats(run_stats_path(cfg), result)) {
+            std::cerr << "Failed to write shard stats: " << run_stats_path(cfg).string() << "\n";
+        }
+
         log_info("main", "handle_result begin");
         handle_result(result, cfg, parse_result.benchmark_mode, join_command_line(argc, argv), debug_logger().path());
         log_info("main", "handle_result end");